@@ -261,6 +261,9 @@ inline void Kinect::updateBodyIndex()
 
     // Retrieve BodyIndex Data
     ERROR_CHECK( bodyIndexFrame->CopyFrameDataToArray( static_cast<UINT>( bodyIndexBuffer.size() ), &bodyIndexBuffer[0] ) );
+
+    // Encode BodyIndex Mask ( Run-Length )
+    bodyIndexMask.encode( &bodyIndexBuffer[0], bodyIndexWidth, bodyIndexHeight );
 }
 
 
@@ -280,14 +283,17 @@ inline void Kinect::drawBodyIndex()
         return;
     }
 
-    // Visualization BodyIndex
+    // Extract Mask of Speaking Body
+    const BodyIndexMask speakerMask = bodyIndexMask.extract( static_cast<uint8_t>( audioTrackingIndex ) );
+
+    // Visualization BodyIndex ( only pixels of speaking body are visited )
     bodyIndexMat = cv::Mat::zeros( bodyIndexHeight, bodyIndexWidth, CV_8UC3 );
-    bodyIndexMat.forEach<cv::Vec3b>( [ & ]( cv::Vec3b &p, const int* position ){
-        uchar index = bodyIndexBuffer[position[0] * bodyIndexWidth + position[1]];
-        if( index == audioTrackingIndex ){
-            p = colors[index];
+    for( int y = 0; y < speakerMask.getHeight(); y++ ){
+        cv::Vec3b* row = bodyIndexMat.ptr<cv::Vec3b>( y );
+        for( const BodyIndexMask::Run* run = speakerMask.rowBegin( y ); run != speakerMask.rowEnd( y ); run++ ){
+            std::fill( row + run->x, row + run->x + run->length, colors[run->index] );
         }
-    } );
+    }
 }
 
 // Show Data
@@ -4,6 +4,7 @@
 #include <Windows.h>
 #include <Kinect.h>
 #include <opencv2/opencv.hpp>
+#include "BodyIndexMask.h"
 
 #include <vector>
 #include <array>
@@ -29,6 +30,7 @@ private:
     std::vector<BYTE> bodyIndexBuffer;
     int bodyIndexWidth;
     int bodyIndexHeight;
+    BodyIndexMask bodyIndexMask;
     cv::Mat bodyIndexMat;
     std::array<cv::Vec3b, BODY_COUNT> colors;
 
@@ -0,0 +1,101 @@
+#ifndef __SKELETON_PROJECTION__
+#define __SKELETON_PROJECTION__
+
+#include <array>
+#include <string>
+
+// Skeleton Projection
+// Joints of all tracked bodies are gathered into one contiguous array, and projected to color space in one batch.
+// Live, the gathered array is passed to ICoordinateMapper::MapCameraPointsToColorSpace().
+// Offline ( e.g. replay on Linux ), it is projected with a pinhole and radial distortion model fitted from the coordinate mapper.
+class SkeletonProjection
+{
+public:
+    // Number of Bodies and Joints ( same as BODY_COUNT and JointType_Count )
+    static const int BODIES = 6;
+    static const int JOINTS = 25;
+
+    // Camera Space Point ( same layout as CameraSpacePoint )
+    struct CameraPoint
+    {
+        float X;
+        float Y;
+        float Z;
+    };
+
+    // Color Space Point ( same layout as ColorSpacePoint )
+    struct ColorPoint
+    {
+        float X;
+        float Y;
+    };
+
+    // Color Camera Model
+    // x = ( X + tx ) / Z, y = ( Y + ty ) / Z, d = 1 + k1 * r^2 + k2 * r^4, u = cx + fx * x * d, v = cy + fy * y * d
+    struct Calibration
+    {
+        float fx, fy;
+        float cx, cy;
+        float tx, ty;
+        float k1, k2;
+
+        // Fit Model from Corresponding Points ( return false if points are not enough )
+        bool fit( const CameraPoint* cameraPoints, const ColorPoint* colorPoints, const int count );
+
+        // Save/Load Model to/from Text File
+        bool save( const std::string& path ) const;
+        bool load( const std::string& path );
+    };
+
+private:
+    // Gathered Joints of Tracked Bodies
+    std::array<CameraPoint, BODIES * JOINTS> cameraPoints;
+    std::array<ColorPoint, BODIES * JOINTS> colorPoints;
+    int count;
+
+    // Offset of Each Body in Gathered Joints ( -1 if not tracked )
+    std::array<int, BODIES> offsets;
+
+public:
+    // Constructor
+    SkeletonProjection();
+
+    // Clear Gathered Joints
+    void clear();
+
+    // Gather Joints of Body
+    void gather( const int body, const CameraPoint* joints );
+
+    // Project Gathered Joints with Color Camera Model
+    void project( const Calibration& calibration );
+
+    // Retrieve Gathered Joints ( to project with coordinate mapper )
+    const CameraPoint* getCameraPoints() const
+    {
+        return cameraPoints.data();
+    }
+
+    ColorPoint* getColorPoints()
+    {
+        return colorPoints.data();
+    }
+
+    int getCount() const
+    {
+        return count;
+    }
+
+    // Check Body Gathered
+    bool isGathered( const int body ) const
+    {
+        return offsets[body] != -1;
+    }
+
+    // Retrieve Projected Joint
+    const ColorPoint& getColorPoint( const int body, const int joint ) const
+    {
+        return colorPoints[offsets[body] + joint];
+    }
+};
+
+#endif // __SKELETON_PROJECTION__
\ No newline at end of file
@@ -0,0 +1,395 @@
+#include "SkeletonStream.h"
+
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+// File Header ( magic, version, number of bodies and joints )
+static const char MAGIC[4] = { 'S', 'K', 'L', 'S' };
+static const uint8_t VERSION = 1;
+
+// Interval of Key Frame ( frames )
+static const int KEY_FRAME_INTERVAL = 300;
+
+// Scale of Fixed Point
+static const float POSITION_SCALE = 10000.0f;
+static const float ORIENTATION_SCALE = 16384.0f;
+static const float LEAN_SCALE = 1000.0f;
+
+// Frame Flags
+static const uint8_t FLAG_KEY_FRAME = 0x01;
+
+// Quantize to Fixed Point
+static inline int32_t quantize( const float value, const float scale )
+{
+    return static_cast<int32_t>( std::lround( value * scale ) );
+}
+
+// Write Variable Length Integer ( 7 bits per byte, little endian )
+static inline void writeVarint( std::vector<uint8_t>& buffer, uint64_t value )
+{
+    while( value >= 0x80 ){
+        buffer.push_back( static_cast<uint8_t>( value | 0x80 ) );
+        value >>= 7;
+    }
+    buffer.push_back( static_cast<uint8_t>( value ) );
+}
+
+// Write Signed Variable Length Integer ( zigzag coding, small magnitude is short )
+static inline void writeSigned( std::vector<uint8_t>& buffer, const int64_t value )
+{
+    writeVarint( buffer, ( static_cast<uint64_t>( value ) << 1 ) ^ static_cast<uint64_t>( value >> 63 ) );
+}
+
+// Read Variable Length Integer ( return false if buffer is overrun )
+static inline bool readVarint( const uint8_t*& data, const uint8_t* end, uint64_t& value )
+{
+    value = 0;
+    for( int shift = 0; shift < 64; shift += 7 ){
+        if( data == end ){
+            return false;
+        }
+        const uint8_t byte = *data++;
+        value |= static_cast<uint64_t>( byte & 0x7f ) << shift;
+        if( !( byte & 0x80 ) ){
+            return true;
+        }
+    }
+    return false;
+}
+
+// Read Signed Variable Length Integer
+static inline bool readSigned( const uint8_t*& data, const uint8_t* end, int64_t& value )
+{
+    uint64_t zigzag;
+    if( !readVarint( data, end, zigzag ) ){
+        return false;
+    }
+    value = static_cast<int64_t>( zigzag >> 1 ) ^ -static_cast<int64_t>( zigzag & 1 );
+    return true;
+}
+
+// Reset State
+void SkeletonStreamState::reset()
+{
+    std::memset( this, 0, sizeof( SkeletonStreamState ) );
+}
+
+// Constructor
+SkeletonRecorder::SkeletonRecorder()
+    : bytes( 0 )
+{
+    state.reset();
+}
+
+// Destructor
+SkeletonRecorder::~SkeletonRecorder()
+{
+    // Close File
+    close();
+}
+
+// Open File
+bool SkeletonRecorder::open( const std::string& path )
+{
+    close();
+
+    file.open( path, std::ios::binary | std::ios::trunc );
+    if( !file.is_open() ){
+        return false;
+    }
+
+    // Write Header
+    const uint8_t header[4] = { VERSION, SkeletonFrame::BODIES, SkeletonFrame::JOINTS, 0 };
+    file.write( MAGIC, sizeof( MAGIC ) );
+    file.write( reinterpret_cast<const char*>( header ), sizeof( header ) );
+
+    state.reset();
+    bytes = sizeof( MAGIC ) + sizeof( header );
+
+    return file.good();
+}
+
+// Close File
+void SkeletonRecorder::close()
+{
+    if( file.is_open() ){
+        file.close();
+    }
+}
+
+// Write Frame
+bool SkeletonRecorder::write( const SkeletonFrame& frame )
+{
+    if( !file.is_open() ){
+        return false;
+    }
+
+    const bool key = ( state.frames % KEY_FRAME_INTERVAL ) == 0;
+
+    // Masks of Tracked Bodies and Bodies Delta Coded from Previous Frame
+    uint8_t trackedMask = 0, continuedMask = 0;
+    for( int index = 0; index < SkeletonFrame::BODIES; index++ ){
+        const SkeletonFrame::Body& body = frame.bodies[index];
+        const SkeletonStreamState::Body& previous = state.bodies[index];
+        if( !body.tracked ){
+            continue;
+        }
+        trackedMask |= 1 << index;
+        if( !key && previous.tracked && previous.trackingId == body.trackingId ){
+            continuedMask |= 1 << index;
+        }
+    }
+
+    // Frame Header
+    buffer.clear();
+    buffer.push_back( key ? FLAG_KEY_FRAME : 0 );
+    writeSigned( buffer, key ? frame.timestamp : frame.timestamp - state.timestamp );
+    buffer.push_back( trackedMask );
+    buffer.push_back( continuedMask );
+    state.timestamp = frame.timestamp;
+
+    for( int index = 0; index < SkeletonFrame::BODIES; index++ ){
+        const SkeletonFrame::Body& body = frame.bodies[index];
+        SkeletonStreamState::Body& previous = state.bodies[index];
+        if( !( trackedMask & ( 1 << index ) ) ){
+            previous.tracked = 0;
+            continue;
+        }
+
+        // New Body is Coded from Zero
+        if( !( continuedMask & ( 1 << index ) ) ){
+            std::memset( &previous, 0, sizeof( SkeletonStreamState::Body ) );
+            writeVarint( buffer, body.trackingId );
+        }
+        previous.tracked = 1;
+        previous.trackingId = body.trackingId;
+
+        // Tracking States ( 2 bits per joint )
+        uint64_t states = 0;
+        for( int joint = 0; joint < SkeletonFrame::JOINTS; joint++ ){
+            states |= static_cast<uint64_t>( body.states[joint] & 0x03 ) << ( joint * 2 );
+        }
+        for( int byte = 0; byte < ( SkeletonFrame::JOINTS * 2 + 7 ) / 8; byte++ ){
+            buffer.push_back( static_cast<uint8_t>( states >> ( byte * 8 ) ) );
+        }
+
+        // Hand States and Lean State
+        buffer.push_back( static_cast<uint8_t>( ( body.handLeftState & 0x07 ) | ( body.handLeftConfidence & 0x01 ) << 3 | ( body.handRightState & 0x07 ) << 4 | ( body.handRightConfidence & 0x01 ) << 7 ) );
+        buffer.push_back( body.leanState );
+
+        // Lean
+        for( int axis = 0; axis < 2; axis++ ){
+            const int32_t value = quantize( body.lean[axis], LEAN_SCALE );
+            writeSigned( buffer, value - previous.lean[axis] );
+            previous.lean[axis] = value;
+        }
+
+        // Joint Positions and Orientations
+        for( int joint = 0; joint < SkeletonFrame::JOINTS; joint++ ){
+            for( int axis = 0; axis < 3; axis++ ){
+                const int32_t value = quantize( body.positions[joint][axis], POSITION_SCALE );
+                writeSigned( buffer, value - previous.positions[joint][axis] );
+                previous.positions[joint][axis] = value;
+            }
+            for( int axis = 0; axis < 4; axis++ ){
+                const int32_t value = quantize( body.orientations[joint][axis], ORIENTATION_SCALE );
+                writeSigned( buffer, value - previous.orientations[joint][axis] );
+                previous.orientations[joint][axis] = value;
+            }
+        }
+    }
+
+    // Write Frame with Size Prefix
+    std::vector<uint8_t> size;
+    writeVarint( size, buffer.size() );
+    file.write( reinterpret_cast<const char*>( &size[0] ), size.size() );
+    file.write( reinterpret_cast<const char*>( &buffer[0] ), buffer.size() );
+
+    state.frames++;
+    bytes += size.size() + buffer.size();
+
+    return file.good();
+}
+
+// Constructor
+SkeletonReplayer::SkeletonReplayer()
+    : realtime( true ),
+      origin( 0 )
+{
+    state.reset();
+}
+
+// Open File
+bool SkeletonReplayer::open( const std::string& path )
+{
+    close();
+
+    file.open( path, std::ios::binary );
+    if( !file.is_open() ){
+        return false;
+    }
+
+    // Check Header
+    char magic[4];
+    uint8_t header[4];
+    file.read( magic, sizeof( magic ) );
+    file.read( reinterpret_cast<char*>( header ), sizeof( header ) );
+    if( !file.good() || std::memcmp( magic, MAGIC, sizeof( MAGIC ) ) != 0 || header[0] != VERSION || header[1] != SkeletonFrame::BODIES || header[2] != SkeletonFrame::JOINTS ){
+        close();
+        return false;
+    }
+
+    begin = file.tellg();
+    rewind();
+
+    return true;
+}
+
+// Close File
+void SkeletonReplayer::close()
+{
+    if( file.is_open() ){
+        file.close();
+    }
+}
+
+// Rewind to First Frame
+void SkeletonReplayer::rewind()
+{
+    if( !file.is_open() ){
+        return;
+    }
+
+    file.clear();
+    file.seekg( begin );
+    state.reset();
+}
+
+// Read Next Frame
+bool SkeletonReplayer::read( SkeletonFrame& frame )
+{
+    if( !file.is_open() ){
+        return false;
+    }
+
+    // Read Frame Size
+    uint64_t size = 0;
+    for( int shift = 0; shift < 64; shift += 7 ){
+        const int byte = file.get();
+        if( byte == std::char_traits<char>::eof() ){
+            return false;
+        }
+        size |= static_cast<uint64_t>( byte & 0x7f ) << shift;
+        if( !( byte & 0x80 ) ){
+            break;
+        }
+    }
+
+    // Read Frame
+    buffer.resize( static_cast<size_t>( size ) );
+    if( size == 0 || !file.read( reinterpret_cast<char*>( &buffer[0] ), buffer.size() ) ){
+        return false;
+    }
+    const uint8_t* data = &buffer[0];
+    const uint8_t* end = data + buffer.size();
+
+    // Frame Header
+    if( end - data < 1 ){
+        return false;
+    }
+    const bool key = ( *data++ & FLAG_KEY_FRAME ) != 0;
+    int64_t timestamp;
+    if( !readSigned( data, end, timestamp ) || end - data < 2 ){
+        return false;
+    }
+    state.timestamp = key ? timestamp : state.timestamp + timestamp;
+    frame.timestamp = state.timestamp;
+    const uint8_t trackedMask = *data++;
+    const uint8_t continuedMask = *data++;
+
+    for( int index = 0; index < SkeletonFrame::BODIES; index++ ){
+        SkeletonFrame::Body& body = frame.bodies[index];
+        SkeletonStreamState::Body& previous = state.bodies[index];
+        if( !( trackedMask & ( 1 << index ) ) ){
+            body.tracked = 0;
+            body.trackingId = 0;
+            previous.tracked = 0;
+            continue;
+        }
+
+        // New Body is Coded from Zero
+        if( !( continuedMask & ( 1 << index ) ) ){
+            std::memset( &previous, 0, sizeof( SkeletonStreamState::Body ) );
+            if( !readVarint( data, end, previous.trackingId ) ){
+                return false;
+            }
+        }
+        previous.tracked = 1;
+        body.tracked = 1;
+        body.trackingId = previous.trackingId;
+
+        // Tracking States
+        const int stateBytes = ( SkeletonFrame::JOINTS * 2 + 7 ) / 8;
+        if( end - data < stateBytes + 2 ){
+            return false;
+        }
+        uint64_t states = 0;
+        for( int byte = 0; byte < stateBytes; byte++ ){
+            states |= static_cast<uint64_t>( *data++ ) << ( byte * 8 );
+        }
+        for( int joint = 0; joint < SkeletonFrame::JOINTS; joint++ ){
+            body.states[joint] = static_cast<uint8_t>( ( states >> ( joint * 2 ) ) & 0x03 );
+        }
+
+        // Hand States and Lean State
+        const uint8_t hands = *data++;
+        body.handLeftState = hands & 0x07;
+        body.handLeftConfidence = ( hands >> 3 ) & 0x01;
+        body.handRightState = ( hands >> 4 ) & 0x07;
+        body.handRightConfidence = ( hands >> 7 ) & 0x01;
+        body.leanState = *data++;
+
+        // Lean
+        for( int axis = 0; axis < 2; axis++ ){
+            int64_t delta;
+            if( !readSigned( data, end, delta ) ){
+                return false;
+            }
+            previous.lean[axis] += static_cast<int32_t>( delta );
+            body.lean[axis] = previous.lean[axis] / LEAN_SCALE;
+        }
+
+        // Joint Positions and Orientations
+        for( int joint = 0; joint < SkeletonFrame::JOINTS; joint++ ){
+            for( int axis = 0; axis < 3; axis++ ){
+                int64_t delta;
+                if( !readSigned( data, end, delta ) ){
+                    return false;
+                }
+                previous.positions[joint][axis] += static_cast<int32_t>( delta );
+                body.positions[joint][axis] = previous.positions[joint][axis] / POSITION_SCALE;
+            }
+            for( int axis = 0; axis < 4; axis++ ){
+                int64_t delta;
+                if( !readSigned( data, end, delta ) ){
+                    return false;
+                }
+                previous.orientations[joint][axis] += static_cast<int32_t>( delta );
+                body.orientations[joint][axis] = previous.orientations[joint][axis] / ORIENTATION_SCALE;
+            }
+        }
+    }
+
+    // Pace by RelativeTime ( first frame after open or rewind is the origin )
+    if( state.frames++ == 0 ){
+        origin = frame.timestamp;
+        start = std::chrono::steady_clock::now();
+    }
+    if( realtime ){
+        const std::chrono::microseconds elapsed( ( frame.timestamp - origin ) / 10 );
+        std::this_thread::sleep_until( start + elapsed );
+    }
+
+    return true;
+}
\ No newline at end of file
@@ -3,12 +3,23 @@
 
 #include <thread>
 #include <chrono>
+#include <iostream>
+#include <cstring>
+#include <algorithm>
 
 #include <omp.h>
 
 // Constructor
-Kinect::Kinect()
+Kinect::Kinect( const std::string& replay, const bool realtime )
 {
+    // Open Replay
+    if( !replay.empty() ){
+        if( !replayer.open( replay ) ){
+            throw std::runtime_error( "failed SkeletonReplayer::open( " + replay + " )" );
+        }
+        replayer.setRealtime( realtime );
+    }
+
     // Initialize
     initialize();
 }
@@ -39,6 +50,13 @@ void Kinect::run()
         if( key == VK_ESCAPE ){
             break;
         }
+        else if( key == 'c' && !replayer.isOpened() ){
+            std::cout << "Save Calibration of Color Camera to File" << std::endl;
+            saveCalibration();
+        }
+        else if( key == 'r' && !replayer.isOpened() ){
+            toggleRecording();
+        }
     }
 }
 
@@ -47,6 +65,28 @@ void Kinect::initialize()
 {
     cv::setUseOptimized( true );
 
+    // Color Table for Visualization
+    colors[0] = cv::Vec3b( 255,   0,   0 ); // Blue
+    colors[1] = cv::Vec3b(   0, 255,   0 ); // Green
+    colors[2] = cv::Vec3b(   0,   0, 255 ); // Red
+    colors[3] = cv::Vec3b( 255, 255,   0 ); // Cyan
+    colors[4] = cv::Vec3b( 255,   0, 255 ); // Magenta
+    colors[5] = cv::Vec3b(   0, 255, 255 ); // Yellow
+
+    // Initialize Skeleton Buffer
+    std::memset( &frame, 0, sizeof( SkeletonFrame ) );
+
+    // Initialize Body Buffer
+    for( auto& body : bodies ){
+        body = nullptr;
+    }
+
+    // Initialize Replay
+    if( replayer.isOpened() ){
+        initializeReplay();
+        return;
+    }
+
     // Initialize Sensor
     initializeSensor();
 
@@ -105,19 +145,22 @@ inline void Kinect::initializeBody()
     ComPtr<IBodyFrameSource> bodyFrameSource;
     ERROR_CHECK( kinect->get_BodyFrameSource( &bodyFrameSource ) );
     ERROR_CHECK( bodyFrameSource->OpenReader( &bodyFrameReader ) );
+}
 
-    // Initialize Body Buffer
-    for( auto& body : bodies ){
-        body = nullptr;
+// Initialize Replay
+// Joints are drawn on black image of color resolution, projected with calibration saved from live sensor ( 'c' key ).
+inline void Kinect::initializeReplay()
+{
+    // Load Calibration of Color Camera
+    if( !calibration.load( "ColorCalibration.txt" ) ){
+        throw std::runtime_error( "failed SkeletonProjection::Calibration::load( ColorCalibration.txt )" );
     }
 
-    // Color Table for Visualization
-    colors[0] = cv::Vec3b( 255,   0,   0 ); // Blue
-    colors[1] = cv::Vec3b(   0, 255,   0 ); // Green
-    colors[2] = cv::Vec3b(   0,   0, 255 ); // Red
-    colors[3] = cv::Vec3b( 255, 255,   0 ); // Cyan
-    colors[4] = cv::Vec3b( 255,   0, 255 ); // Magenta
-    colors[5] = cv::Vec3b(   0, 255, 255 ); // Yellow
+    // Allocation Color Buffer
+    colorWidth = 1920;
+    colorHeight = 1080;
+    colorBytesPerPixel = 4;
+    colorBuffer.resize( colorWidth * colorHeight * colorBytesPerPixel );
 }
 
 // Finalize
@@ -139,6 +182,12 @@ void Kinect::finalize()
 // Update Data
 void Kinect::update()
 {
+    // Update Replay
+    if( replayer.isOpened() ){
+        updateReplay();
+        return;
+    }
+
     // Update Color
     updateColor();
 
@@ -177,6 +226,118 @@ inline void Kinect::updateBody()
 
     // Retrieve Body Data
     ERROR_CHECK( bodyFrame->GetAndRefreshBodyData( static_cast<UINT>( bodies.size() ), &bodies[0] ) );
+
+    // Retrieve Skeleton Frame
+    retrieveFrame( bodyFrame );
+
+    // Record Skeleton Frame
+    if( recorder.isOpened() ){
+        if( !recorder.write( frame ) ){
+            throw std::runtime_error( "failed SkeletonRecorder::write()" );
+        }
+    }
+}
+
+// Update Replay
+inline void Kinect::updateReplay()
+{
+    // Clear Color Buffer
+    std::fill( colorBuffer.begin(), colorBuffer.end(), 0 );
+
+    // Read Next Skeleton Frame ( loop at the end )
+    if( !replayer.read( frame ) ){
+        replayer.rewind();
+        if( !replayer.read( frame ) ){
+            throw std::runtime_error( "failed SkeletonReplayer::read()" );
+        }
+    }
+}
+
+// Retrieve Skeleton Frame
+inline void Kinect::retrieveFrame( const ComPtr<IBodyFrame>& bodyFrame )
+{
+    // Retrieve Timestamp
+    TIMESPAN relativeTime;
+    ERROR_CHECK( bodyFrame->get_RelativeTime( &relativeTime ) );
+    frame.timestamp = relativeTime;
+
+    for( int index = 0; index < BODY_COUNT; index++ ){
+        SkeletonFrame::Body& data = frame.bodies[index];
+        data.tracked = 0;
+        data.trackingId = 0;
+
+        const ComPtr<IBody> body = bodies[index];
+        if( body == nullptr ){
+            continue;
+        }
+
+        // Check Body Tracked
+        BOOLEAN tracked = FALSE;
+        ERROR_CHECK( body->get_IsTracked( &tracked ) );
+        if( !tracked ){
+            continue;
+        }
+        data.tracked = 1;
+
+        // Retrieve Tracking ID
+        ERROR_CHECK( body->get_TrackingId( &data.trackingId ) );
+
+        // Retrieve Joints and Joint Orientations
+        std::array<Joint, JointType::JointType_Count> joints;
+        std::array<JointOrientation, JointType::JointType_Count> orientations;
+        ERROR_CHECK( body->GetJoints( static_cast<UINT>( joints.size() ), &joints[0] ) );
+        ERROR_CHECK( body->GetJointOrientations( static_cast<UINT>( orientations.size() ), &orientations[0] ) );
+        for( int type = 0; type < JointType::JointType_Count; type++ ){
+            const CameraSpacePoint& position = joints[type].Position;
+            const Vector4& orientation = orientations[type].Orientation;
+            data.positions[type][0] = position.X;
+            data.positions[type][1] = position.Y;
+            data.positions[type][2] = position.Z;
+            data.orientations[type][0] = orientation.x;
+            data.orientations[type][1] = orientation.y;
+            data.orientations[type][2] = orientation.z;
+            data.orientations[type][3] = orientation.w;
+            data.states[type] = static_cast<uint8_t>( joints[type].TrackingState );
+        }
+
+        // Retrieve Hand States
+        HandState handLeftState, handRightState;
+        TrackingConfidence handLeftConfidence, handRightConfidence;
+        ERROR_CHECK( body->get_HandLeftState( &handLeftState ) );
+        ERROR_CHECK( body->get_HandLeftConfidence( &handLeftConfidence ) );
+        ERROR_CHECK( body->get_HandRightState( &handRightState ) );
+        ERROR_CHECK( body->get_HandRightConfidence( &handRightConfidence ) );
+        data.handLeftState = static_cast<uint8_t>( handLeftState );
+        data.handLeftConfidence = static_cast<uint8_t>( handLeftConfidence );
+        data.handRightState = static_cast<uint8_t>( handRightState );
+        data.handRightConfidence = static_cast<uint8_t>( handRightConfidence );
+
+        // Retrieve Amount of Body Lean
+        PointF amount;
+        TrackingState leanState;
+        ERROR_CHECK( body->get_Lean( &amount ) );
+        ERROR_CHECK( body->get_LeanTrackingState( &leanState ) );
+        data.lean[0] = amount.X;
+        data.lean[1] = amount.Y;
+        data.leanState = static_cast<uint8_t>( leanState );
+    }
+}
+
+// Toggle Recording
+void Kinect::toggleRecording()
+{
+    // Stop Recording
+    if( recorder.isOpened() ){
+        std::cout << "Stop Recording Skeleton ( " << recorder.getFrames() << " frames, " << recorder.getBytes() << " bytes )" << std::endl;
+        recorder.close();
+        return;
+    }
+
+    // Start Recording
+    std::cout << "Start Recording Skeleton to File" << std::endl;
+    if( !recorder.open( "Skeleton.bin" ) ){
+        throw std::runtime_error( "failed SkeletonRecorder::open( Skeleton.bin )" );
+    }
 }
 
 // Draw Data
@@ -199,90 +360,120 @@ inline void Kinect::drawColor()
 // Draw Body
 inline void Kinect::drawBody()
 {
-    // Draw Body Data to Color Data
-    #pragma omp parallel for
+    // Gather Joints of Tracked Bodies
+    projection.clear();
     for( int index = 0; index < BODY_COUNT; index++ ){
-        ComPtr<IBody> body = bodies[index];
-        if( body == nullptr ){
+        const SkeletonFrame::Body& body = frame.bodies[index];
+        if( !body.tracked ){
             continue;
         }
 
-        // Check Body Tracked
-        BOOLEAN tracked = FALSE;
-        ERROR_CHECK( body->get_IsTracked( &tracked ) );
-        if( !tracked ){
+        // Gather Joint Positions
+        static_assert( sizeof( body.positions[0] ) == sizeof( SkeletonProjection::CameraPoint ), "layout of positions must be same as CameraPoint" );
+        projection.gather( index, reinterpret_cast<const SkeletonProjection::CameraPoint*>( &body.positions[0][0] ) );
+    }
+
+    // Project All Joints in One Batch
+    projectSkeleton();
+
+    // Draw Body Data to Color Data
+    for( int index = 0; index < BODY_COUNT; index++ ){
+        if( !projection.isGathered( index ) ){
             continue;
         }
 
-        // Retrieve Joints
-        std::array<Joint, JointType::JointType_Count> joints;
-        ERROR_CHECK( body->GetJoints( static_cast<UINT>( joints.size() ), &joints[0] ) );
-
-        #pragma omp parallel for
+        const SkeletonFrame::Body& body = frame.bodies[index];
         for( int type = 0; type < JointType::JointType_Count; type++ ){
             // Check Joint Tracked
-            const Joint joint = joints[type];
-            if( joint.TrackingState == TrackingState::TrackingState_NotTracked ){
+            if( body.states[type] == TrackingState::TrackingState_NotTracked ){
                 continue;
             }
 
             // Draw Joint Position
-            drawEllipse( colorMat, joint, 5, colors[index] );
+            const SkeletonProjection::ColorPoint& point = projection.getColorPoint( index, type );
+            drawEllipse( colorMat, point, 5, colors[index] );
 
             // Draw Left Hand State
-            if( joint.JointType == JointType::JointType_HandLeft ){
-                HandState handState;
-                TrackingConfidence handConfidence;
-                ERROR_CHECK( body->get_HandLeftState( &handState ) );
-                ERROR_CHECK( body->get_HandLeftConfidence( &handConfidence ) );
-
-                drawHandState( colorMat, joint, handState, handConfidence );
+            if( type == JointType::JointType_HandLeft ){
+                drawHandState( colorMat, point, static_cast<HandState>( body.handLeftState ), static_cast<TrackingConfidence>( body.handLeftConfidence ) );
             }
 
             // Draw Right Hand State
-            if( joint.JointType == JointType::JointType_HandRight ){
-                HandState handState;
-                TrackingConfidence handConfidence;
-                ERROR_CHECK( body->get_HandRightState( &handState ) );
-                ERROR_CHECK( body->get_HandRightConfidence( &handConfidence ) );
+            if( type == JointType::JointType_HandRight ){
+                drawHandState( colorMat, point, static_cast<HandState>( body.handRightState ), static_cast<TrackingConfidence>( body.handRightConfidence ) );
+            }
+        }
+    }
+}
+
+// Project Skeleton
+inline void Kinect::projectSkeleton()
+{
+    if( projection.getCount() == 0 ){
+        return;
+    }
+
+    // Project with Calibration of Color Camera ( replay without sensor )
+    if( replayer.isOpened() ){
+        projection.project( calibration );
+        return;
+    }
 
-                drawHandState( colorMat, joint, handState, handConfidence );
+    // Convert Coordinate System of All Gathered Joints
+    static_assert( sizeof( SkeletonProjection::CameraPoint ) == sizeof( CameraSpacePoint ), "layout of CameraPoint must be same as CameraSpacePoint" );
+    static_assert( sizeof( SkeletonProjection::ColorPoint ) == sizeof( ColorSpacePoint ), "layout of ColorPoint must be same as ColorSpacePoint" );
+    const UINT count = static_cast<UINT>( projection.getCount() );
+    ERROR_CHECK( coordinateMapper->MapCameraPointsToColorSpace( count, reinterpret_cast<const CameraSpacePoint*>( projection.getCameraPoints() ), count, reinterpret_cast<ColorSpacePoint*>( projection.getColorPoints() ) ) );
+}
+
+// Save Calibration of Color Camera
+// The calibration is fitted to coordinate mapper, and used to project joints without sensor ( e.g. replay on Linux ).
+void Kinect::saveCalibration()
+{
+    // Sample Points in Field of View
+    std::vector<CameraSpacePoint> cameraSpacePoints;
+    for( float z = 0.5f; z <= 4.5f; z += 0.25f ){
+        for( float y = -0.5f; y <= 0.5f; y += 0.1f ){
+            for( float x = -0.8f; x <= 0.8f; x += 0.1f ){
+                cameraSpacePoints.push_back( { x * z, y * z, z } );
             }
         }
+    }
 
-        /*
-        // Retrieve Joint Orientations
-        std::array<JointOrientation, JointType::JointType_Count> orientations;
-        ERROR_CHECK( body->GetJointOrientations( JointType::JointType_Count, &orientations[0] ) );
-        */
+    // Retrieve Mapped Coordinates
+    std::vector<ColorSpacePoint> colorSpacePoints( cameraSpacePoints.size() );
+    ERROR_CHECK( coordinateMapper->MapCameraPointsToColorSpace( static_cast<UINT>( cameraSpacePoints.size() ), &cameraSpacePoints[0], static_cast<UINT>( colorSpacePoints.size() ), &colorSpacePoints[0] ) );
 
-        /*
-        // Retrieve Amount of Body Lean
-        PointF amount;
-        ERROR_CHECK( body->get_Lean( &amount ) );
-        */
+    // Fit and Save Color Camera Model
+    SkeletonProjection::Calibration calibration;
+    if( !calibration.fit( reinterpret_cast<const SkeletonProjection::CameraPoint*>( &cameraSpacePoints[0] ), reinterpret_cast<const SkeletonProjection::ColorPoint*>( &colorSpacePoints[0] ), static_cast<int>( cameraSpacePoints.size() ) ) ){
+        throw std::runtime_error( "failed SkeletonProjection::Calibration::fit()" );
+    }
+    if( !calibration.save( "ColorCalibration.txt" ) ){
+        throw std::runtime_error( "failed SkeletonProjection::Calibration::save()" );
     }
 }
 
 // Draw Ellipse
-inline void Kinect::drawEllipse( cv::Mat& image, const Joint& joint, const int radius, const cv::Vec3b& color, const int thickness )
+inline void Kinect::drawEllipse( cv::Mat& image, const SkeletonProjection::ColorPoint& point, const int radius, const cv::Vec3b& color, const int thickness )
 {
     if( image.empty() ){
         return;
     }
 
-    // Convert Coordinate System and Draw Joint
-    ColorSpacePoint colorSpacePoint;
-    ERROR_CHECK( coordinateMapper->MapCameraPointToColorSpace( joint.Position, &colorSpacePoint ) );
-    const int x = static_cast<int>( colorSpacePoint.X + 0.5f );
-    const int y = static_cast<int>( colorSpacePoint.Y + 0.5f );
-    if( ( 0 <= x ) && ( x < image.cols ) && ( 0 <= y ) && ( y < image.rows ) ){
+    // Draw Joint at Projected Position ( invalid points are mapped to -Infinity )
+    if( !( 0.0f <= point.X ) || !( 0.0f <= point.Y ) ){
+        return;
+    }
+    const int x = static_cast<int>( point.X + 0.5f );
+    const int y = static_cast<int>( point.Y + 0.5f );
+    if( ( x < image.cols ) && ( y < image.rows ) ){
         cv::circle( image, cv::Point( x, y ), radius, static_cast<cv::Scalar>( color ), thickness, cv::LINE_AA );
     }
 }
 
 // Draw Hand State
-inline void Kinect::drawHandState( cv::Mat& image, const Joint& joint, HandState handState, TrackingConfidence handConfidence )
+inline void Kinect::drawHandState( cv::Mat& image, const SkeletonProjection::ColorPoint& point, HandState handState, TrackingConfidence handConfidence )
 {
     if( image.empty() ){
         return;
@@ -299,15 +490,15 @@ inline void Kinect::drawHandState( cv::Mat& image, const Joint& joint, HandState
     switch( handState ){
         // Open
         case HandState::HandState_Open:
-            drawEllipse( image, joint, radius, green, 5 );
+            drawEllipse( image, point, radius, green, 5 );
             break;
         // Close
         case HandState::HandState_Closed:
-            drawEllipse( image, joint, radius, red, 5 );
+            drawEllipse( image, point, radius, red, 5 );
             break;
         // Lasso
         case HandState::HandState_Lasso:
-            drawEllipse( image, joint, radius, blue, 5 );
+            drawEllipse( image, point, radius, blue, 5 );
             break;
         default:
             break;
@@ -4,9 +4,12 @@
 #include <Windows.h>
 #include <Kinect.h>
 #include <opencv2/opencv.hpp>
+#include "SkeletonProjection.h"
+#include "SkeletonStream.h"
 
 #include <vector>
 #include <array>
+#include <string>
 
 #include <wrl/client.h>
 using namespace Microsoft::WRL;
@@ -35,9 +38,18 @@ private:
     std::array<IBody*, BODY_COUNT> bodies;
     std::array<cv::Vec3b, BODY_COUNT> colors;
 
+    // Skeleton Buffer ( retrieved once per frame from sensor or replay, shared by every drawing )
+    SkeletonFrame frame;
+    SkeletonProjection projection;
+
+    // Skeleton Stream ( record live frames, or replay recorded frames without sensor )
+    SkeletonRecorder recorder;
+    SkeletonReplayer replayer;
+    SkeletonProjection::Calibration calibration;
+
 public:
-    // Constructor
-    Kinect();
+    // Constructor ( replay recorded skeleton file instead of sensor if specified )
+    Kinect( const std::string& replay = "", const bool realtime = true );
 
     // Destructor
     ~Kinect();
@@ -58,6 +70,9 @@ private:
     // Initialize Body
     inline void initializeBody();
 
+    // Initialize Replay
+    inline void initializeReplay();
+
     // Finalize
     void finalize();
 
@@ -70,6 +85,15 @@ private:
     // Update Body
     inline void updateBody();
 
+    // Update Replay
+    inline void updateReplay();
+
+    // Retrieve Skeleton Frame
+    inline void retrieveFrame( const ComPtr<IBodyFrame>& bodyFrame );
+
+    // Toggle Recording
+    void toggleRecording();
+
     // Draw Data
     void draw();
 
@@ -79,11 +103,17 @@ private:
     // Draw Body
     inline void drawBody();
 
+    // Project Skeleton
+    inline void projectSkeleton();
+
+    // Save Calibration of Color Camera
+    void saveCalibration();
+
     // Draw Circle
-    inline void drawEllipse( cv::Mat& image, const Joint& joint, const int radius, const cv::Vec3b& color, const int thickness = -1 );
+    inline void drawEllipse( cv::Mat& image, const SkeletonProjection::ColorPoint& point, const int radius, const cv::Vec3b& color, const int thickness = -1 );
 
     // Draw Hand State
-    inline void drawHandState( cv::Mat& image, const Joint& joint, HandState handState, TrackingConfidence handConfidence );
+    inline void drawHandState( cv::Mat& image, const SkeletonProjection::ColorPoint& point, HandState handState, TrackingConfidence handConfidence );
 
     // Show Data
     void show();
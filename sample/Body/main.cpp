@@ -1,12 +1,19 @@
 #include <iostream>
 #include <sstream>
+#include <string>
 
 #include "app.h"
 
 int main( int argc, char* argv[] )
 {
     try{
-        Kinect kinect;
+        // Choose Replay ( recorded skeleton file, sensor if not specified )
+        const std::string replay = ( argc > 1 ) ? argv[1] : "";
+
+        // Choose Pacing of Replay ( realtime : paced by recorded time, max : maximum speed )
+        const bool realtime = !( argc > 2 && std::string( argv[2] ) == "max" );
+
+        Kinect kinect( replay, realtime );
         kinect.run();
     } catch( std::exception& ex ){
         std::cout << ex.what() << std::endl;
@@ -0,0 +1,281 @@
+#include "BodyIndexMask.h"
+
+#include <algorithm>
+#include <cstring>
+
+// Constructor
+BodyIndexMask::BodyIndexMask()
+{
+    reset( 0, 0 );
+}
+
+BodyIndexMask::BodyIndexMask( const int width, const int height )
+{
+    reset( width, height );
+}
+
+// Reset to Empty Mask of Size
+void BodyIndexMask::reset( const int width, const int height )
+{
+    this->width = width;
+    this->height = height;
+    runs.clear();
+    rowOffsets.clear();
+    rowOffsets.reserve( height + 1 );
+    rowOffsets.push_back( 0 );
+}
+
+// Append Runs of Next Row
+void BodyIndexMask::appendRow( std::vector<Run>& candidates )
+{
+    // Sort Runs by Start Position ( stable to keep priority of equal starts )
+    std::stable_sort( candidates.begin(), candidates.end(), []( const Run& a, const Run& b ){
+        return a.x < b.x;
+    } );
+
+    // Resolve Overlaps and Merge Adjacent Runs of Same Index
+    const size_t first = runs.size();
+    for( const Run& candidate : candidates ){
+        int begin = candidate.x;
+        const int end = candidate.x + candidate.length;
+        if( runs.size() > first ){
+            Run& last = runs.back();
+            const int lastEnd = last.x + last.length;
+            if( end <= lastEnd ){
+                continue;
+            }
+            if( begin <= lastEnd && last.index == candidate.index ){
+                last.length = static_cast<uint16_t>( end - last.x );
+                continue;
+            }
+            begin = std::max( begin, lastEnd );
+        }
+        runs.push_back( { static_cast<uint16_t>( begin ), static_cast<uint16_t>( end - begin ), candidate.index } );
+    }
+
+    rowOffsets.push_back( static_cast<uint32_t>( runs.size() ) );
+}
+
+// Encode from Raw BodyIndex Buffer
+void BodyIndexMask::encode( const uint8_t* buffer, const int width, const int height )
+{
+    reset( width, height );
+
+    const uint64_t background = ~0ull;
+    for( int y = 0; y < height; y++ ){
+        const uint8_t* row = buffer + y * width;
+        int x = 0;
+        while( x < width ){
+            // Skip Background 8 Pixels at a Time
+            while( x + 8 <= width ){
+                uint64_t block;
+                std::memcpy( &block, row + x, sizeof( block ) );
+                if( block != background ){
+                    break;
+                }
+                x += 8;
+            }
+            while( x < width && row[x] == BACKGROUND ){
+                x++;
+            }
+            if( x >= width ){
+                break;
+            }
+
+            // Measure Run of Same Index
+            const uint8_t index = row[x];
+            const int begin = x;
+            while( x < width && row[x] == index ){
+                x++;
+            }
+            runs.push_back( { static_cast<uint16_t>( begin ), static_cast<uint16_t>( x - begin ), index } );
+        }
+        rowOffsets.push_back( static_cast<uint32_t>( runs.size() ) );
+    }
+}
+
+// Decode to Raw BodyIndex Buffer
+void BodyIndexMask::decode( uint8_t* buffer ) const
+{
+    std::memset( buffer, BACKGROUND, static_cast<size_t>( width ) * height );
+    for( int y = 0; y < height; y++ ){
+        uint8_t* row = buffer + y * width;
+        for( const Run* run = rowBegin( y ); run != rowEnd( y ); run++ ){
+            std::memset( row + run->x, run->index, run->length );
+        }
+    }
+}
+
+// Serialize to Compact Byte Stream
+// Layout ( little endian ) : width(2) height(2) { count(2) { x(2) length(2) index(1) } * count } * height
+void BodyIndexMask::serialize( std::vector<uint8_t>& stream ) const
+{
+    stream.clear();
+    stream.reserve( 4 + height * 2 + runs.size() * 5 );
+
+    auto write16 = [ & ]( const uint32_t value ){
+        stream.push_back( static_cast<uint8_t>( value & 0xff ) );
+        stream.push_back( static_cast<uint8_t>( ( value >> 8 ) & 0xff ) );
+    };
+
+    write16( width );
+    write16( height );
+    for( int y = 0; y < height; y++ ){
+        write16( rowOffsets[y + 1] - rowOffsets[y] );
+        for( const Run* run = rowBegin( y ); run != rowEnd( y ); run++ ){
+            write16( run->x );
+            write16( run->length );
+            stream.push_back( run->index );
+        }
+    }
+}
+
+// Deserialize from Compact Byte Stream
+bool BodyIndexMask::deserialize( const uint8_t* stream, const size_t size )
+{
+    size_t position = 0;
+    auto read16 = [ & ]( uint32_t& value ){
+        if( position + 2 > size ){
+            return false;
+        }
+        value = stream[position] | ( stream[position + 1] << 8 );
+        position += 2;
+        return true;
+    };
+
+    uint32_t width, height;
+    if( !read16( width ) || !read16( height ) ){
+        return false;
+    }
+
+    reset( width, height );
+    for( uint32_t y = 0; y < height; y++ ){
+        uint32_t count;
+        if( !read16( count ) ){
+            return false;
+        }
+        for( uint32_t i = 0; i < count; i++ ){
+            uint32_t x, length;
+            if( !read16( x ) || !read16( length ) || position + 1 > size ){
+                return false;
+            }
+            if( x + length > width ){
+                return false;
+            }
+            runs.push_back( { static_cast<uint16_t>( x ), static_cast<uint16_t>( length ), stream[position++] } );
+        }
+        rowOffsets.push_back( static_cast<uint32_t>( runs.size() ) );
+    }
+
+    return true;
+}
+
+// Union
+BodyIndexMask BodyIndexMask::unite( const BodyIndexMask& other ) const
+{
+    BodyIndexMask mask( width, height );
+    mask.runs.reserve( runs.size() + other.runs.size() );
+
+    std::vector<Run> candidates;
+    for( int y = 0; y < height; y++ ){
+        candidates.clear();
+
+        // Runs of This Mask are Kept as They are
+        const Run* a = rowBegin( y );
+        const Run* aEnd = rowEnd( y );
+        candidates.insert( candidates.end(), a, aEnd );
+
+        // Runs of Other Mask are Clipped to Gaps between Runs of This Mask
+        for( const Run* b = other.rowBegin( y ); b != other.rowEnd( y ); b++ ){
+            int begin = b->x;
+            const int end = b->x + b->length;
+            while( a != aEnd && a->x + a->length <= begin ){
+                a++;
+            }
+            for( const Run* gap = a; gap != aEnd && gap->x < end && begin < end; gap++ ){
+                if( begin < gap->x ){
+                    candidates.push_back( { static_cast<uint16_t>( begin ), static_cast<uint16_t>( gap->x - begin ), b->index } );
+                }
+                begin = std::max( begin, gap->x + gap->length );
+            }
+            if( begin < end ){
+                candidates.push_back( { static_cast<uint16_t>( begin ), static_cast<uint16_t>( end - begin ), b->index } );
+            }
+        }
+
+        mask.appendRow( candidates );
+    }
+
+    return mask;
+}
+
+// Extract Runs of One Body
+BodyIndexMask BodyIndexMask::extract( const uint8_t index ) const
+{
+    BodyIndexMask mask( width, height );
+    for( int y = 0; y < height; y++ ){
+        for( const Run* run = rowBegin( y ); run != rowEnd( y ); run++ ){
+            if( run->index == index ){
+                mask.runs.push_back( *run );
+            }
+        }
+        mask.rowOffsets.push_back( static_cast<uint32_t>( mask.runs.size() ) );
+    }
+
+    return mask;
+}
+
+// Dilation
+BodyIndexMask BodyIndexMask::dilate( const int radius ) const
+{
+    if( radius <= 0 ){
+        return *this;
+    }
+
+    BodyIndexMask mask( width, height );
+    mask.runs.reserve( runs.size() );
+
+    std::vector<Run> candidates;
+    for( int y = 0; y < height; y++ ){
+        candidates.clear();
+
+        // Gather Horizontally Expanded Runs from Neighbor Rows
+        const int top = std::max( 0, y - radius );
+        const int bottom = std::min( height - 1, y + radius );
+        for( int neighbor = top; neighbor <= bottom; neighbor++ ){
+            for( const Run* run = rowBegin( neighbor ); run != rowEnd( neighbor ); run++ ){
+                const int begin = std::max( 0, run->x - radius );
+                const int end = std::min( width, run->x + run->length + radius );
+                candidates.push_back( { static_cast<uint16_t>( begin ), static_cast<uint16_t>( end - begin ), run->index } );
+            }
+        }
+
+        mask.appendRow( candidates );
+    }
+
+    return mask;
+}
+
+// Area
+size_t BodyIndexMask::area() const
+{
+    size_t area = 0;
+    for( const Run& run : runs ){
+        area += run.length;
+    }
+
+    return area;
+}
+
+// Area of One Body
+size_t BodyIndexMask::area( const uint8_t index ) const
+{
+    size_t area = 0;
+    for( const Run& run : runs ){
+        if( run.index == index ){
+            area += run.length;
+        }
+    }
+
+    return area;
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#ifndef __BODY_INDEX_MASK__
+#define __BODY_INDEX_MASK__
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Run-Length Encoded BodyIndex Mask
+// Each row is stored as a sorted list of non-overlapping runs of the same body index.
+// Background pixels ( 0xff ) are not stored, so memory and processing time are proportional to the area of the people in the frame.
+class BodyIndexMask
+{
+public:
+    // Background Value of BodyIndex Frame
+    static const uint8_t BACKGROUND = 0xff;
+
+    // Run ( [x, x + length) on one row, all pixels have same index )
+    struct Run
+    {
+        uint16_t x;
+        uint16_t length;
+        uint8_t index;
+    };
+
+private:
+    // Mask Size
+    int width;
+    int height;
+
+    // Runs of All Rows
+    std::vector<Run> runs;
+
+    // Offset of First Run of Each Row ( rows + 1 entries )
+    std::vector<uint32_t> rowOffsets;
+
+public:
+    // Constructor
+    BodyIndexMask();
+    BodyIndexMask( const int width, const int height );
+
+    // Encode from Raw BodyIndex Buffer ( width * height bytes )
+    void encode( const uint8_t* buffer, const int width, const int height );
+
+    // Decode to Raw BodyIndex Buffer ( width * height bytes )
+    void decode( uint8_t* buffer ) const;
+
+    // Serialize to Compact Byte Stream
+    void serialize( std::vector<uint8_t>& stream ) const;
+
+    // Deserialize from Compact Byte Stream ( return false if stream is broken )
+    bool deserialize( const uint8_t* stream, const size_t size );
+
+    // Union ( overlapping pixels keep index of this mask )
+    BodyIndexMask unite( const BodyIndexMask& other ) const;
+
+    // Extract Runs of One Body
+    BodyIndexMask extract( const uint8_t index ) const;
+
+    // Dilation with ( 2 * radius + 1 ) Square Structuring Element
+    BodyIndexMask dilate( const int radius ) const;
+
+    // Area ( number of foreground pixels )
+    size_t area() const;
+
+    // Area of One Body
+    size_t area( const uint8_t index ) const;
+
+    // Check Empty ( no foreground pixels )
+    bool empty() const
+    {
+        return runs.empty();
+    }
+
+    // Retrieve Mask Size
+    int getWidth() const
+    {
+        return width;
+    }
+
+    int getHeight() const
+    {
+        return height;
+    }
+
+    // Retrieve Runs of Row
+    const Run* rowBegin( const int y ) const
+    {
+        return runs.data() + rowOffsets[y];
+    }
+
+    const Run* rowEnd( const int y ) const
+    {
+        return runs.data() + rowOffsets[y + 1];
+    }
+
+    // Retrieve Number of Runs
+    size_t count() const
+    {
+        return runs.size();
+    }
+
+private:
+    // Reset to Empty Mask of Size
+    void reset( const int width, const int height );
+
+    // Append Runs of Next Row ( candidates may overlap, run that starts first wins )
+    void appendRow( std::vector<Run>& candidates );
+};
+
+#endif // __BODY_INDEX_MASK__
\ No newline at end of file
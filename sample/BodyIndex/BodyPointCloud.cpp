@@ -0,0 +1,194 @@
+#include "BodyPointCloud.h"
+
+#include <algorithm>
+#include <limits>
+
+// Constructor
+BodyPointCloud::BodyPointCloud()
+    : width( 0 ),
+      height( 0 ),
+      minimumDepth( 500 ),
+      maximumDepth( 8000 ),
+      background( false ),
+      bands( BANDS )
+{
+    for( Cloud& cloud : clouds ){
+        reset( cloud );
+    }
+}
+
+// Initialize by Ray Table
+void BodyPointCloud::initialize( const int width, const int height, const Ray* table )
+{
+    this->width = width;
+    this->height = height;
+    this->table.assign( table, table + width * height );
+
+    // Reserve Buffers for Worst Case ( whole band is one body ), so that extraction does not allocate
+    const size_t capacity = static_cast<size_t>( width ) * ( ( height + BANDS - 1 ) / BANDS );
+    for( Band& band : bands ){
+        for( Cloud& cloud : band.clouds ){
+            cloud.points.reserve( capacity );
+        }
+    }
+    for( Cloud& cloud : clouds ){
+        reset( cloud );
+        cloud.points.reserve( static_cast<size_t>( width ) * height );
+    }
+}
+
+// Set Valid Depth Range
+void BodyPointCloud::setDepthRange( const uint16_t minimum, const uint16_t maximum )
+{
+    minimumDepth = minimum;
+    maximumDepth = maximum;
+}
+
+// Set Extract Background Cloud
+void BodyPointCloud::setBackground( const bool background )
+{
+    this->background = background;
+}
+
+// Extract Point Clouds
+void BodyPointCloud::extract( const uint16_t* depth, const uint8_t* bodyIndex )
+{
+    if( table.empty() ){
+        return;
+    }
+
+    // Split Rows into Bands ( each band is written by only one thread )
+    #pragma omp parallel for schedule( dynamic )
+    for( int index = 0; index < BANDS; index++ ){
+        Band& band = bands[index];
+        for( int cloud = 0; cloud < CLOUDS; cloud++ ){
+            reset( band.clouds[cloud] );
+            band.sums[cloud] = { 0.0, 0.0, 0.0 };
+        }
+
+        const int begin = height * index / BANDS;
+        const int end = height * ( index + 1 ) / BANDS;
+        for( int y = begin; y < end; y++ ){
+            const int offset = y * width;
+            const uint16_t* depthRow = depth + offset;
+            const uint8_t* bodyIndexRow = bodyIndex + offset;
+            const Ray* rayRow = &table[offset];
+
+            for( int x = 0; x < width; x++ ){
+                // Select Cloud by BodyIndex ( 0xff is background )
+                int cloudIndex = bodyIndexRow[x];
+                if( cloudIndex >= BODIES ){
+                    if( !background ){
+                        continue;
+                    }
+                    cloudIndex = BACKGROUND;
+                }
+
+                // Skip Invalid Depth
+                const uint16_t value = depthRow[x];
+                if( value < minimumDepth || maximumDepth < value ){
+                    continue;
+                }
+
+                // Convert to Camera Space
+                const float z = value * 0.001f;
+                const Point point = { rayRow[x].X * z, rayRow[x].Y * z, z };
+
+                Cloud& cloud = band.clouds[cloudIndex];
+                cloud.points.push_back( point );
+
+                // Update Bounding Box and Sum
+                cloud.minimum.X = std::min( cloud.minimum.X, point.X );
+                cloud.minimum.Y = std::min( cloud.minimum.Y, point.Y );
+                cloud.minimum.Z = std::min( cloud.minimum.Z, point.Z );
+                cloud.maximum.X = std::max( cloud.maximum.X, point.X );
+                cloud.maximum.Y = std::max( cloud.maximum.Y, point.Y );
+                cloud.maximum.Z = std::max( cloud.maximum.Z, point.Z );
+                cloud.left = std::min( cloud.left, x );
+                cloud.right = std::max( cloud.right, x );
+                cloud.top = std::min( cloud.top, y );
+                cloud.bottom = y;
+
+                std::array<double, 3>& sum = band.sums[cloudIndex];
+                sum[0] += point.X;
+                sum[1] += point.Y;
+                sum[2] += point.Z;
+            }
+        }
+    }
+
+    // Merge Statistics and Compute Offsets of Each Band ( in band order, so points keep raster order )
+    std::array<std::array<double, 3>, CLOUDS> sums;
+    for( int cloudIndex = 0; cloudIndex < CLOUDS; cloudIndex++ ){
+        Cloud& cloud = clouds[cloudIndex];
+        reset( cloud );
+
+        std::array<double, 3>& sum = sums[cloudIndex];
+        sum = { 0.0, 0.0, 0.0 };
+
+        size_t size = 0;
+        for( Band& band : bands ){
+            const Cloud& part = band.clouds[cloudIndex];
+            band.offsets[cloudIndex] = size;
+            size += part.points.size();
+            if( part.empty() ){
+                continue;
+            }
+
+            cloud.minimum.X = std::min( cloud.minimum.X, part.minimum.X );
+            cloud.minimum.Y = std::min( cloud.minimum.Y, part.minimum.Y );
+            cloud.minimum.Z = std::min( cloud.minimum.Z, part.minimum.Z );
+            cloud.maximum.X = std::max( cloud.maximum.X, part.maximum.X );
+            cloud.maximum.Y = std::max( cloud.maximum.Y, part.maximum.Y );
+            cloud.maximum.Z = std::max( cloud.maximum.Z, part.maximum.Z );
+            cloud.left = std::min( cloud.left, part.left );
+            cloud.right = std::max( cloud.right, part.right );
+            cloud.top = std::min( cloud.top, part.top );
+            cloud.bottom = std::max( cloud.bottom, part.bottom );
+
+            const std::array<double, 3>& partSum = band.sums[cloudIndex];
+            sum[0] += partSum[0];
+            sum[1] += partSum[1];
+            sum[2] += partSum[2];
+        }
+
+        cloud.points.resize( size );
+    }
+
+    // Copy Band Buffers to Their Own Range of Clouds
+    #pragma omp parallel for schedule( dynamic )
+    for( int index = 0; index < BANDS; index++ ){
+        const Band& band = bands[index];
+        for( int cloudIndex = 0; cloudIndex < CLOUDS; cloudIndex++ ){
+            const std::vector<Point>& points = band.clouds[cloudIndex].points;
+            std::copy( points.begin(), points.end(), clouds[cloudIndex].points.begin() + band.offsets[cloudIndex] );
+        }
+    }
+
+    // Compute Centroid
+    for( int cloudIndex = 0; cloudIndex < CLOUDS; cloudIndex++ ){
+        Cloud& cloud = clouds[cloudIndex];
+        if( cloud.empty() ){
+            continue;
+        }
+
+        const double count = static_cast<double>( cloud.points.size() );
+        cloud.centroid.X = static_cast<float>( sums[cloudIndex][0] / count );
+        cloud.centroid.Y = static_cast<float>( sums[cloudIndex][1] / count );
+        cloud.centroid.Z = static_cast<float>( sums[cloudIndex][2] / count );
+    }
+}
+
+// Reset Cloud to Empty ( capacity of points is kept )
+void BodyPointCloud::reset( Cloud& cloud )
+{
+    const float infinity = std::numeric_limits<float>::infinity();
+    cloud.points.clear();
+    cloud.minimum = { infinity, infinity, infinity };
+    cloud.maximum = { -infinity, -infinity, -infinity };
+    cloud.centroid = { 0.0f, 0.0f, 0.0f };
+    cloud.left = std::numeric_limits<int>::max();
+    cloud.top = std::numeric_limits<int>::max();
+    cloud.right = -1;
+    cloud.bottom = -1;
+}
\ No newline at end of file
@@ -0,0 +1,121 @@
+#ifndef __BODY_POINT_CLOUD__
+#define __BODY_POINT_CLOUD__
+
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+// Body Point Cloud
+// Depth frame is split into compact point clouds of each body ( and background ) in one pass by BodyIndex frame.
+// Camera space points are computed from cached ray table ( GetDepthFrameToCameraSpaceTable ), so coordinate mapper is not called per frame.
+// Rows are processed in bands in parallel, each band has own output buffers, then buffers are concatenated without locks.
+// This class has no dependency on Kinect SDK.
+class BodyPointCloud
+{
+public:
+    // Number of Bodies ( same as BODY_COUNT ), and Index of Background Cloud
+    static const int BODIES = 6;
+    static const int BACKGROUND = BODIES;
+    static const int CLOUDS = BODIES + 1;
+
+    // Number of Row Bands
+    static const int BANDS = 16;
+
+    // Point ( same layout as CameraSpacePoint )
+    struct Point
+    {
+        float X;
+        float Y;
+        float Z;
+    };
+
+    // Ray ( same layout as PointF, camera space X, Y at 1 [m] depth )
+    struct Ray
+    {
+        float X;
+        float Y;
+    };
+
+    // Point Cloud of One Body
+    struct Cloud
+    {
+        std::vector<Point> points;
+
+        // Bounding Box and Centroid in Camera Space [m]
+        Point minimum;
+        Point maximum;
+        Point centroid;
+
+        // Bounding Box in Depth Image [pixel] ( right and bottom are inclusive )
+        int left;
+        int top;
+        int right;
+        int bottom;
+
+        // Check Empty
+        bool empty() const
+        {
+            return points.empty();
+        }
+    };
+
+private:
+    // Band Buffer ( owned by one thread during extraction )
+    struct Band
+    {
+        std::array<Cloud, CLOUDS> clouds;
+        std::array<std::array<double, 3>, CLOUDS> sums;
+        size_t offsets[CLOUDS];
+    };
+
+    // Frame Size
+    int width;
+    int height;
+
+    // Ray Table ( width * height )
+    std::vector<Ray> table;
+
+    // Valid Depth Range [mm]
+    uint16_t minimumDepth;
+    uint16_t maximumDepth;
+
+    // Extract Background Cloud
+    bool background;
+
+    std::array<Cloud, CLOUDS> clouds;
+    std::vector<Band> bands;
+
+public:
+    // Constructor
+    BodyPointCloud();
+
+    // Initialize by Ray Table ( width * height rays )
+    void initialize( const int width, const int height, const Ray* table );
+
+    // Set Valid Depth Range [mm] ( default is 500-8000 )
+    void setDepthRange( const uint16_t minimum, const uint16_t maximum );
+
+    // Set Extract Background Cloud ( default is false )
+    void setBackground( const bool background );
+
+    bool getBackground() const
+    {
+        return background;
+    }
+
+    // Extract Point Clouds from Depth and BodyIndex Buffer ( width * height each )
+    void extract( const uint16_t* depth, const uint8_t* bodyIndex );
+
+    // Retrieve Point Cloud ( 0-5 are bodies, BACKGROUND is background )
+    const Cloud& getCloud( const int index ) const
+    {
+        return clouds[index];
+    }
+
+private:
+    // Reset Cloud to Empty
+    static void reset( Cloud& cloud );
+};
+
+#endif // __BODY_POINT_CLOUD__
\ No newline at end of file
@@ -37,6 +37,10 @@ void Kinect::run()
         if( key == VK_ESCAPE ){
             break;
         }
+        else if( key == 'b' ){
+            // Toggle Background Cloud
+            pointCloud.setBackground( !pointCloud.getBackground() );
+        }
     }
 }
 
@@ -51,6 +55,9 @@ void Kinect::initialize()
     // Initialize BodyIndex
     initializeBodyIndex();
 
+    // Initialize Depth
+    initializeDepth();
+
     // Wait a Few Seconds until begins to Retrieve Data from Sensor ( about 2000-[ms] )
     std::this_thread::sleep_for( std::chrono::seconds( 2 ) );
 }
@@ -69,6 +76,9 @@ inline void Kinect::initializeSensor()
     if( !isOpen ){
         throw std::runtime_error( "failed IKinectSensor::get_IsOpen( &isOpen )" );
     }
+
+    // Retrieve Coordinate Mapper
+    ERROR_CHECK( kinect->get_CoordinateMapper( &coordinateMapper ) );
 }
 
 // Initialize BodyIndex
@@ -88,6 +98,7 @@ inline void Kinect::initializeBodyIndex()
 
     // Allocation BodyIndex Buffer
     bodyIndexBuffer.resize( bodyIndexWidth * bodyIndexHeight );
+    bodyIndexTime = 0;
 
     // Color Table for Visualization
     colors[0] = cv::Vec3b( 255,   0,   0 ); // Blue
@@ -98,6 +109,30 @@ inline void Kinect::initializeBodyIndex()
     colors[5] = cv::Vec3b(   0, 255, 255 ); // Yellow
 }
 
+// Initialize Depth
+inline void Kinect::initializeDepth()
+{
+    // Open Depth Reader
+    ComPtr<IDepthFrameSource> depthFrameSource;
+    ERROR_CHECK( kinect->get_DepthFrameSource( &depthFrameSource ) );
+    ERROR_CHECK( depthFrameSource->OpenReader( &depthFrameReader ) );
+
+    // Retrieve Depth Description
+    ComPtr<IFrameDescription> depthFrameDescription;
+    ERROR_CHECK( depthFrameSource->get_FrameDescription( &depthFrameDescription ) );
+    ERROR_CHECK( depthFrameDescription->get_Width( &depthWidth ) ); // 512
+    ERROR_CHECK( depthFrameDescription->get_Height( &depthHeight ) ); // 424
+    ERROR_CHECK( depthFrameDescription->get_BytesPerPixel( &depthBytesPerPixel ) ); // 2
+
+    // Allocation Depth Buffer
+    depthBuffer.resize( depthWidth * depthHeight );
+    depthTime = 0;
+
+    // Ray Table is Retrieved after Sensor Calibration is Available
+    hasRayTable = false;
+    pointCloudTime = 0;
+}
+
 // Finalize
 void Kinect::finalize()
 {
@@ -114,6 +149,12 @@ void Kinect::update()
 {
     // Update BodyIndex
     updateBodyIndex();
+
+    // Update Depth
+    updateDepth();
+
+    // Update Point Cloud
+    updatePointCloud();
 }
 
 // Update BodyIndex
@@ -128,6 +169,58 @@ inline void Kinect::updateBodyIndex()
 
     // Retrieve BodyIndex Data
     ERROR_CHECK( bodyIndexFrame->CopyFrameDataToArray( static_cast<UINT>( bodyIndexBuffer.size() ), &bodyIndexBuffer[0] ) );
+    ERROR_CHECK( bodyIndexFrame->get_RelativeTime( &bodyIndexTime ) );
+
+    // Encode BodyIndex Mask ( Run-Length )
+    bodyIndexMask.encode( &bodyIndexBuffer[0], bodyIndexWidth, bodyIndexHeight );
+}
+
+// Update Depth
+inline void Kinect::updateDepth()
+{
+    // Retrieve Depth Frame
+    ComPtr<IDepthFrame> depthFrame;
+    const HRESULT ret = depthFrameReader->AcquireLatestFrame( &depthFrame );
+    if( FAILED( ret ) ){
+        return;
+    }
+
+    // Retrieve Depth Data
+    ERROR_CHECK( depthFrame->CopyFrameDataToArray( static_cast<UINT>( depthBuffer.size() ), &depthBuffer[0] ) );
+    ERROR_CHECK( depthFrame->get_RelativeTime( &depthTime ) );
+}
+
+// Update Point Cloud
+inline void Kinect::updatePointCloud()
+{
+    // Retrieve Ray Table from Coordinate Mapper ( camera space X, Y of each depth pixel at 1 [m] )
+    if( !hasRayTable ){
+        UINT32 count = 0;
+        PointF* table = nullptr;
+        if( FAILED( coordinateMapper->GetDepthFrameToCameraSpaceTable( &count, &table ) ) ){
+            return;
+        }
+
+        if( count == static_cast<UINT32>( depthWidth * depthHeight ) ){
+            static_assert( sizeof( PointF ) == sizeof( BodyPointCloud::Ray ), "BodyPointCloud::Ray must have same layout as PointF" );
+            pointCloud.initialize( depthWidth, depthHeight, reinterpret_cast<const BodyPointCloud::Ray*>( table ) );
+            hasRayTable = true;
+        }
+        CoTaskMemFree( table );
+
+        if( !hasRayTable ){
+            return;
+        }
+    }
+
+    // Keep Previous Point Cloud until Both Depth and BodyIndex are Updated for New Same Frame
+    if( depthTime == 0 || depthTime != bodyIndexTime || depthTime == pointCloudTime ){
+        return;
+    }
+
+    // Extract Point Cloud of Each Body ( depth and bodyindex have same resolution )
+    pointCloud.extract( &depthBuffer[0], &bodyIndexBuffer[0] );
+    pointCloudTime = depthTime;
 }
 
 // Draw Data
@@ -140,14 +233,40 @@ void Kinect::draw()
 // Draw BodyIndex
 inline void Kinect::drawBodyIndex()
 {
-    // Visualization Color to Each Index
+    // Visualization Color to Each Index ( only pixels covered by runs are visited )
     bodyIndexMat = cv::Mat::zeros( bodyIndexHeight, bodyIndexWidth, CV_8UC3 );
-    bodyIndexMat.forEach<cv::Vec3b>( [ & ]( cv::Vec3b &p, const int* position ){
-        uchar index = bodyIndexBuffer[position[0] * bodyIndexWidth + position[1]];
-        if( index != 0xff ){
-            p = colors[index];
+    for( int y = 0; y < bodyIndexMask.getHeight(); y++ ){
+        cv::Vec3b* row = bodyIndexMat.ptr<cv::Vec3b>( y );
+        for( const BodyIndexMask::Run* run = bodyIndexMask.rowBegin( y ); run != bodyIndexMask.rowEnd( y ); run++ ){
+            std::fill( row + run->x, row + run->x + run->length, colors[run->index] );
         }
-    } );
+    }
+
+    // Draw Point Cloud
+    drawPointCloud();
+}
+
+// Draw Point Cloud
+inline void Kinect::drawPointCloud()
+{
+    // Draw Bounding Box, Centroid and Number of Points of Each Body
+    for( int index = 0; index < BODY_COUNT; index++ ){
+        const BodyPointCloud::Cloud& cloud = pointCloud.getCloud( index );
+        if( cloud.empty() ){
+            continue;
+        }
+
+        const cv::Scalar color = static_cast<cv::Scalar>( colors[index] );
+        cv::rectangle( bodyIndexMat, cv::Point( cloud.left, cloud.top ), cv::Point( cloud.right, cloud.bottom ), color, 1 );
+        cv::putText( bodyIndexMat, cv::format( "%d pts", static_cast<int>( cloud.points.size() ) ), cv::Point( cloud.left, cloud.top - 18 ), cv::FONT_HERSHEY_SIMPLEX, 0.4, color, 1, cv::LINE_AA );
+        cv::putText( bodyIndexMat, cv::format( "%.2f, %.2f, %.2f m", cloud.centroid.X, cloud.centroid.Y, cloud.centroid.Z ), cv::Point( cloud.left, cloud.top - 4 ), cv::FONT_HERSHEY_SIMPLEX, 0.4, color, 1, cv::LINE_AA );
+    }
+
+    // Draw Number of Points of Background
+    const BodyPointCloud::Cloud& background = pointCloud.getCloud( BodyPointCloud::BACKGROUND );
+    if( pointCloud.getBackground() ){
+        cv::putText( bodyIndexMat, cv::format( "background %d pts", static_cast<int>( background.points.size() ) ), cv::Point( 10, 20 ), cv::FONT_HERSHEY_SIMPLEX, 0.5, cv::Scalar( 255, 255, 255 ), 1, cv::LINE_AA );
+    }
 }
 
 // Show Data
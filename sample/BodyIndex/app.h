@@ -4,6 +4,8 @@
 #include <Windows.h>
 #include <Kinect.h>
 #include <opencv2/opencv.hpp>
+#include "BodyIndexMask.h"
+#include "BodyPointCloud.h"
 
 #include <vector>
 
@@ -18,16 +20,34 @@ private:
     // Sensor
     ComPtr<IKinectSensor> kinect;
 
+    // Coordinate Mapper
+    ComPtr<ICoordinateMapper> coordinateMapper;
+
     // Reader
     ComPtr<IBodyIndexFrameReader> bodyIndexFrameReader;
+    ComPtr<IDepthFrameReader> depthFrameReader;
 
     // BodyIndex Buffer
     std::vector<BYTE> bodyIndexBuffer;
     int bodyIndexWidth;
     int bodyIndexHeight;
     unsigned int bodyIndexBytesPerPixel;
+    BodyIndexMask bodyIndexMask;
     cv::Mat bodyIndexMat;
     std::array<cv::Vec3b, BODY_COUNT> colors;
+    TIMESPAN bodyIndexTime;
+
+    // Depth Buffer
+    std::vector<UINT16> depthBuffer;
+    int depthWidth;
+    int depthHeight;
+    unsigned int depthBytesPerPixel;
+    TIMESPAN depthTime;
+
+    // Point Cloud of Each Body ( ray table is retrieved once from coordinate mapper, extracted once per pair of same RelativeTime )
+    BodyPointCloud pointCloud;
+    bool hasRayTable;
+    TIMESPAN pointCloudTime;
 
 public:
     // Constructor
@@ -49,6 +69,9 @@ private:
     // Initialize BodyIndex
     inline void initializeBodyIndex();
 
+    // Initialize Depth
+    inline void initializeDepth();
+
     // Finalize
     void finalize();
 
@@ -58,12 +81,21 @@ private:
     // Update BodyIndex
     inline void updateBodyIndex();
 
+    // Update Depth
+    inline void updateDepth();
+
+    // Update Point Cloud
+    inline void updatePointCloud();
+
     // Draw Data
     void draw();
 
     // Draw BodyIndex
     inline void drawBodyIndex();
 
+    // Draw Point Cloud
+    inline void drawPointCloud();
+
     // Show Data
     void show();
 
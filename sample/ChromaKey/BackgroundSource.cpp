@@ -0,0 +1,218 @@
+#include "BackgroundSource.h"
+
+#include <algorithm>
+
+#if defined( _M_X64 ) || defined( __SSE2__ )
+#include <emmintrin.h>
+#endif
+
+// Constructor
+BackgroundSource::BackgroundSource()
+    : ready( false ),
+      running( false )
+{
+}
+
+// Destructor
+BackgroundSource::~BackgroundSource()
+{
+    // Close Source
+    close();
+}
+
+// Open Source and Start Worker Thread
+bool BackgroundSource::open( const std::string& path )
+{
+    close();
+
+    this->path = path;
+
+    // Still Image
+    still = cv::imread( path, cv::IMREAD_COLOR );
+
+    // Image Sequence or Video
+    if( still.empty() ){
+        if( !capture.open( path ) ){
+            return false;
+        }
+    }
+
+    // Start Worker Thread
+    ready = false;
+    producedSize = cv::Size();
+    running = true;
+    thread = std::thread( &BackgroundSource::worker, this );
+
+    return true;
+}
+
+// Stop Worker Thread and Close Source
+void BackgroundSource::close()
+{
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        running = false;
+    }
+    condition.notify_one();
+
+    if( thread.joinable() ){
+        thread.join();
+    }
+
+    capture.release();
+    still.release();
+    front.release();
+    back.release();
+}
+
+// Request Size of Frames
+void BackgroundSource::resize( const cv::Size& size )
+{
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        if( this->size == size ){
+            return;
+        }
+        this->size = size;
+    }
+    condition.notify_one();
+}
+
+// Retrieve Latest Prefetched Frame
+const cv::Mat& BackgroundSource::acquire()
+{
+    std::lock_guard<std::mutex> lock( mutex );
+
+    // Swap Buffers if Worker has Prepared Next Frame
+    if( ready ){
+        std::swap( front, back );
+        ready = false;
+        condition.notify_one();
+    }
+
+    return front;
+}
+
+// Worker Thread
+void BackgroundSource::worker()
+{
+    // Frame Interval of Video or Image Sequence ( 30 [fps] if frame rate is unknown )
+    const double fps = still.empty() ? capture.get( cv::CAP_PROP_FPS ) : 0.0;
+    const std::chrono::microseconds interval( static_cast<int64_t>( 1000000.0 / ( ( fps > 0.0 ) ? fps : 30.0 ) ) );
+    std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now();
+
+    cv::Mat frame, resizeMat;
+    while( true ){
+        // Wait until Back Buffer is Free ( still image is produced again only when size is changed )
+        cv::Size target;
+        {
+            std::unique_lock<std::mutex> lock( mutex );
+            condition.wait( lock, [ & ](){
+                return !running || ( !ready && size.area() > 0 && ( still.empty() || producedSize != size ) );
+            } );
+            if( !running ){
+                break;
+            }
+            target = size;
+
+            // Pace Video and Image Sequence by Frame Rate ( wake up immediately if closed, late frames are not caught up )
+            if( still.empty() ){
+                if( condition.wait_until( lock, next, [ & ](){ return !running; } ) ){
+                    break;
+                }
+                next = std::max( next + interval, std::chrono::steady_clock::now() );
+            }
+        }
+
+        // Decode, Resize and Convert into Back Buffer
+        if( !decode( frame ) ){
+            std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+            continue;
+        }
+        cv::resize( frame, resizeMat, target );
+        cv::cvtColor( resizeMat, back, cv::COLOR_BGR2BGRA );
+
+        // Publish Back Buffer
+        {
+            std::lock_guard<std::mutex> lock( mutex );
+            producedSize = target;
+            ready = true;
+        }
+    }
+}
+
+// Decode Next Frame
+bool BackgroundSource::decode( cv::Mat& frame )
+{
+    // Still Image
+    if( !still.empty() ){
+        frame = still;
+        return true;
+    }
+
+    // Image Sequence or Video ( reopen to loop at the end )
+    if( capture.read( frame ) && !frame.empty() ){
+        return true;
+    }
+    if( !capture.open( path ) ){
+        return false;
+    }
+
+    return capture.read( frame ) && !frame.empty();
+}
+
+// Alpha Blending
+// composite = foreground + background * ( 255 - alpha ) / 255
+void alphaBlend( const cv::Mat& foreground, const cv::Mat& background, cv::Mat& composite )
+{
+    CV_Assert( foreground.type() == CV_8UC4 && background.type() == CV_8UC4 && foreground.size() == background.size() );
+    composite.create( foreground.size(), CV_8UC4 );
+
+    const int width = foreground.cols;
+
+    #pragma omp parallel for
+    for( int y = 0; y < foreground.rows; y++ ){
+        const uchar* foregroundRow = foreground.ptr<uchar>( y );
+        const uchar* backgroundRow = background.ptr<uchar>( y );
+        uchar* compositeRow = composite.ptr<uchar>( y );
+
+        int x = 0;
+#if defined( _M_X64 ) || defined( __SSE2__ )
+        // 4 Pixels at a Time
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i ones = _mm_set1_epi8( -1 );
+        const __m128i half = _mm_set1_epi16( 128 );
+        for( ; x + 4 <= width; x += 4 ){
+            const __m128i source = _mm_loadu_si128( reinterpret_cast<const __m128i*>( foregroundRow + x * 4 ) );
+            const __m128i destination = _mm_loadu_si128( reinterpret_cast<const __m128i*>( backgroundRow + x * 4 ) );
+
+            // Broadcast Inverse Alpha to All Channels
+            __m128i alpha = _mm_srli_epi32( source, 24 );
+            alpha = _mm_or_si128( alpha, _mm_slli_epi32( alpha, 8 ) );
+            alpha = _mm_or_si128( alpha, _mm_slli_epi32( alpha, 16 ) );
+            const __m128i inverse = _mm_xor_si128( alpha, ones );
+
+            // background * inverse / 255 ( ( x + 128 + ( ( x + 128 ) >> 8 ) ) >> 8 )
+            __m128i low = _mm_add_epi16( _mm_mullo_epi16( _mm_unpacklo_epi8( destination, zero ), _mm_unpacklo_epi8( inverse, zero ) ), half );
+            __m128i high = _mm_add_epi16( _mm_mullo_epi16( _mm_unpackhi_epi8( destination, zero ), _mm_unpackhi_epi8( inverse, zero ) ), half );
+            low = _mm_srli_epi16( _mm_add_epi16( low, _mm_srli_epi16( low, 8 ) ), 8 );
+            high = _mm_srli_epi16( _mm_add_epi16( high, _mm_srli_epi16( high, 8 ) ), 8 );
+
+            const __m128i result = _mm_adds_epu8( source, _mm_packus_epi16( low, high ) );
+            _mm_storeu_si128( reinterpret_cast<__m128i*>( compositeRow + x * 4 ), result );
+        }
+#endif
+
+        // Remaining Pixels
+        for( ; x < width; x++ ){
+            const uchar* source = foregroundRow + x * 4;
+            const uchar* destination = backgroundRow + x * 4;
+            uchar* result = compositeRow + x * 4;
+            const int inverse = 255 - source[3];
+            for( int channel = 0; channel < 4; channel++ ){
+                const int value = destination[channel] * inverse + 128;
+                result[channel] = cv::saturate_cast<uchar>( source[channel] + ( ( value + ( value >> 8 ) ) >> 8 ) );
+            }
+        }
+    }
+}
\ No newline at end of file
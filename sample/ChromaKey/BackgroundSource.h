@@ -0,0 +1,76 @@
+#ifndef __BACKGROUND_SOURCE__
+#define __BACKGROUND_SOURCE__
+
+#include <opencv2/opencv.hpp>
+
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <atomic>
+
+// Prefetching Background Source
+// Still image, image sequence ( e.g. "background%04d.png" ) or video is decoded, resized and converted to BGRA on worker thread.
+// Frames are double-buffered, so that the keying thread only swaps buffers and never waits for decoding.
+// Video and image sequence are paced by frame rate of source ( 30 [fps] if unknown ).
+class BackgroundSource
+{
+private:
+    // Source
+    std::string path;
+    cv::VideoCapture capture;
+    cv::Mat still;
+
+    // Double Buffer ( front is owned by keying thread, back is owned by worker thread while ready is false )
+    cv::Mat front;
+    cv::Mat back;
+    bool ready;
+
+    // Requested Size and Size of Last Produced Frame
+    cv::Size size;
+    cv::Size producedSize;
+
+    // Worker Thread
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::atomic<bool> running;
+
+public:
+    // Constructor
+    BackgroundSource();
+
+    // Destructor
+    ~BackgroundSource();
+
+    // Open Source and Start Worker Thread
+    bool open( const std::string& path );
+
+    // Stop Worker Thread and Close Source
+    void close();
+
+    // Check Open
+    bool isOpened() const
+    {
+        return running;
+    }
+
+    // Request Size of Frames
+    void resize( const cv::Size& size );
+
+    // Retrieve Latest Prefetched Frame ( BGRA, may be empty or old size until worker catches up )
+    const cv::Mat& acquire();
+
+private:
+    // Worker Thread
+    void worker();
+
+    // Decode Next Frame ( loop to first frame at end of sequence or video )
+    bool decode( cv::Mat& frame );
+};
+
+// Alpha Blending ( premultiplied BGRA foreground over BGRA background )
+void alphaBlend( const cv::Mat& foreground, const cv::Mat& background, cv::Mat& composite );
+
+#endif // __BACKGROUND_SOURCE__
\ No newline at end of file
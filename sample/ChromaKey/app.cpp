@@ -3,18 +3,29 @@
 
 #include <thread>
 #include <chrono>
+#include <iostream>
+#include <algorithm>
 
 #include <omp.h>
 
-// Choose Resolution
-#define COLOR
-//#define DEPTH
+// Benchmark ChromaKey ( compare separated passes with selected kernel )
+//#define BENCHMARK
+
+// Size of Cell of Registration Table [px] and Depth Difference at Edge of Surface [mm] ( ChromaKey_Refined )
+static const int REGISTRATION = 4;
+static const float DEPTH_EDGE = 100.0f;
 
 // Constructor
-Kinect::Kinect()
+Kinect::Kinect( const ChromaKeyResolution resolution, const std::string& background )
+    : chromaKeyResolution( resolution )
 {
     // Initialize
     initialize();
+
+    // Open Background Source
+    if( !background.empty() && !backgroundSource.open( background ) ){
+        throw std::runtime_error( "failed BackgroundSource::open( " + background + " )" );
+    }
 }
 
 // Destructor
@@ -43,6 +54,22 @@ void Kinect::run()
         if( key == VK_ESCAPE ){
             break;
         }
+        else if( key == '1' ){
+            std::cout << "Switch Resolution to 1920x1080" << std::endl;
+            selectChromaKey( ChromaKeyResolution::ChromaKey_Color );
+        }
+        else if( key == '2' ){
+            std::cout << "Switch Resolution to 960x540" << std::endl;
+            selectChromaKey( ChromaKeyResolution::ChromaKey_Half );
+        }
+        else if( key == '3' ){
+            std::cout << "Switch Resolution to 512x424" << std::endl;
+            selectChromaKey( ChromaKeyResolution::ChromaKey_Depth );
+        }
+        else if( key == '4' ){
+            std::cout << "Switch Resolution to 1920x1080 ( refined at 512x424 )" << std::endl;
+            selectChromaKey( ChromaKeyResolution::ChromaKey_Refined );
+        }
     }
 }
 
@@ -63,6 +90,9 @@ void Kinect::initialize()
     // Initialize BodyIndex
     initializeBodyIndex();
 
+    // Select ChromaKey Kernel
+    selectChromaKey( chromaKeyResolution );
+
     // Wait a Few Seconds until begins to Retrieve Data from Sensor ( about 2000-[ms] )
     std::this_thread::sleep_for( std::chrono::seconds( 2 ) );
 }
@@ -207,69 +237,404 @@ inline void Kinect::updateBodyIndex()
 
     // Retrieve BodyIndex Data
     ERROR_CHECK( bodyIndexFrame->CopyFrameDataToArray( static_cast<UINT>( bodyIndexBuffer.size() ), &bodyIndexBuffer[0] ) );
+
+    // Encode BodyIndex Mask ( Run-Length )
+    bodyIndexMask.encode( &bodyIndexBuffer[0], bodyIndexWidth, bodyIndexHeight );
 }
 
 // Draw Data
 void Kinect::draw()
 {
-    // Draw Color
-    drawColor();
+#ifdef BENCHMARK
+    // Benchmark ChromaKey
+    benchmarkChromaKey();
+#else
+    // Draw ChromaKey
+    ( this->*drawChromaKeyKernel )();
+#endif
 
-    // Draw BodyIndex
-    drawBodyIndex();
+    // Draw Composite
+    drawComposite();
+}
 
-    // Draw ChromaKey
-    drawChromaKey();
+// Draw ChromaKey in Color Space ( 1/scale of color resolution )
+template<int scale>
+inline void Kinect::drawChromaKeyColorSpace()
+{
+    // Allocation ChromaKey Buffer ( reallocated only when size is changed )
+    const int width = colorWidth / scale;
+    const int height = colorHeight / scale;
+    chromaKeyMat.create( height, width, CV_8UC4 );
+
+    // Skip Mapping while Nobody is in View
+    if( bodyIndexMask.empty() ){
+        chromaKeyMat.setTo( cv::Scalar::all( 0 ) );
+        return;
+    }
+
+    // Retrieve Mapped Coordinates
+    ERROR_CHECK( coordinateMapper->MapColorFrameToDepthSpace( static_cast<UINT>( depthBuffer.size() ), &depthBuffer[0], static_cast<UINT>( depthSpacePoints.size() ), &depthSpacePoints[0] ) );
+
+    // Mapping, BodyIndex Lookup, Color Copy and Downscale in One Traversal
+    #pragma omp parallel for
+    for( int y = 0; y < height; y++ ){
+        const int colorY = y * scale;
+        const DepthSpacePoint* points = &depthSpacePoints[colorY * colorWidth];
+        const UINT32* colorRow = reinterpret_cast<const UINT32*>( &colorBuffer[colorY * colorWidth * colorBytesPerPixel] );
+        UINT32* chromaKeyRow = chromaKeyMat.ptr<UINT32>( y );
+        for( int x = 0; x < width; x++ ){
+            const int colorX = x * scale;
+            const DepthSpacePoint& point = points[colorX];
+
+            // Invalid Points are Mapped to -Infinity
+            UINT32 pixel = 0;
+            if( ( 0.0f <= point.X ) && ( 0.0f <= point.Y ) ){
+                const int bodyIndexX = static_cast<int>( point.X + 0.5f );
+                const int bodyIndexY = static_cast<int>( point.Y + 0.5f );
+                if( ( bodyIndexX < bodyIndexWidth ) && ( bodyIndexY < bodyIndexHeight ) && ( bodyIndexBuffer[bodyIndexY * bodyIndexWidth + bodyIndexX] != 0xff ) ){
+                    pixel = colorRow[colorX] | 0xff000000; // Opaque
+                }
+            }
+            chromaKeyRow[x] = pixel;
+        }
+    }
 }
 
-// Draw Color
-inline void Kinect::drawColor()
+// Draw ChromaKey ( 1920x1080 )
+template<>
+void Kinect::drawChromaKey<ChromaKeyResolution::ChromaKey_Color>()
 {
-#ifdef COLOR
-    // Create cv::Mat from Color Buffer
-    colorMat = cv::Mat( colorHeight, colorWidth, CV_8UC4, &colorBuffer[0] );
-#endif
+    drawChromaKeyColorSpace<1>();
+}
+
+// Draw ChromaKey ( 960x540 )
+// Color pixels are point sampled at every second pixel, while separated passes resized with cv::resize() ( INTER_LINEAR ),
+// so edges of this output are slightly sharper ( and may alias ) compared with previous implementation.
+template<>
+void Kinect::drawChromaKey<ChromaKeyResolution::ChromaKey_Half>()
+{
+    drawChromaKeyColorSpace<2>();
+}
+
+// Draw ChromaKey ( 512x424 )
+template<>
+void Kinect::drawChromaKey<ChromaKeyResolution::ChromaKey_Depth>()
+{
+    // Allocation ChromaKey Buffer ( reallocated only when size is changed )
+    chromaKeyMat.create( depthHeight, depthWidth, CV_8UC4 );
+
+    // Skip Mapping while Nobody is in View
+    if( bodyIndexMask.empty() ){
+        chromaKeyMat.setTo( cv::Scalar::all( 0 ) );
+        return;
+    }
 
-#ifdef DEPTH
     // Retrieve Mapped Coordinates
-    std::vector<ColorSpacePoint> colorSpacePoints( depthWidth * depthHeight );
-    ERROR_CHECK( coordinateMapper->MapDepthFrameToColorSpace( depthBuffer.size(), &depthBuffer[0], colorSpacePoints.size(), &colorSpacePoints[0] ) );
+    ERROR_CHECK( coordinateMapper->MapDepthFrameToColorSpace( static_cast<UINT>( depthBuffer.size() ), &depthBuffer[0], static_cast<UINT>( colorSpacePoints.size() ), &colorSpacePoints[0] ) );
 
-    // Mapping Color to Depth Resolution
-    std::vector<BYTE> buffer( depthWidth * depthHeight * colorBytesPerPixel );
+    // BodyIndex Lookup, Mapping and Color Copy in One Traversal
+    const UINT32* colors = reinterpret_cast<const UINT32*>( &colorBuffer[0] );
 
     #pragma omp parallel for
-    for( int depthY = 0; depthY < depthHeight; depthY++ ){
-        unsigned int depthOffset = depthY * depthWidth;
-        for( int depthX = 0; depthX < depthWidth; depthX++ ){
-            unsigned int depthIndex = depthOffset + depthX;
-            int colorX = static_cast<int>( colorSpacePoints[depthIndex].X + 0.5f );
-            int colorY = static_cast<int>( colorSpacePoints[depthIndex].Y + 0.5f );
-            if( ( 0 <= colorX ) && ( colorX < colorWidth ) && ( 0 <= colorY ) && ( colorY < colorHeight ) ){
-                unsigned int colorIndex = ( colorY * colorWidth + colorX ) * colorBytesPerPixel;
-                depthIndex = depthIndex * colorBytesPerPixel;
-                buffer[depthIndex + 0] = colorBuffer[colorIndex + 0];
-                buffer[depthIndex + 1] = colorBuffer[colorIndex + 1];
-                buffer[depthIndex + 2] = colorBuffer[colorIndex + 2];
-                buffer[depthIndex + 3] = colorBuffer[colorIndex + 3];
+    for( int y = 0; y < depthHeight; y++ ){
+        const unsigned int depthOffset = y * depthWidth;
+        UINT32* chromaKeyRow = chromaKeyMat.ptr<UINT32>( y );
+        for( int x = 0; x < depthWidth; x++ ){
+            // Background Pixels do not need Mapped Coordinates
+            UINT32 pixel = 0;
+            if( bodyIndexBuffer[depthOffset + x] != 0xff ){
+                const ColorSpacePoint& point = colorSpacePoints[depthOffset + x];
+                if( ( 0.0f <= point.X ) && ( 0.0f <= point.Y ) ){
+                    const int colorX = static_cast<int>( point.X + 0.5f );
+                    const int colorY = static_cast<int>( point.Y + 0.5f );
+                    if( ( colorX < colorWidth ) && ( colorY < colorHeight ) ){
+                        pixel = colors[colorY * colorWidth + colorX] | 0xff000000; // Opaque
+                    }
+                }
             }
+            chromaKeyRow[x] = pixel;
         }
     }
+}
 
-    // Create cv::Mat from Coordinate Buffer
-    colorMat = cv::Mat( depthHeight, depthWidth, CV_8UC4, &buffer[0] ).clone();
-#endif
+// Draw ChromaKey ( 1920x1080, refined at 512x424 )
+// The mask is cleaned with morphology and a guided filter at depth resolution, then the linear coefficients of the guided filter are
+// upsampled and applied to color resolution guide, so that edges of the alpha matte follow edges of the color image.
+// Color pixels are registered to depth pixels by the table of REGISTRATION x REGISTRATION cells built from mapped coordinates of depth pixels,
+// so that each body is registered at own depth ( parallax is different for bodies at different distances ).
+template<>
+void Kinect::drawChromaKey<ChromaKeyResolution::ChromaKey_Refined>()
+{
+    // Allocation ChromaKey Buffer ( reallocated only when size is changed )
+    chromaKeyMat.create( colorHeight, colorWidth, CV_8UC4 );
+    alphaMat.create( colorHeight, colorWidth, CV_8UC1 );
+
+    // Skip Mapping while Nobody is in View
+    if( bodyIndexMask.empty() ){
+        chromaKeyMat.setTo( cv::Scalar::all( 0 ) );
+        alphaMat.setTo( cv::Scalar::all( 0 ) );
+        return;
+    }
+
+    // Retrieve Mapped Coordinates ( depth resolution only )
+    ERROR_CHECK( coordinateMapper->MapDepthFrameToColorSpace( static_cast<UINT>( depthBuffer.size() ), &depthBuffer[0], static_cast<UINT>( colorSpacePoints.size() ), &colorSpacePoints[0] ) );
+
+    // Build Mask and Guide at Depth Resolution
+    lowAlphaMat.create( depthHeight, depthWidth, CV_32FC1 );
+    lowGuideMat.create( depthHeight, depthWidth, CV_32FC1 );
+
+    #pragma omp parallel for
+    for( int y = 0; y < depthHeight; y++ ){
+        const unsigned int depthOffset = y * depthWidth;
+        float* alphaRow = lowAlphaMat.ptr<float>( y );
+        float* guideRow = lowGuideMat.ptr<float>( y );
+        for( int x = 0; x < depthWidth; x++ ){
+            const ColorSpacePoint& point = colorSpacePoints[depthOffset + x];
+            const bool body = ( bodyIndexBuffer[depthOffset + x] != 0xff );
+
+            float guide = 0.0f;
+            if( ( 0.0f <= point.X ) && ( 0.0f <= point.Y ) ){
+                const int colorX = static_cast<int>( point.X + 0.5f );
+                const int colorY = static_cast<int>( point.Y + 0.5f );
+                if( ( colorX < colorWidth ) && ( colorY < colorHeight ) ){
+                    const BYTE* pixel = &colorBuffer[( colorY * colorWidth + colorX ) * colorBytesPerPixel];
+                    guide = ( pixel[0] + pixel[1] + pixel[2] ) * ( 1.0f / ( 3.0f * 255.0f ) );
+                }
+            }
+
+            alphaRow[x] = body ? 1.0f : 0.0f;
+            guideRow[x] = guide;
+        }
+    }
+
+    // Registration Table ( nearest depth pixel mapped into each cell wins, so that foreground occludes background )
+    // This scatter is left serial, depth pixels of different rows are mapped into same cell ( write conflicts ), and it visits only depth resolution.
+    const int registrationWidth = colorWidth / REGISTRATION;
+    const int registrationHeight = colorHeight / REGISTRATION;
+    registrationMat.create( registrationHeight, registrationWidth, CV_32FC3 );
+    registrationMat.setTo( cv::Scalar::all( 0 ) );
+    for( int y = 0; y < depthHeight; y++ ){
+        const unsigned int depthOffset = y * depthWidth;
+        for( int x = 0; x < depthWidth; x++ ){
+            const float depth = depthBuffer[depthOffset + x];
+            const ColorSpacePoint& point = colorSpacePoints[depthOffset + x];
+            if( ( depth == 0.0f ) || !( 0.0f <= point.X ) || !( 0.0f <= point.Y ) ){
+                continue;
+            }
+
+            const int cellX = static_cast<int>( point.X ) / REGISTRATION;
+            const int cellY = static_cast<int>( point.Y ) / REGISTRATION;
+            if( ( cellX >= registrationWidth ) || ( cellY >= registrationHeight ) ){
+                continue;
+            }
+
+            cv::Vec3f& cell = registrationMat.at<cv::Vec3f>( cellY, cellX );
+            if( ( cell[2] == 0.0f ) || ( depth < cell[2] ) ){
+                cell = cv::Vec3f( static_cast<float>( x ), static_cast<float>( y ), depth );
+            }
+        }
+    }
+
+    // Fill Holes of Registration Table by Farthest Neighbor ( color pixels that depth camera can not see are occluded background )
+    // Each pass reads neighbors from the table of previous pass, so that result does not depend on traversal order.
+    for( int pass = 0; pass < 2; pass++ ){
+        registrationMat.copyTo( previousRegistrationMat );
+
+        #pragma omp parallel for
+        for( int y = 0; y < registrationHeight; y++ ){
+            const cv::Vec3f* previousRow = previousRegistrationMat.ptr<cv::Vec3f>( y );
+            cv::Vec3f* row = registrationMat.ptr<cv::Vec3f>( y );
+            for( int x = 0; x < registrationWidth; x++ ){
+                if( previousRow[x][2] != 0.0f ){
+                    continue;
+                }
+
+                const cv::Vec3f* neighbors[4] = {
+                    ( x > 0 ) ? &previousRow[x - 1] : nullptr,
+                    ( x < registrationWidth - 1 ) ? &previousRow[x + 1] : nullptr,
+                    ( y > 0 ) ? &previousRegistrationMat.at<cv::Vec3f>( y - 1, x ) : nullptr,
+                    ( y < registrationHeight - 1 ) ? &previousRegistrationMat.at<cv::Vec3f>( y + 1, x ) : nullptr
+                };
+                for( const cv::Vec3f* neighbor : neighbors ){
+                    if( neighbor != nullptr && ( *neighbor )[2] > row[x][2] ){
+                        row[x] = *neighbor;
+                    }
+                }
+            }
+        }
+    }
+
+    // Morphology ( remove speckles, then fill holes )
+    static const cv::Mat openKernel = cv::getStructuringElement( cv::MORPH_ELLIPSE, cv::Size( 3, 3 ) );
+    static const cv::Mat closeKernel = cv::getStructuringElement( cv::MORPH_ELLIPSE, cv::Size( 7, 7 ) );
+    cv::morphologyEx( lowAlphaMat, lowAlphaMat, cv::MORPH_OPEN, openKernel );
+    cv::morphologyEx( lowAlphaMat, lowAlphaMat, cv::MORPH_CLOSE, closeKernel );
+
+    // Guided Filter Coefficients ( alpha = a * guide + b )
+    const int radius = 4;
+    const float epsilon = 1e-3f;
+    const cv::Size window( 2 * radius + 1, 2 * radius + 1 );
+    cv::Mat meanI, meanP, correlationII, correlationIP;
+    cv::boxFilter( lowGuideMat, meanI, CV_32F, window );
+    cv::boxFilter( lowAlphaMat, meanP, CV_32F, window );
+    cv::boxFilter( lowGuideMat.mul( lowGuideMat ), correlationII, CV_32F, window );
+    cv::boxFilter( lowGuideMat.mul( lowAlphaMat ), correlationIP, CV_32F, window );
+    const cv::Mat varianceI = correlationII - meanI.mul( meanI );
+    const cv::Mat covarianceIP = correlationIP - meanI.mul( meanP );
+    const cv::Mat coefficientA = covarianceIP / ( varianceI + epsilon );
+    const cv::Mat coefficientB = meanP - coefficientA.mul( meanI );
+    cv::boxFilter( coefficientA, coefficientAMat, CV_32F, window );
+    cv::boxFilter( coefficientB, coefficientBMat, CV_32F, window );
+
+    // Edge-Aware Upsampling and Compositing in One Traversal
+    #pragma omp parallel for
+    for( int y = 0; y < colorHeight; y++ ){
+        // Rows of Registration Table around Pixel Centers of Row
+        const float cellY = std::min( std::max( ( y + 0.5f ) / REGISTRATION - 0.5f, 0.0f ), registrationHeight - 1.001f );
+        const int cellY0 = static_cast<int>( cellY );
+        const float cellWeightY = cellY - cellY0;
+        const cv::Vec3f* cells0 = registrationMat.ptr<cv::Vec3f>( cellY0 );
+        const cv::Vec3f* cells1 = registrationMat.ptr<cv::Vec3f>( cellY0 + 1 );
+
+        const BYTE* colorRow = &colorBuffer[y * colorWidth * colorBytesPerPixel];
+        BYTE* chromaKeyRow = chromaKeyMat.ptr<BYTE>( y );
+        BYTE* alphaRow = alphaMat.ptr<BYTE>( y );
+        for( int x = 0; x < colorWidth; x++ ){
+            const float cellX = std::min( std::max( ( x + 0.5f ) / REGISTRATION - 0.5f, 0.0f ), registrationWidth - 1.001f );
+            const int cellX0 = static_cast<int>( cellX );
+            const float cellWeightX = cellX - cellX0;
+            const cv::Vec3f& c00 = cells0[cellX0];
+            const cv::Vec3f& c01 = cells0[cellX0 + 1];
+            const cv::Vec3f& c10 = cells1[cellX0];
+            const cv::Vec3f& c11 = cells1[cellX0 + 1];
+
+            // Position at Depth Resolution ( interpolated inside same surface, nearest cell across depth edge or hole )
+            const float nearest = std::min( std::min( c00[2], c01[2] ), std::min( c10[2], c11[2] ) );
+            const float farthest = std::max( std::max( c00[2], c01[2] ), std::max( c10[2], c11[2] ) );
+            float depthX, depthY;
+            if( ( nearest > 0.0f ) && ( farthest - nearest < DEPTH_EDGE ) ){
+                depthX = ( c00[0] + ( c01[0] - c00[0] ) * cellWeightX ) * ( 1.0f - cellWeightY ) + ( c10[0] + ( c11[0] - c10[0] ) * cellWeightX ) * cellWeightY;
+                depthY = ( c00[1] + ( c01[1] - c00[1] ) * cellWeightX ) * ( 1.0f - cellWeightY ) + ( c10[1] + ( c11[1] - c10[1] ) * cellWeightX ) * cellWeightY;
+            }
+            else{
+                // Farthest cell is used if nearest cell is hole
+                const cv::Vec3f* cells[4] = { &c00, &c01, &c10, &c11 };
+                const cv::Vec3f* cell = cells[( ( cellWeightY < 0.5f ) ? 0 : 2 ) + ( ( cellWeightX < 0.5f ) ? 0 : 1 )];
+                if( ( *cell )[2] == 0.0f ){
+                    for( const cv::Vec3f* candidate : cells ){
+                        cell = ( ( *candidate )[2] > ( *cell )[2] ) ? candidate : cell;
+                    }
+                }
+                depthX = ( *cell )[0];
+                depthY = ( *cell )[1];
+            }
+
+            // Color Pixel outside of Depth Camera is Transparent
+            BYTE* output = chromaKeyRow + x * 4;
+            const BYTE* pixel = colorRow + x * 4;
+            if( farthest == 0.0f ){
+                alphaRow[x] = 0;
+                *reinterpret_cast<UINT32*>( output ) = 0;
+                continue;
+            }
+
+            // Guided Filter Coefficients at Position ( bilinear )
+            depthX = std::min( depthX, depthWidth - 1.001f );
+            depthY = std::min( depthY, depthHeight - 1.001f );
+            const int x0 = static_cast<int>( depthX );
+            const int y0 = static_cast<int>( depthY );
+            const float weightX = depthX - x0;
+            const float weightY = depthY - y0;
+            const float* a0 = coefficientAMat.ptr<float>( y0 );
+            const float* a1 = coefficientAMat.ptr<float>( y0 + 1 );
+            const float* b0 = coefficientBMat.ptr<float>( y0 );
+            const float* b1 = coefficientBMat.ptr<float>( y0 + 1 );
+            const float a = ( a0[x0] + ( a0[x0 + 1] - a0[x0] ) * weightX ) * ( 1.0f - weightY ) + ( a1[x0] + ( a1[x0 + 1] - a1[x0] ) * weightX ) * weightY;
+            const float b = ( b0[x0] + ( b0[x0 + 1] - b0[x0] ) * weightX ) * ( 1.0f - weightY ) + ( b1[x0] + ( b1[x0 + 1] - b1[x0] ) * weightX ) * weightY;
+
+            const float guide = ( pixel[0] + pixel[1] + pixel[2] ) * ( 1.0f / ( 3.0f * 255.0f ) );
+            const float alpha = std::min( std::max( a * guide + b, 0.0f ), 1.0f );
+            const int alpha8 = static_cast<int>( alpha * 255.0f + 0.5f );
+
+            alphaRow[x] = static_cast<BYTE>( alpha8 );
+            output[0] = static_cast<BYTE>( ( pixel[0] * alpha8 + 127 ) / 255 );
+            output[1] = static_cast<BYTE>( ( pixel[1] * alpha8 + 127 ) / 255 );
+            output[2] = static_cast<BYTE>( ( pixel[2] * alpha8 + 127 ) / 255 );
+            output[3] = static_cast<BYTE>( alpha8 );
+        }
+    }
 }
 
-// Draw BodyIndex
-inline void Kinect::drawBodyIndex()
+// Draw Composite
+inline void Kinect::drawComposite()
 {
-#ifdef COLOR
-    // Retrieve Mapped Coordinates
+    if( !backgroundSource.isOpened() || chromaKeyMat.empty() ){
+        return;
+    }
+
+    // Request Background of Same Size as ChromaKey ( resized on worker thread )
+    backgroundSource.resize( chromaKeyMat.size() );
+
+    // Retrieve Prefetched Background ( composite onto black until first frame of this size is ready )
+    const cv::Mat& backgroundMat = backgroundSource.acquire();
+    if( backgroundMat.size() != chromaKeyMat.size() ){
+        chromaKeyMat.copyTo( compositeMat );
+        return;
+    }
+
+    // Alpha Blending ( ChromaKey is premultiplied by alpha )
+    alphaBlend( chromaKeyMat, backgroundMat, compositeMat );
+}
+
+// Select ChromaKey Kernel
+void Kinect::selectChromaKey( const ChromaKeyResolution resolution )
+{
+    chromaKeyResolution = resolution;
+
+    // Reset Benchmark Accumulators ( average is not mixed across kernels )
+    separatedTime = 0.0;
+    fusedTime = 0.0;
+    benchmarkFrames = 0;
+
+    // Select Kernel and Allocation Mapped Coordinates Buffer ( reused every frame, buffer of other direction is released )
+    switch( resolution ){
+        case ChromaKeyResolution::ChromaKey_Color:
+            drawChromaKeyKernel = &Kinect::drawChromaKey<ChromaKeyResolution::ChromaKey_Color>;
+            depthSpacePoints.resize( colorWidth * colorHeight );
+            std::vector<ColorSpacePoint>().swap( colorSpacePoints );
+            break;
+        case ChromaKeyResolution::ChromaKey_Half:
+            drawChromaKeyKernel = &Kinect::drawChromaKey<ChromaKeyResolution::ChromaKey_Half>;
+            depthSpacePoints.resize( colorWidth * colorHeight );
+            std::vector<ColorSpacePoint>().swap( colorSpacePoints );
+            break;
+        case ChromaKeyResolution::ChromaKey_Depth:
+            drawChromaKeyKernel = &Kinect::drawChromaKey<ChromaKeyResolution::ChromaKey_Depth>;
+            colorSpacePoints.resize( depthWidth * depthHeight );
+            std::vector<DepthSpacePoint>().swap( depthSpacePoints );
+            break;
+        case ChromaKeyResolution::ChromaKey_Refined:
+            drawChromaKeyKernel = &Kinect::drawChromaKey<ChromaKeyResolution::ChromaKey_Refined>;
+            colorSpacePoints.resize( depthWidth * depthHeight );
+            std::vector<DepthSpacePoint>().swap( depthSpacePoints );
+            break;
+        default:
+            throw std::runtime_error( "failed Kinect::selectChromaKey( resolution )" );
+    }
+}
+
+#ifdef BENCHMARK
+// Number of Full Resolution Passes of Separated Implementation ( Pass 1-7 of drawChromaKeySeparated() )
+static const int SEPARATED_PASSES = 7;
+
+// Draw ChromaKey with Separated Passes ( previous implementation, for comparison )
+inline void Kinect::drawChromaKeySeparated( cv::Mat& resizeMat )
+{
+    // Pass 1 : Retrieve Mapped Coordinates
     std::vector<DepthSpacePoint> bodyIndexSpacePoints( colorWidth * colorHeight );
     ERROR_CHECK( coordinateMapper->MapColorFrameToDepthSpace( depthBuffer.size(), &depthBuffer[0], bodyIndexSpacePoints.size(), &bodyIndexSpacePoints[0] ) );
 
-    // Mapping BodyIndex to Color Resolution
+    // Pass 2-4 : Mapping BodyIndex to Color Resolution ( fill, mapping, clone )
     std::vector<BYTE> buffer( colorWidth * colorHeight, 0xff );
 
     #pragma omp parallel for
@@ -286,41 +651,65 @@ inline void Kinect::drawBodyIndex()
         }
     }
 
-    // Create cv::Mat from Coordinate Buffer
-    bodyIndexMat = cv::Mat( colorHeight, colorWidth, CV_8UC1, &buffer[0] ).clone();
-#endif
+    cv::Mat bodyIndexMat = cv::Mat( colorHeight, colorWidth, CV_8UC1, &buffer[0] ).clone();
 
-#ifdef DEPTH
-    // Create cv::Mat from BodyIndex Buffer
-    bodyIndexMat = cv::Mat( bodyIndexHeight, bodyIndexWidth, CV_8UC1, &bodyIndexBuffer[0] );
-#endif
+    // Pass 5-6 : ChromaKey ( zero fill, copy )
+    cv::Mat colorMat = cv::Mat( colorHeight, colorWidth, CV_8UC4, &colorBuffer[0] );
+    cv::Mat chromaKeyMat = cv::Mat::zeros( colorHeight, colorWidth, CV_8UC4 );
+    chromaKeyMat.forEach<cv::Vec4b>( [ & ]( cv::Vec4b &p, const int* position ){
+        uchar bodyIndex = bodyIndexMat.at<uchar>( position[0], position[1] );
+        if( bodyIndex != 0xff ){
+            p = colorMat.at<cv::Vec4b>( position[0], position[1] );
+        }
+    } );
+
+    // Pass 7 : Resize Image
+    cv::resize( chromaKeyMat, resizeMat, this->chromaKeyMat.size() );
 }
 
-// Draw ChromaKey
-inline void Kinect::drawChromaKey()
+// Benchmark ChromaKey
+inline void Kinect::benchmarkChromaKey()
 {
-    if( colorMat.empty() ){
+    // Name and Number of Full Resolution ( 1920x1080 ) Passes of Selected Kernel ( same order as ChromaKeyResolution )
+    // Color : mapping, fused traversal / Half : mapping, fused traversal ( every second pixel ) / Depth : none / Refined : upsampling and compositing
+    static const char* const names[] = { "Color", "Half", "Depth", "Refined" };
+    static const int passes[] = { 2, 2, 0, 1 };
+
+    // Fused Pass
+    auto start = std::chrono::high_resolution_clock::now();
+    ( this->*drawChromaKeyKernel )();
+    auto end = std::chrono::high_resolution_clock::now();
+    fusedTime += std::chrono::duration<double, std::milli>( end - start ).count();
+
+    // Separated Passes only exist for Color Space Output ( print fused pass only )
+    if( chromaKeyResolution == ChromaKeyResolution::ChromaKey_Depth ){
+        if( ++benchmarkFrames == 100 ){
+            std::cout << names[chromaKeyResolution] << " " << chromaKeyMat.cols << "x" << chromaKeyMat.rows << " "
+                      << "selected : " << passes[chromaKeyResolution] << " full resolution passes " << fusedTime / benchmarkFrames << " [ms/frame]" << std::endl;
+            fusedTime = 0.0;
+            benchmarkFrames = 0;
+        }
         return;
     }
 
-    if( bodyIndexMat.empty() ){
-        return;
+    // Separated Passes
+    cv::Mat separatedMat;
+    start = std::chrono::high_resolution_clock::now();
+    drawChromaKeySeparated( separatedMat );
+    end = std::chrono::high_resolution_clock::now();
+    separatedTime += std::chrono::duration<double, std::milli>( end - start ).count();
+
+    // Print Average every 100 Frames
+    if( ++benchmarkFrames == 100 ){
+        std::cout << names[chromaKeyResolution] << " " << chromaKeyMat.cols << "x" << chromaKeyMat.rows << " "
+                  << "separated : " << SEPARATED_PASSES << " full resolution passes " << separatedTime / benchmarkFrames << " [ms/frame], "
+                  << "selected : " << passes[chromaKeyResolution] << " full resolution passes " << fusedTime / benchmarkFrames << " [ms/frame]" << std::endl;
+        separatedTime = 0.0;
+        fusedTime = 0.0;
+        benchmarkFrames = 0;
     }
-
-    // ChromaKey
-#ifdef COLOR
-    chromaKeyMat = cv::Mat::zeros( colorHeight, colorWidth, CV_8UC4 );
-#endif
-#ifdef DEPTH
-    chromaKeyMat = cv::Mat::zeros( depthHeight, depthWidth, CV_8UC4 );
-#endif
-    chromaKeyMat.forEach<cv::Vec4b>( [ & ]( cv::Vec4b &p, const int* position ){
-        uchar bodyIndex = bodyIndexMat.at<uchar>( position[0], position[1] );
-        if( bodyIndex != 0xff ){
-            p = colorMat.at<cv::Vec4b>( position[0], position[1] );
-        }
-    } );
 }
+#endif
 
 // Show Data
 void Kinect::show()
@@ -336,18 +725,11 @@ inline void Kinect::showChromaKey()
         return;
     }
 
-#ifdef COLOR
-    // Resize Image
-    cv::Mat resizeMat;
-    const double scale = 0.5;
-    cv::resize( chromaKeyMat, resizeMat, cv::Size(), scale, scale );
-
-    // Show Image
-    cv::imshow( "ChromaKey", resizeMat );
-#endif
-
-#ifdef DEPTH
-    // Show Image
-    cv::imshow( "ChromaKey", chromaKeyMat );
-#endif
+    // Show Image ( already scaled to display resolution )
+    if( backgroundSource.isOpened() && !compositeMat.empty() ){
+        cv::imshow( "ChromaKey", compositeMat );
+    }
+    else{
+        cv::imshow( "ChromaKey", chromaKeyMat );
+    }
 }
\ No newline at end of file
@@ -4,12 +4,24 @@
 #include <Windows.h>
 #include <Kinect.h>
 #include <opencv2/opencv.hpp>
+#include "BodyIndexMask.h"
+#include "BackgroundSource.h"
 
 #include <vector>
+#include <string>
 
 #include <wrl/client.h>
 using namespace Microsoft::WRL;
 
+// ChromaKey Resolution
+enum ChromaKeyResolution
+{
+    ChromaKey_Color, // 1920x1080
+    ChromaKey_Half,  // 960x540
+    ChromaKey_Depth, // 512x424
+    ChromaKey_Refined // 1920x1080 ( refined at 512x424, edge-aware upsampling )
+};
+
 class Kinect
 {
 private:
@@ -29,7 +41,6 @@ private:
     int colorWidth;
     int colorHeight;
     unsigned int colorBytesPerPixel;
-    cv::Mat colorMat;
 
     // Depth Buffer
     std::vector<UINT16> depthBuffer;
@@ -42,14 +53,38 @@ private:
     int bodyIndexWidth;
     int bodyIndexHeight;
     unsigned int bodyIndexBytesPerPixel;
-    cv::Mat bodyIndexMat;
+    BodyIndexMask bodyIndexMask;
+
+    // Mapped Coordinates Buffer
+    std::vector<DepthSpacePoint> depthSpacePoints;
+    std::vector<ColorSpacePoint> colorSpacePoints;
 
     // ChromaKey Buffer
     cv::Mat chromaKeyMat;
+    ChromaKeyResolution chromaKeyResolution;
+    void ( Kinect::*drawChromaKeyKernel )();
+
+    // Refinement Buffer
+    cv::Mat alphaMat;
+    cv::Mat lowAlphaMat;
+    cv::Mat lowGuideMat;
+    cv::Mat coefficientAMat;
+    cv::Mat coefficientBMat;
+    cv::Mat registrationMat; // Depth X, Y and depth [mm] of cells of color image ( depth is 0 if no depth pixel is mapped )
+    cv::Mat previousRegistrationMat; // Registration table of previous pass of hole filling ( read only while filling )
+
+    // Background Buffer
+    BackgroundSource backgroundSource;
+    cv::Mat compositeMat;
+
+    // Benchmark Accumulators ( reset when kernel is selected )
+    double separatedTime = 0.0; // [ms]
+    double fusedTime = 0.0;     // [ms]
+    int benchmarkFrames = 0;
 
 public:
     // Constructor
-    Kinect();
+    Kinect( const ChromaKeyResolution resolution = ChromaKeyResolution::ChromaKey_Half, const std::string& background = "" );
 
     // Destructor
     ~Kinect();
@@ -91,14 +126,25 @@ private:
     // Draw Data
     void draw();
 
-    // Draw Color
-    inline void drawColor();
+    // Draw ChromaKey ( specialized for each resolution )
+    template<ChromaKeyResolution resolution>
+    void drawChromaKey();
+
+    // Draw ChromaKey in Color Space
+    template<int scale>
+    inline void drawChromaKeyColorSpace();
+
+    // Draw Composite
+    inline void drawComposite();
+
+    // Select ChromaKey Kernel
+    void selectChromaKey( const ChromaKeyResolution resolution );
 
-    // Draw BodyIndex
-    inline void drawBodyIndex();
+    // Draw ChromaKey with Separated Passes
+    inline void drawChromaKeySeparated( cv::Mat& resizeMat );
 
-    // Draw ChromaKey
-    inline void drawChromaKey();
+    // Benchmark ChromaKey
+    inline void benchmarkChromaKey();
 
     // Show Data
     void show();
@@ -1,12 +1,31 @@
 #include <iostream>
 #include <sstream>
+#include <string>
 
 #include "app.h"
 
 int main( int argc, char* argv[] )
 {
     try{
-        Kinect kinect;
+        // Choose Resolution ( color : 1920x1080, half : 960x540, depth : 512x424, refined : 1920x1080 refined at 512x424 )
+        ChromaKeyResolution resolution = ChromaKeyResolution::ChromaKey_Half;
+        if( argc > 1 ){
+            const std::string mode = argv[1];
+            if( mode == "color" ){
+                resolution = ChromaKeyResolution::ChromaKey_Color;
+            }
+            else if( mode == "depth" ){
+                resolution = ChromaKeyResolution::ChromaKey_Depth;
+            }
+            else if( mode == "refined" ){
+                resolution = ChromaKeyResolution::ChromaKey_Refined;
+            }
+        }
+
+        // Choose Background ( still image, image sequence or video, black if not specified )
+        const std::string background = ( argc > 2 ) ? argv[2] : "";
+
+        Kinect kinect( resolution, background );
         kinect.run();
     } catch( std::exception& ex ){
         std::cout << ex.what() << std::endl;
@@ -0,0 +1,88 @@
+#ifndef __COLOR_REGION_DECODER__
+#define __COLOR_REGION_DECODER__
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Color Region Decoder
+// Raw color frame ( YUY2 ) is converted to BGRA only inside requested regions ( e.g. faces ) at full resolution,
+// and whole frame is converted at low resolution as preview, instead of converting every pixel of full resolution.
+// Requested regions are clamped to image, aligned to pairs of pixels that share chroma, and merged while they overlap,
+// so that no pixel is converted twice. Pixels of full resolution image outside regions are not written.
+// Conversion is BT.601 limited range in fixed point ( same coefficients as Microsoft's 8-bit YUV to RGB888 conversion ).
+// This class has no dependency on Kinect SDK and OpenCV.
+class ColorRegionDecoder
+{
+public:
+    // Region in Image [px] ( right and bottom are exclusive )
+    struct Region
+    {
+        int left;
+        int top;
+        int right;
+        int bottom;
+    };
+
+private:
+    int width;
+    int height;
+    int factor;
+    std::vector<uint8_t> preview;
+    std::vector<Region> requests;
+    std::vector<Region> regions;
+    size_t pixels;
+
+public:
+    // Constructor
+    ColorRegionDecoder();
+
+    // Initialize ( size of color frame, downscale factor of preview is 2, 4 or 8, or 0 to skip preview )
+    void initialize( const int width, const int height, const int factor = 4 );
+
+    // Clear Requested Regions
+    void clear();
+
+    // Request Region ( regions of previous decode are kept until cleared )
+    void request( const int left, const int top, const int right, const int bottom );
+
+    // Decode Raw Frame ( YUY2, width * 2 bytes per row ) into Regions of Image ( BGRA, width * 4 bytes per row ) and Preview
+    void decode( const uint8_t* source, uint8_t* image );
+
+    // Check Rectangle is inside Decoded Regions
+    bool contains( const int left, const int top, const int right, const int bottom ) const;
+
+    // Retrieve Decoded Regions ( merged, no region overlaps or touches another )
+    const std::vector<Region>& getRegions() const
+    {
+        return regions;
+    }
+
+    // Retrieve Preview ( BGRA, width / factor * 4 bytes per row, nullptr if preview is skipped )
+    const uint8_t* getPreview() const
+    {
+        return preview.empty() ? nullptr : &preview[0];
+    }
+
+    int getPreviewWidth() const
+    {
+        return factor ? width / factor : 0;
+    }
+
+    int getPreviewHeight() const
+    {
+        return factor ? height / factor : 0;
+    }
+
+    // Retrieve Number of Pixels Converted by Last Decode ( regions and preview )
+    size_t getPixels() const
+    {
+        return pixels;
+    }
+
+private:
+    // Merge Requests into Regions
+    void merge();
+};
+
+#endif // __COLOR_REGION_DECODER__
\ No newline at end of file
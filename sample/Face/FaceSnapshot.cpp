@@ -0,0 +1,304 @@
+#include "FaceSnapshot.h"
+
+#include <cstring>
+#include <thread>
+
+// File Header ( magic, version, number of faces, points and properties )
+static const char MAGIC[4] = { 'F', 'A', 'C', 'S' };
+static const uint8_t VERSION = 2;
+
+// Size of Face Record ( trackingId, timestamp, points, box, quaternion, pose, properties )
+static const size_t FACE_BYTES = 8 + 8 + FaceSnapshot::POINTS * 2 * 4 + 4 * 4 + 4 * 4 + 3 * 4 + FaceSnapshot::PROPERTIES;
+
+// Write Integer ( little endian )
+static inline void writeInteger( std::vector<uint8_t>& buffer, const uint64_t value, const int bytes )
+{
+    for( int byte = 0; byte < bytes; byte++ ){
+        buffer.push_back( static_cast<uint8_t>( value >> ( byte * 8 ) ) );
+    }
+}
+
+// Write Float ( IEEE 754, little endian )
+static inline void writeFloat( std::vector<uint8_t>& buffer, const float value )
+{
+    uint32_t bits;
+    std::memcpy( &bits, &value, sizeof( bits ) );
+    writeInteger( buffer, bits, 4 );
+}
+
+// Read Integer ( little endian )
+static inline uint64_t readInteger( const uint8_t*& data, const int bytes )
+{
+    uint64_t value = 0;
+    for( int byte = 0; byte < bytes; byte++ ){
+        value |= static_cast<uint64_t>( *data++ ) << ( byte * 8 );
+    }
+    return value;
+}
+
+// Read Float ( IEEE 754, little endian )
+static inline float readFloat( const uint8_t*& data )
+{
+    const uint32_t bits = static_cast<uint32_t>( readInteger( data, 4 ) );
+    float value;
+    std::memcpy( &value, &bits, sizeof( value ) );
+    return value;
+}
+
+// Clear All Faces
+void FaceSnapshot::clear()
+{
+    std::memset( this, 0, sizeof( FaceSnapshot ) );
+}
+
+// Constructor
+FaceMailbox::FaceMailbox()
+    : back( 0 ),
+      front( 1 ),
+      middle( 2 )
+{
+    for( FaceSnapshot& buffer : buffers ){
+        buffer.clear();
+    }
+}
+
+// Publish Snapshot
+void FaceMailbox::publish( const FaceSnapshot& snapshot )
+{
+    // Fill Back Buffer, then Exchange it with Middle Buffer
+    buffers[back] = snapshot;
+    back = middle.exchange( back | FRESH, std::memory_order_acq_rel ) & INDEX;
+}
+
+// Receive Latest Snapshot
+bool FaceMailbox::receive( FaceSnapshot& snapshot )
+{
+    if( !( middle.load( std::memory_order_acquire ) & FRESH ) ){
+        return false;
+    }
+
+    // Exchange Front Buffer with Middle Buffer, then Read Front Buffer
+    front = middle.exchange( front, std::memory_order_acq_rel ) & INDEX;
+    snapshot = buffers[front];
+
+    return true;
+}
+
+// Constructor
+FaceSnapshotRecorder::FaceSnapshotRecorder()
+    : frames( 0 ),
+      bytes( 0 )
+{
+}
+
+// Destructor
+FaceSnapshotRecorder::~FaceSnapshotRecorder()
+{
+    // Close File
+    close();
+}
+
+// Open File
+bool FaceSnapshotRecorder::open( const std::string& path )
+{
+    close();
+
+    file.open( path, std::ios::binary | std::ios::trunc );
+    if( !file.is_open() ){
+        return false;
+    }
+
+    // Write Header
+    const uint8_t header[4] = { VERSION, FaceSnapshot::FACES, FaceSnapshot::POINTS, FaceSnapshot::PROPERTIES };
+    file.write( MAGIC, sizeof( MAGIC ) );
+    file.write( reinterpret_cast<const char*>( header ), sizeof( header ) );
+
+    frames = 0;
+    bytes = sizeof( MAGIC ) + sizeof( header );
+
+    return file.good();
+}
+
+// Close File
+void FaceSnapshotRecorder::close()
+{
+    if( file.is_open() ){
+        file.close();
+    }
+}
+
+// Write Snapshot
+bool FaceSnapshotRecorder::write( const FaceSnapshot& snapshot )
+{
+    if( !file.is_open() ){
+        return false;
+    }
+
+    // Mask of Tracked Faces
+    uint8_t trackedMask = 0;
+    for( int index = 0; index < FaceSnapshot::FACES; index++ ){
+        if( snapshot.faces[index].tracked ){
+            trackedMask |= 1 << index;
+        }
+    }
+
+    // Snapshot Header
+    buffer.clear();
+    writeInteger( buffer, snapshot.sequence, 8 );
+    writeInteger( buffer, static_cast<uint64_t>( snapshot.timestamp ), 8 );
+    buffer.push_back( trackedMask );
+
+    // Tracked Faces
+    for( int index = 0; index < FaceSnapshot::FACES; index++ ){
+        const FaceSnapshot::Face& face = snapshot.faces[index];
+        if( !face.tracked ){
+            continue;
+        }
+
+        writeInteger( buffer, face.trackingId, 8 );
+        writeInteger( buffer, static_cast<uint64_t>( face.timestamp ), 8 );
+        for( int point = 0; point < FaceSnapshot::POINTS; point++ ){
+            writeFloat( buffer, face.points[point][0] );
+            writeFloat( buffer, face.points[point][1] );
+        }
+        for( int side = 0; side < 4; side++ ){
+            writeInteger( buffer, static_cast<uint32_t>( face.box[side] ), 4 );
+        }
+        for( int axis = 0; axis < 4; axis++ ){
+            writeFloat( buffer, face.quaternion[axis] );
+        }
+        for( int axis = 0; axis < 3; axis++ ){
+            writeFloat( buffer, face.pose[axis] );
+        }
+        buffer.insert( buffer.end(), face.properties, face.properties + FaceSnapshot::PROPERTIES );
+    }
+
+    file.write( reinterpret_cast<const char*>( &buffer[0] ), buffer.size() );
+
+    frames++;
+    bytes += buffer.size();
+
+    return file.good();
+}
+
+// Constructor
+FaceSnapshotReplayer::FaceSnapshotReplayer()
+    : frames( 0 ),
+      realtime( true ),
+      origin( 0 )
+{
+}
+
+// Open File
+bool FaceSnapshotReplayer::open( const std::string& path )
+{
+    close();
+
+    file.open( path, std::ios::binary );
+    if( !file.is_open() ){
+        return false;
+    }
+
+    // Check Header
+    char magic[4];
+    uint8_t header[4];
+    file.read( magic, sizeof( magic ) );
+    file.read( reinterpret_cast<char*>( header ), sizeof( header ) );
+    if( !file.good() || std::memcmp( magic, MAGIC, sizeof( MAGIC ) ) != 0 || header[0] != VERSION || header[1] != FaceSnapshot::FACES || header[2] != FaceSnapshot::POINTS || header[3] != FaceSnapshot::PROPERTIES ){
+        close();
+        return false;
+    }
+
+    begin = file.tellg();
+    rewind();
+
+    return true;
+}
+
+// Close File
+void FaceSnapshotReplayer::close()
+{
+    if( file.is_open() ){
+        file.close();
+    }
+}
+
+// Rewind to First Snapshot
+void FaceSnapshotReplayer::rewind()
+{
+    if( !file.is_open() ){
+        return;
+    }
+
+    file.clear();
+    file.seekg( begin );
+    frames = 0;
+}
+
+// Read Next Snapshot
+bool FaceSnapshotReplayer::read( FaceSnapshot& snapshot )
+{
+    if( !file.is_open() ){
+        return false;
+    }
+
+    // Read Snapshot Header
+    uint8_t header[17];
+    if( !file.read( reinterpret_cast<char*>( header ), sizeof( header ) ) ){
+        return false;
+    }
+    const uint8_t* data = header;
+    snapshot.sequence = readInteger( data, 8 );
+    snapshot.timestamp = static_cast<int64_t>( readInteger( data, 8 ) );
+    const uint8_t trackedMask = *data++;
+
+    // Read Tracked Faces
+    int count = 0;
+    for( int index = 0; index < FaceSnapshot::FACES; index++ ){
+        count += ( trackedMask >> index ) & 1;
+    }
+    buffer.resize( count * FACE_BYTES );
+    if( count > 0 && !file.read( reinterpret_cast<char*>( &buffer[0] ), buffer.size() ) ){
+        return false;
+    }
+    data = buffer.data();
+
+    for( int index = 0; index < FaceSnapshot::FACES; index++ ){
+        FaceSnapshot::Face& face = snapshot.faces[index];
+        if( !( trackedMask & ( 1 << index ) ) ){
+            std::memset( &face, 0, sizeof( FaceSnapshot::Face ) );
+            continue;
+        }
+
+        face.tracked = 1;
+        face.trackingId = readInteger( data, 8 );
+        face.timestamp = static_cast<int64_t>( readInteger( data, 8 ) );
+        for( int point = 0; point < FaceSnapshot::POINTS; point++ ){
+            face.points[point][0] = readFloat( data );
+            face.points[point][1] = readFloat( data );
+        }
+        for( int side = 0; side < 4; side++ ){
+            face.box[side] = static_cast<int32_t>( static_cast<uint32_t>( readInteger( data, 4 ) ) );
+        }
+        for( int axis = 0; axis < 4; axis++ ){
+            face.quaternion[axis] = readFloat( data );
+        }
+        for( int axis = 0; axis < 3; axis++ ){
+            face.pose[axis] = readFloat( data );
+        }
+        std::memcpy( face.properties, data, FaceSnapshot::PROPERTIES );
+        data += FaceSnapshot::PROPERTIES;
+    }
+
+    // Pace by RelativeTime ( first snapshot after open or rewind is the origin )
+    if( frames++ == 0 ){
+        origin = snapshot.timestamp;
+        start = std::chrono::steady_clock::now();
+    }
+    if( realtime ){
+        const std::chrono::microseconds elapsed( ( snapshot.timestamp - origin ) / 10 );
+        std::this_thread::sleep_until( start + elapsed );
+    }
+
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,157 @@
+#ifndef __FACE_SNAPSHOT__
+#define __FACE_SNAPSHOT__
+
+#include <string>
+#include <fstream>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Face Snapshot
+// Snapshot of IFaceFrameResult of all faces in plain structure ( no dependency on Kinect SDK ).
+// Each result is retrieved once by face stage, so that rendering, logging and analytics never call COM interfaces.
+// Enumerations ( FacePointType, FaceProperty, DetectionResult ) are stored as same order and values as Kinect SDK.
+struct FaceSnapshot
+{
+    // Number of Faces, Points and Properties ( same as BODY_COUNT, FacePointType_Count and FaceProperty_Count )
+    static const int FACES = 6;
+    static const int POINTS = 5;
+    static const int PROPERTIES = 8;
+
+    struct Face
+    {
+        uint8_t tracked;
+        uint64_t trackingId;
+        int64_t timestamp;              // RelativeTime of face frame ( 100 [ns] unit )
+        float points[POINTS][2];        // X, Y in color space
+        int32_t box[4];                 // Left, Top, Right, Bottom in color space
+        float quaternion[4];            // X, Y, Z, W
+        float pose[3];                  // Pitch, Yaw, Roll [deg] ( smoothed by head pose filter )
+        uint8_t properties[PROPERTIES]; // DetectionResult
+    };
+
+    uint64_t sequence; // Incremented by each publish
+    int64_t timestamp; // Latest RelativeTime of faces
+    Face faces[FACES];
+
+    // Clear All Faces
+    void clear();
+};
+
+// Face Mailbox
+// Lock-free triple buffer that passes latest snapshot from one producer thread to one consumer thread.
+// Producer never waits for consumer, and consumer receives only the latest snapshot ( older snapshots are overwritten ).
+class FaceMailbox
+{
+private:
+    // Flag of Middle Buffer that is Published but not Received
+    static const int FRESH = 0x04;
+    static const int INDEX = 0x03;
+
+    FaceSnapshot buffers[3];
+    int back;                // Owned by producer
+    int front;               // Owned by consumer
+    std::atomic<int> middle; // Index of middle buffer and fresh flag
+
+public:
+    // Constructor
+    FaceMailbox();
+
+    // Publish Snapshot ( producer thread )
+    void publish( const FaceSnapshot& snapshot );
+
+    // Receive Latest Snapshot ( consumer thread, return false if nothing is published since last receive )
+    bool receive( FaceSnapshot& snapshot );
+};
+
+// Face Snapshot Recorder
+// Writes snapshots to file with fixed byte order, so that it can be replayed on any platform ( e.g. analytics on Linux ).
+// Only tracked faces are written.
+class FaceSnapshotRecorder
+{
+private:
+    std::ofstream file;
+    std::vector<uint8_t> buffer;
+    int frames;
+    uint64_t bytes;
+
+public:
+    // Constructor
+    FaceSnapshotRecorder();
+
+    // Destructor
+    ~FaceSnapshotRecorder();
+
+    // Open File
+    bool open( const std::string& path );
+
+    // Close File
+    void close();
+
+    // Check Opened
+    bool isOpened() const
+    {
+        return file.is_open();
+    }
+
+    // Write Snapshot
+    bool write( const FaceSnapshot& snapshot );
+
+    // Retrieve Number of Frames and Bytes Written
+    int getFrames() const
+    {
+        return frames;
+    }
+
+    uint64_t getBytes() const
+    {
+        return bytes;
+    }
+};
+
+// Face Snapshot Replayer
+// Reads snapshots written by FaceSnapshotRecorder, at real-time ( paced by RelativeTime ) or at maximum speed.
+class FaceSnapshotReplayer
+{
+private:
+    std::ifstream file;
+    std::vector<uint8_t> buffer;
+    std::streampos begin;
+    int frames;
+
+    // Pacing
+    bool realtime;
+    int64_t origin;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    // Constructor
+    FaceSnapshotReplayer();
+
+    // Open File
+    bool open( const std::string& path );
+
+    // Close File
+    void close();
+
+    // Check Opened
+    bool isOpened() const
+    {
+        return file.is_open();
+    }
+
+    // Set Pacing ( true is real-time, false is maximum speed )
+    void setRealtime( const bool realtime )
+    {
+        this->realtime = realtime;
+    }
+
+    // Read Next Snapshot ( return false at the end of file )
+    bool read( FaceSnapshot& snapshot );
+
+    // Rewind to First Snapshot
+    void rewind();
+};
+
+#endif // __FACE_SNAPSHOT__
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include <iostream>
+#include <string>
+#include <stdexcept>
+
+#include "FaceSnapshot.h"
+
+// Face Snapshot Dump
+// Recorded face snapshot file is replayed without sensor ( e.g. analytics on Linux ), and tracked faces are printed as CSV.
+// Points are same order as FacePointType, properties are same order as FaceProperty, and values of properties are DetectionResult.
+// This program has no dependency on Kinect SDK and OpenCV.
+int main( int argc, char* argv[] )
+{
+    try{
+        if( argc < 2 ){
+            throw std::runtime_error( "usage : FaceSnapshotDump <recorded face snapshot file> [realtime]" );
+        }
+
+        // Open Recorded Face Snapshot File ( maximum speed, or paced by recorded time )
+        FaceSnapshotReplayer replayer;
+        if( !replayer.open( argv[1] ) ){
+            throw std::runtime_error( "failed FaceSnapshotReplayer::open( " + std::string( argv[1] ) + " )" );
+        }
+        replayer.setRealtime( argc > 2 && std::string( argv[2] ) == "realtime" );
+
+        // Print Header
+        std::cout << "sequence,timestamp,face,trackingId,faceTimestamp";
+        for( int point = 0; point < FaceSnapshot::POINTS; point++ ){
+            std::cout << ",point" << point << "X,point" << point << "Y";
+        }
+        std::cout << ",left,top,right,bottom,quaternionX,quaternionY,quaternionZ,quaternionW,pitch,yaw,roll";
+        for( int property = 0; property < FaceSnapshot::PROPERTIES; property++ ){
+            std::cout << ",property" << property;
+        }
+        std::cout << "\n";
+
+        // Print Tracked Faces of Each Snapshot
+        FaceSnapshot snapshot;
+        while( replayer.read( snapshot ) ){
+            for( int index = 0; index < FaceSnapshot::FACES; index++ ){
+                const FaceSnapshot::Face& face = snapshot.faces[index];
+                if( !face.tracked ){
+                    continue;
+                }
+
+                std::cout << snapshot.sequence << "," << snapshot.timestamp << "," << index << "," << face.trackingId << "," << face.timestamp;
+                for( int point = 0; point < FaceSnapshot::POINTS; point++ ){
+                    std::cout << "," << face.points[point][0] << "," << face.points[point][1];
+                }
+                for( const int32_t value : face.box ){
+                    std::cout << "," << value;
+                }
+                for( const float value : face.quaternion ){
+                    std::cout << "," << value;
+                }
+                for( const float value : face.pose ){
+                    std::cout << "," << value;
+                }
+                for( const uint8_t value : face.properties ){
+                    std::cout << "," << static_cast<int>( value );
+                }
+                std::cout << "\n";
+            }
+        }
+        std::cout.flush();
+        return 0;
+    } catch( std::exception& ex ){
+        std::cout << ex.what() << std::endl;
+    }
+
+    return 1;
+}
\ No newline at end of file
@@ -0,0 +1,169 @@
+#include "HeadPoseBenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <random>
+
+// Constants
+static const float PI = 3.14159265358979323846f;
+
+// Quaternion from Pitch ( X ), Yaw ( Y ) and Roll ( Z ) [deg], inverse of conversion
+static void degree2quaternion( const float pitch, const float yaw, const float roll, float quaternion[4] )
+{
+    const float radian = PI / 180.0f;
+    const float cx = std::cos( pitch * radian * 0.5f ), sx = std::sin( pitch * radian * 0.5f );
+    const float cy = std::cos( yaw * radian * 0.5f ), sy = std::sin( yaw * radian * 0.5f );
+    const float cz = std::cos( roll * radian * 0.5f ), sz = std::sin( roll * radian * 0.5f );
+    quaternion[0] = sx * cy * cz - cx * sy * sz;
+    quaternion[1] = cx * sy * cz + sx * cy * sz;
+    quaternion[2] = cx * cy * sz - sx * sy * cz;
+    quaternion[3] = cx * cy * cz + sx * sy * sz;
+}
+
+// Difference of Angles [deg] ( wrapped to [-180, 180] )
+static double difference( const double a, const double b )
+{
+    double d = std::fmod( a - b, 360.0 );
+    if( d > 180.0 ){
+        d -= 360.0;
+    }
+    else if( d < -180.0 ){
+        d += 360.0;
+    }
+    return d;
+}
+
+// Run Conversion and Smoothing Benchmark
+void HeadPoseBenchmark::run( const int count )
+{
+    conversionResults.clear();
+    smoothingResults.clear();
+
+    runConversion( "Head", count, 60.0f );
+    runConversion( "Full", count, 89.0f );
+    runSmoothing();
+}
+
+// Run Conversion Benchmark
+void HeadPoseBenchmark::runConversion( const std::string& name, const int count, const float range )
+{
+    // Random Quaternions ( structure of arrays for vectorized conversion )
+    std::mt19937 random( 0 );
+    std::uniform_real_distribution<float> angle( -range, range );
+    std::vector<float> x( count ), y( count ), z( count ), w( count );
+    for( int index = 0; index < count; index++ ){
+        float quaternion[4];
+        degree2quaternion( angle( random ), angle( random ), angle( random ), quaternion );
+        x[index] = quaternion[0];
+        y[index] = quaternion[1];
+        z[index] = quaternion[2];
+        w[index] = quaternion[3];
+    }
+
+    // Scalar Reference
+    std::vector<float> reference( count * 3 );
+    const std::chrono::steady_clock::time_point referenceStart = std::chrono::steady_clock::now();
+    for( int index = 0; index < count; index++ ){
+        const float quaternion[4] = { x[index], y[index], z[index], w[index] };
+        HeadPoseFilter::convertReference( quaternion, &reference[index * 3] );
+    }
+    const double referenceTime = std::chrono::duration<double, std::nano>( std::chrono::steady_clock::now() - referenceStart ).count() / count;
+
+    // Vectorized Conversion
+    std::vector<float> pitch( count ), yaw( count ), roll( count );
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    HeadPoseFilter::convert( &x[0], &y[0], &z[0], &w[0], &pitch[0], &yaw[0], &roll[0], count );
+    const double time = std::chrono::duration<double, std::nano>( std::chrono::steady_clock::now() - start ).count() / count;
+
+    // Error from Reference
+    double maxError = 0.0, sumError = 0.0;
+    for( int index = 0; index < count; index++ ){
+        const float* pose = &reference[index * 3];
+        const double errors[3] = { difference( pitch[index], pose[0] ), difference( yaw[index], pose[1] ), difference( roll[index], pose[2] ) };
+        for( const double error : errors ){
+            maxError = std::max( maxError, std::fabs( error ) );
+            sumError += error * error;
+        }
+    }
+
+    conversionResults.push_back( { name + " Ref", 0.0, 0.0, referenceTime } );
+    conversionResults.push_back( { name + " SIMD", maxError, std::sqrt( sumError / ( count * 3.0 ) ), time } );
+}
+
+// Run Smoothing Benchmark
+// Still head with 1 [deg] jitter for 10 [s], then head turning +-45 [deg] at 0.5 [Hz] for 10 [s] at 30 [fps].
+void HeadPoseBenchmark::runSmoothing()
+{
+    std::mt19937 random( 0 );
+    std::normal_distribution<float> noise( 0.0f, 1.0f );
+    const int frames = 300;
+
+    double rawJitter = 0.0, filteredJitter = 0.0, rawError = 0.0, filteredError = 0.0;
+    float previousRaw = 0.0f, previousFiltered = 0.0f;
+
+    HeadPoseFilter filter;
+    FaceSnapshot snapshot;
+    snapshot.clear();
+    snapshot.faces[0].tracked = 1;
+    snapshot.faces[0].trackingId = 1;
+
+    for( int frame = 0; frame < frames * 2; frame++ ){
+        const bool still = frame < frames;
+        const float truth = still ? 0.0f : 45.0f * std::sin( PI * ( frame - frames ) / 30.0f );
+
+        // Raw Pose with Jitter
+        float raw[3] = { noise( random ), truth + noise( random ), noise( random ) };
+        FaceSnapshot::Face& face = snapshot.faces[0];
+        degree2quaternion( raw[0], raw[1], raw[2], face.quaternion );
+        face.timestamp = static_cast<int64_t>( frame + 1 ) * 333333;
+        HeadPoseFilter::convertReference( face.quaternion, raw );
+
+        filter.update( snapshot );
+        const float filtered = face.pose[1];
+
+        // Jitter of Still Head ( after filter is settled ), Error of Turning Head
+        if( still && frame > 30 ){
+            rawJitter += ( raw[1] - previousRaw ) * ( raw[1] - previousRaw );
+            filteredJitter += ( filtered - previousFiltered ) * ( filtered - previousFiltered );
+        }
+        if( !still ){
+            rawError += ( raw[1] - truth ) * ( raw[1] - truth );
+            filteredError += ( filtered - truth ) * ( filtered - truth );
+        }
+        previousRaw = raw[1];
+        previousFiltered = filtered;
+    }
+
+    const int stillFrames = frames - 31;
+    smoothingResults.push_back( { "Raw", std::sqrt( rawJitter / stillFrames ), std::sqrt( rawError / frames ) } );
+    smoothingResults.push_back( { "OneEuro", std::sqrt( filteredJitter / stillFrames ), std::sqrt( filteredError / frames ) } );
+}
+
+// Print Results
+void HeadPoseBenchmark::print( std::ostream& stream ) const
+{
+    stream << std::left << std::setw( 10 ) << "Convert" << std::right
+           << std::setw( 14 ) << "Max [deg]"
+           << std::setw( 14 ) << "RMS [deg]"
+           << std::setw( 14 ) << "Time [ns]" << std::endl;
+
+    for( const ConversionResult& result : conversionResults ){
+        stream << std::left << std::setw( 10 ) << result.name << std::right << std::fixed << std::setprecision( 4 )
+               << std::setw( 14 ) << result.maxError
+               << std::setw( 14 ) << result.rmsError
+               << std::setw( 14 ) << result.time << std::endl;
+    }
+
+    stream << std::endl;
+    stream << std::left << std::setw( 10 ) << "Smooth" << std::right
+           << std::setw( 14 ) << "Jitter [deg]"
+           << std::setw( 14 ) << "Error [deg]" << std::endl;
+
+    for( const SmoothingResult& result : smoothingResults ){
+        stream << std::left << std::setw( 10 ) << result.name << std::right << std::fixed << std::setprecision( 3 )
+               << std::setw( 14 ) << result.jitter
+               << std::setw( 14 ) << result.error << std::endl;
+    }
+}
\ No newline at end of file
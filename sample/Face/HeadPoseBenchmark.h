@@ -0,0 +1,53 @@
+#ifndef __HEAD_POSE_BENCHMARK__
+#define __HEAD_POSE_BENCHMARK__
+
+#include "HeadPoseFilter.h"
+
+#include <vector>
+#include <string>
+#include <ostream>
+
+// Head Pose Benchmark
+// Vectorized conversion of head pose filter is compared with scalar reference ( double precision atan2 and asin ) on random quaternions.
+// Smoothing is measured on synthetic still head with jitter, and on turning head ( jitter versus lag ).
+// This class has no dependency on Kinect SDK.
+class HeadPoseBenchmark
+{
+public:
+    // Result of Conversion
+    struct ConversionResult
+    {
+        std::string name;
+        double maxError;  // [deg], max difference from reference
+        double rmsError;  // [deg], RMS difference from reference
+        double time;      // [ns], time per quaternion
+    };
+
+    // Result of Smoothing
+    struct SmoothingResult
+    {
+        std::string name;
+        double jitter; // [deg], RMS of frame to frame change of still head
+        double error;  // [deg], RMS difference from true pose of turning head
+    };
+
+private:
+    std::vector<ConversionResult> conversionResults;
+    std::vector<SmoothingResult> smoothingResults;
+
+public:
+    // Run Conversion and Smoothing Benchmark
+    void run( const int count = 1000000 );
+
+    // Print Results
+    void print( std::ostream& stream ) const;
+
+private:
+    // Run Conversion Benchmark on Quaternions within Range of Yaw [deg]
+    void runConversion( const std::string& name, const int count, const float range );
+
+    // Run Smoothing Benchmark
+    void runSmoothing();
+};
+
+#endif // __HEAD_POSE_BENCHMARK__
\ No newline at end of file
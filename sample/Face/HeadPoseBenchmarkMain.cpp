@@ -0,0 +1,21 @@
+#include <iostream>
+#include <stdexcept>
+
+#include "HeadPoseBenchmark.h"
+
+// Head Pose Benchmark
+// Head pose conversion and smoothing are benchmarked without sensor ( e.g. analysis on Linux ), same as "Face benchmark".
+// This program has no dependency on Kinect SDK and OpenCV.
+int main()
+{
+    try{
+        HeadPoseBenchmark benchmark;
+        benchmark.run();
+        benchmark.print( std::cout );
+        return 0;
+    } catch( std::exception& ex ){
+        std::cout << ex.what() << std::endl;
+    }
+
+    return 1;
+}
\ No newline at end of file
@@ -0,0 +1,303 @@
+#include "HeadPoseFilter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined( _M_X64 ) || defined( __SSE2__ )
+#include <emmintrin.h>
+#endif
+
+// Constants
+static const float PI = 3.14159265358979323846f;
+static const float DEGREE = 180.0f / PI;
+
+// Coefficients of atan on [0, 1] ( minimax polynomial of t^2, max error is about 1e-5 [rad] )
+static const float ATAN[6] = { 0.99997726f, -0.33262347f, 0.19354346f, -0.11643287f, 0.05265332f, -0.01172120f };
+
+// Approximate atan2 ( scalar )
+static inline float atan2Approx( const float y, const float x )
+{
+    const float ax = std::fabs( x );
+    const float ay = std::fabs( y );
+    const float t = std::min( ax, ay ) / std::max( std::max( ax, ay ), 1e-30f );
+    const float s = t * t;
+    float r = t * ( ATAN[0] + s * ( ATAN[1] + s * ( ATAN[2] + s * ( ATAN[3] + s * ( ATAN[4] + s * ATAN[5] ) ) ) ) );
+    if( ay > ax ){
+        r = PI * 0.5f - r;
+    }
+    if( x < 0.0f ){
+        r = PI - r;
+    }
+    return ( y < 0.0f ) ? -r : r;
+}
+
+// Approximate asin ( scalar, argument is clamped to [-1, 1] )
+static inline float asinApprox( const float x )
+{
+    const float s = std::min( std::max( x, -1.0f ), 1.0f );
+    return atan2Approx( s, std::sqrt( std::max( ( 1.0f - s ) * ( 1.0f + s ), 0.0f ) ) );
+}
+
+#if defined( _M_X64 ) || defined( __SSE2__ )
+// Approximate atan2 ( 4 lanes )
+static inline __m128 atan2Approx( const __m128 y, const __m128 x )
+{
+    const __m128 sign = _mm_set1_ps( -0.0f );
+    const __m128 ax = _mm_andnot_ps( sign, x );
+    const __m128 ay = _mm_andnot_ps( sign, y );
+    const __m128 t = _mm_div_ps( _mm_min_ps( ax, ay ), _mm_max_ps( _mm_max_ps( ax, ay ), _mm_set1_ps( 1e-30f ) ) );
+    const __m128 s = _mm_mul_ps( t, t );
+    __m128 r = _mm_set1_ps( ATAN[5] );
+    r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( ATAN[4] ) );
+    r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( ATAN[3] ) );
+    r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( ATAN[2] ) );
+    r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( ATAN[1] ) );
+    r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( ATAN[0] ) );
+    r = _mm_mul_ps( r, t );
+
+    // Select Octant without Branches
+    const __m128 steep = _mm_cmpgt_ps( ay, ax );
+    r = _mm_or_ps( _mm_and_ps( steep, _mm_sub_ps( _mm_set1_ps( PI * 0.5f ), r ) ), _mm_andnot_ps( steep, r ) );
+    const __m128 left = _mm_cmplt_ps( x, _mm_setzero_ps() );
+    r = _mm_or_ps( _mm_and_ps( left, _mm_sub_ps( _mm_set1_ps( PI ), r ) ), _mm_andnot_ps( left, r ) );
+    return _mm_xor_ps( r, _mm_and_ps( sign, y ) );
+}
+
+// Approximate asin ( 4 lanes, argument is clamped to [-1, 1] )
+static inline __m128 asinApprox( const __m128 x )
+{
+    const __m128 one = _mm_set1_ps( 1.0f );
+    const __m128 s = _mm_min_ps( _mm_max_ps( x, _mm_set1_ps( -1.0f ) ), one );
+    const __m128 cosine = _mm_mul_ps( _mm_sub_ps( one, s ), _mm_add_ps( one, s ) );
+    return atan2Approx( s, _mm_sqrt_ps( _mm_max_ps( cosine, _mm_setzero_ps() ) ) );
+}
+#endif
+
+// Constructor
+HeadPoseFilter::HeadPoseFilter()
+{
+    // Initialize
+    initialize();
+}
+
+// Initialize Parameters and Release All Filters
+void HeadPoseFilter::initialize( const Parameters& parameters )
+{
+    this->parameters = parameters;
+
+    std::memset( trackingIds, 0, sizeof( trackingIds ) );
+    std::memset( timestamps, 0, sizeof( timestamps ) );
+    std::memset( filtered, 0, sizeof( filtered ) );
+    std::memset( raw, 0, sizeof( raw ) );
+    std::memset( derivatives, 0, sizeof( derivatives ) );
+    std::memset( times, 0, sizeof( times ) );
+    std::memset( poses, 0, sizeof( poses ) );
+
+    // Identity Quaternion in All Lanes
+    for( int lane = 0; lane < LANES; lane++ ){
+        filtered[3][lane] = 1.0f;
+        raw[3][lane] = 1.0f;
+    }
+}
+
+// Update Filters by Tracked Faces
+void HeadPoseFilter::update( FaceSnapshot& snapshot )
+{
+    // Release Lanes of TrackingIds not in Snapshot
+    for( int lane = 0; lane < LANES; lane++ ){
+        bool found = false;
+        for( const FaceSnapshot::Face& face : snapshot.faces ){
+            found |= face.tracked && face.trackingId == trackingIds[lane];
+        }
+        if( !found ){
+            trackingIds[lane] = 0;
+        }
+        times[lane] = 0.0f;
+    }
+
+    // Gather Quaternions of Tracked Faces into Lanes
+    int lanes[FaceSnapshot::FACES];
+    for( int index = 0; index < FaceSnapshot::FACES; index++ ){
+        const FaceSnapshot::Face& face = snapshot.faces[index];
+        lanes[index] = -1;
+        if( !face.tracked || face.trackingId == 0 ){
+            continue;
+        }
+
+        // Assign Free Lane to New TrackingId ( filter starts from raw quaternion )
+        int lane = find( face.trackingId );
+        bool reset = false;
+        if( lane == -1 ){
+            lane = find( 0 );
+            if( lane == -1 ){
+                continue;
+            }
+            trackingIds[lane] = face.trackingId;
+            reset = true;
+        }
+        lanes[index] = lane;
+
+        for( int axis = 0; axis < 4; axis++ ){
+            raw[axis][lane] = face.quaternion[axis];
+        }
+
+        // Elapsed Time ( 0 if face is not updated, filter keeps state )
+        if( reset ){
+            for( int axis = 0; axis < 4; axis++ ){
+                filtered[axis][lane] = face.quaternion[axis];
+            }
+            for( int axis = 0; axis < 4; axis++ ){
+                derivatives[axis][lane] = 0.0f;
+            }
+        }
+        else if( face.timestamp > timestamps[lane] ){
+            times[lane] = static_cast<float>( face.timestamp - timestamps[lane] ) / 10000000.0f;
+        }
+        timestamps[lane] = face.timestamp;
+    }
+
+    // Filter and Convert All Lanes in Batch
+    filter();
+    convert( filtered[0], filtered[1], filtered[2], filtered[3], poses[0], poses[1], poses[2], LANES );
+
+    // Scatter Poses to Faces
+    for( int index = 0; index < FaceSnapshot::FACES; index++ ){
+        FaceSnapshot::Face& face = snapshot.faces[index];
+        const int lane = lanes[index];
+        for( int axis = 0; axis < 3; axis++ ){
+            face.pose[axis] = ( lane == -1 ) ? 0.0f : poses[axis][lane];
+        }
+    }
+}
+
+// Retrieve Smoothed Pose of TrackingId
+bool HeadPoseFilter::getPose( const uint64_t trackingId, float pose[3] ) const
+{
+    const int lane = find( trackingId );
+    if( trackingId == 0 || lane == -1 ){
+        return false;
+    }
+
+    for( int axis = 0; axis < 3; axis++ ){
+        pose[axis] = poses[axis][lane];
+    }
+    return true;
+}
+
+// Find Lane of TrackingId
+int HeadPoseFilter::find( const uint64_t trackingId ) const
+{
+    for( int lane = 0; lane < LANES; lane++ ){
+        if( trackingIds[lane] == trackingId ){
+            return lane;
+        }
+    }
+    return -1;
+}
+
+// Filter Quaternions of All Lanes
+// Lanes without update have elapsed time of 0, so their alpha is 0 and state is kept.
+void HeadPoseFilter::filter()
+{
+    const float minCutoff = parameters.minCutoff;
+    const float beta = parameters.beta;
+    const float derivativeCutoff = parameters.derivativeCutoff;
+
+    for( int lane = 0; lane < LANES; lane++ ){
+        const float time = times[lane];
+        float q[4], r[4];
+        for( int axis = 0; axis < 4; axis++ ){
+            q[axis] = filtered[axis][lane];
+            r[axis] = raw[axis][lane];
+        }
+
+        // Raw Quaternion on Same Hemisphere as Filtered Quaternion
+        const float dot = q[0] * r[0] + q[1] * r[1] + q[2] * r[2] + q[3] * r[3];
+        const float sign = ( dot < 0.0f ) ? -1.0f : 1.0f;
+
+        // Angular Speed ( derivative of quaternion is smoothed before its length is taken, so that jitter of still head cancels out,
+        // length of derivative is half of angular speed for small rotation )
+        const float derivativeAlpha = time / ( time + 1.0f / ( 2.0f * PI * derivativeCutoff ) );
+        const float inverseTime = 1.0f / std::max( time, 1e-6f );
+        float length = 0.0f;
+        for( int axis = 0; axis < 4; axis++ ){
+            const float derivative = ( sign * r[axis] - q[axis] ) * inverseTime;
+            derivatives[axis][lane] += derivativeAlpha * ( derivative - derivatives[axis][lane] );
+            length += derivatives[axis][lane] * derivatives[axis][lane];
+        }
+        const float speed = 2.0f * std::sqrt( length );
+
+        // Cutoff Frequency Adapted by Angular Speed
+        const float cutoff = minCutoff + beta * speed;
+        const float alpha = time / ( time + 1.0f / ( 2.0f * PI * cutoff ) );
+
+        // Normalized Linear Interpolation
+        float norm = 0.0f;
+        for( int axis = 0; axis < 4; axis++ ){
+            q[axis] += alpha * ( sign * r[axis] - q[axis] );
+            norm += q[axis] * q[axis];
+        }
+        const float inverse = 1.0f / std::sqrt( std::max( norm, 1e-12f ) );
+        for( int axis = 0; axis < 4; axis++ ){
+            filtered[axis][lane] = q[axis] * inverse;
+        }
+    }
+}
+
+// Convert Quaternions to Pitch, Yaw and Roll
+void HeadPoseFilter::convert( const float* x, const float* y, const float* z, const float* w, float* pitch, float* yaw, float* roll, const int count )
+{
+    int index = 0;
+#if defined( _M_X64 ) || defined( __SSE2__ )
+    // 4 Quaternions at a Time
+    const __m128 two = _mm_set1_ps( 2.0f );
+    const __m128 degree = _mm_set1_ps( DEGREE );
+    for( ; index + 4 <= count; index += 4 ){
+        const __m128 qx = _mm_loadu_ps( x + index );
+        const __m128 qy = _mm_loadu_ps( y + index );
+        const __m128 qz = _mm_loadu_ps( z + index );
+        const __m128 qw = _mm_loadu_ps( w + index );
+        const __m128 xx = _mm_mul_ps( qx, qx );
+        const __m128 yy = _mm_mul_ps( qy, qy );
+        const __m128 zz = _mm_mul_ps( qz, qz );
+        const __m128 ww = _mm_mul_ps( qw, qw );
+
+        // pitch = atan2( 2 * ( y * z + w * x ), w^2 - x^2 - y^2 + z^2 )
+        const __m128 pitchY = _mm_mul_ps( two, _mm_add_ps( _mm_mul_ps( qy, qz ), _mm_mul_ps( qw, qx ) ) );
+        const __m128 pitchX = _mm_add_ps( _mm_sub_ps( _mm_sub_ps( ww, xx ), yy ), zz );
+        _mm_storeu_ps( pitch + index, _mm_mul_ps( atan2Approx( pitchY, pitchX ), degree ) );
+
+        // yaw = asin( 2 * ( w * y - x * z ) )
+        const __m128 yawS = _mm_mul_ps( two, _mm_sub_ps( _mm_mul_ps( qw, qy ), _mm_mul_ps( qx, qz ) ) );
+        _mm_storeu_ps( yaw + index, _mm_mul_ps( asinApprox( yawS ), degree ) );
+
+        // roll = atan2( 2 * ( x * y + w * z ), w^2 + x^2 - y^2 - z^2 )
+        const __m128 rollY = _mm_mul_ps( two, _mm_add_ps( _mm_mul_ps( qx, qy ), _mm_mul_ps( qw, qz ) ) );
+        const __m128 rollX = _mm_sub_ps( _mm_sub_ps( _mm_add_ps( ww, xx ), yy ), zz );
+        _mm_storeu_ps( roll + index, _mm_mul_ps( atan2Approx( rollY, rollX ), degree ) );
+    }
+#endif
+
+    // Remaining Quaternions
+    for( ; index < count; index++ ){
+        const float qx = x[index], qy = y[index], qz = z[index], qw = w[index];
+        pitch[index] = atan2Approx( 2.0f * ( qy * qz + qw * qx ), qw * qw - qx * qx - qy * qy + qz * qz ) * DEGREE;
+        yaw[index] = asinApprox( 2.0f * ( qw * qy - qx * qz ) ) * DEGREE;
+        roll[index] = atan2Approx( 2.0f * ( qx * qy + qw * qz ), qw * qw + qx * qx - qy * qy - qz * qz ) * DEGREE;
+    }
+}
+
+// Convert Quaternion to Pitch, Yaw and Roll ( scalar reference )
+void HeadPoseFilter::convertReference( const float quaternion[4], float pose[3] )
+{
+    const double x = quaternion[0];
+    const double y = quaternion[1];
+    const double z = quaternion[2];
+    const double w = quaternion[3];
+    const double degree = 180.0 / 3.14159265358979323846;
+
+    pose[0] = static_cast<float>( std::atan2( 2 * ( y * z + w * x ), w * w - x * x - y * y + z * z ) * degree );
+    pose[1] = static_cast<float>( std::asin( std::min( std::max( 2 * ( w * y - x * z ), -1.0 ), 1.0 ) ) * degree );
+    pose[2] = static_cast<float>( std::atan2( 2 * ( x * y + w * z ), w * w + x * x - y * y - z * z ) * degree );
+}
\ No newline at end of file
@@ -3,14 +3,29 @@
 
 #include <thread>
 #include <chrono>
+#include <iostream>
+#include <algorithm>
 #define _USE_MATH_DEFINES
 #include <math.h>
 
 #include <omp.h>
 
+//#define BENCHMARK
+
 // Constructor
-Kinect::Kinect()
+Kinect::Kinect( const std::string& replay, const bool realtime )
+    : decodeRegions( true ),
+      running( false ),
+      failed( false )
 {
+    // Open Replay
+    if( !replay.empty() ){
+        if( !replayer.open( replay ) ){
+            throw std::runtime_error( "failed FaceSnapshotReplayer::open( " + replay + " )" );
+        }
+        replayer.setRealtime( realtime );
+    }
+
     // Initialize
     initialize();
 }
@@ -41,6 +56,12 @@ void Kinect::run()
         if( key == VK_ESCAPE ){
             break;
         }
+        else if( key == 'r' && !replayer.isOpened() ){
+            toggleRecording();
+        }
+        else if( key == 'd' ){
+            decodeRegions = !decodeRegions;
+        }
     }
 }
 
@@ -49,6 +70,34 @@ void Kinect::initialize()
 {
     cv::setUseOptimized( true );
 
+    // Clear Face Snapshot
+    snapshot.clear();
+    faces.clear();
+
+    // Color Table for Visualization
+    colors[0] = cv::Vec3b( 255,   0,   0 ); // Blue
+    colors[1] = cv::Vec3b(   0, 255,   0 ); // Green
+    colors[2] = cv::Vec3b(   0,   0, 255 ); // Red
+    colors[3] = cv::Vec3b( 255, 255,   0 ); // Cyan
+    colors[4] = cv::Vec3b( 255,   0, 255 ); // Magenta
+    colors[5] = cv::Vec3b(   0, 255, 255 ); // Yellow
+
+    // Face Property Label Text Table for Display
+    labels[0] = "Happy";
+    labels[1] = "Engaged";
+    labels[2] = "WearingGlasses";
+    labels[3] = "LeftEyeClosed";
+    labels[4] = "RightEyeClosed";
+    labels[5] = "MouthOpen";
+    labels[6] = "MouthMoved";
+    labels[7] = "LookingAway";
+
+    // Initialize Replay
+    if( replayer.isOpened() ){
+        initializeReplay();
+        return;
+    }
+
     // Initialize Sensor
     initializeSensor();
 
@@ -63,6 +112,10 @@ void Kinect::initialize()
 
     // Wait a Few Seconds until begins to Retrieve Data from Sensor ( about 2000-[ms] )
     std::this_thread::sleep_for( std::chrono::seconds( 2 ) );
+
+    // Start Face Stage
+    running = true;
+    faceThread = std::thread( &Kinect::faceStage, this );
 }
 
 // Initialize Sensor
@@ -101,6 +154,9 @@ inline void Kinect::initializeColor()
 
     // Allocation Color Buffer
     colorBuffer.resize( colorWidth * colorHeight * colorBytesPerPixel );
+
+    // Initialize Color Region Decoder
+    decoder.initialize( colorWidth, colorHeight, 4 );
 }
 
 // Initialize Body
@@ -142,24 +198,17 @@ inline void Kinect::initializeFace()
         // Open Face Readers
         ERROR_CHECK( faceFrameSource->OpenReader( &faceFrameReader[count] ) );
     }
+}
 
-    // Color Table for Visualization
-    colors[0] = cv::Vec3b( 255,   0,   0 ); // Blue
-    colors[1] = cv::Vec3b(   0, 255,   0 ); // Green
-    colors[2] = cv::Vec3b(   0,   0, 255 ); // Red
-    colors[3] = cv::Vec3b( 255, 255,   0 ); // Cyan
-    colors[4] = cv::Vec3b( 255,   0, 255 ); // Magenta
-    colors[5] = cv::Vec3b(   0, 255, 255 ); // Yellow
-
-    // Face Property Label Text Table for Display
-    labels[0] = "Happy";
-    labels[1] = "Engaged";
-    labels[2] = "WearingGlasses";
-    labels[3] = "LeftEyeClosed";
-    labels[4] = "RightEyeClosed";
-    labels[5] = "MouthOpen";
-    labels[6] = "MouthMoved";
-    labels[7] = "LookingAway";
+// Initialize Replay
+// Faces are drawn on black image of color resolution.
+inline void Kinect::initializeReplay()
+{
+    // Allocation Color Buffer
+    colorWidth = 1920;
+    colorHeight = 1080;
+    colorBytesPerPixel = 4;
+    colorBuffer.resize( colorWidth * colorHeight * colorBytesPerPixel );
 }
 
 // Finalize
@@ -167,6 +216,15 @@ void Kinect::finalize()
 {
     cv::destroyAllWindows();
 
+    // Stop Face Stage
+    running = false;
+    if( faceThread.joinable() ){
+        faceThread.join();
+    }
+
+    // Close Recording
+    recorder.close();
+
     // Release Body Buffer
     for( auto& body : bodies ){
         SafeRelease( body );
@@ -181,14 +239,26 @@ void Kinect::finalize()
 // Update Data
 void Kinect::update()
 {
+    // Update Replay
+    if( replayer.isOpened() ){
+        // Clear Color Buffer
+        std::fill( colorBuffer.begin(), colorBuffer.end(), 0 );
+
+        // Read Next Face Snapshot ( loop at the end )
+        if( !replayer.read( faces ) ){
+            replayer.rewind();
+            if( !replayer.read( faces ) ){
+                throw std::runtime_error( "failed FaceSnapshotReplayer::read()" );
+            }
+        }
+        return;
+    }
+
     // Update Color
     updateColor();
 
-    // Update Body
-    updateBody();
-
-    // Update Face
-    updateFace();
+    // Update Snapshot
+    updateSnapshot();
 }
 
 // Update Color
@@ -201,18 +271,171 @@ inline void Kinect::updateColor()
         return;
     }
 
+#ifdef BENCHMARK
+    // Benchmark Color
+    benchmarkColor( colorFrame );
+#else
+    // Decode Regions of Faces and Preview ( fall back to conversion of whole frame if raw format is not YUY2 )
+    if( decodeRegions && decodeColor( colorFrame ) ){
+        return;
+    }
+    decodeRegions = false;
+
     // Convert Format ( YUY2 -> BGRA )
     ERROR_CHECK( colorFrame->CopyConvertedFrameDataToArray( static_cast<UINT>( colorBuffer.size() ), &colorBuffer[0], ColorImageFormat::ColorImageFormat_Bgra ) );
+#endif
+}
+
+// Decode Color
+// Regions are requested from latest face boxes, enlarged by quarter of box for motion until face results of this frame are received.
+inline bool Kinect::decodeColor( const ComPtr<IColorFrame>& colorFrame )
+{
+    // Check Raw Format
+    ColorImageFormat format;
+    ERROR_CHECK( colorFrame->get_RawColorImageFormat( &format ) );
+    if( format != ColorImageFormat::ColorImageFormat_Yuy2 ){
+        return false;
+    }
+
+    // Request Regions of Faces
+    decoder.clear();
+    for( const FaceSnapshot::Face& face : faces.faces ){
+        if( !face.tracked ){
+            continue;
+        }
+
+        const int marginX = ( face.box[2] - face.box[0] ) / 4;
+        const int marginY = ( face.box[3] - face.box[1] ) / 4;
+        decoder.request( face.box[0] - marginX, face.box[1] - marginY, face.box[2] + marginX, face.box[3] + marginY );
+    }
+
+    // Access Raw Frame without Copy ( valid while color frame is held )
+    UINT capacity;
+    BYTE* buffer;
+    ERROR_CHECK( colorFrame->AccessRawUnderlyingBuffer( &capacity, &buffer ) );
+    if( capacity < static_cast<UINT>( colorWidth * colorHeight * 2 ) ){
+        throw std::runtime_error( "failed IColorFrame::AccessRawUnderlyingBuffer()" );
+    }
+
+    // Decode Regions into Color Buffer and Preview
+    decoder.decode( buffer, &colorBuffer[0] );
+
+    return true;
+}
+
+#ifdef BENCHMARK
+// Benchmark Color
+inline void Kinect::benchmarkColor( const ComPtr<IColorFrame>& colorFrame )
+{
+    static double convertTime = 0.0;
+    static double decodeTime = 0.0;
+    static double decodedPixels = 0.0;
+    static int frameCount = 0;
+
+    // Convert Whole Frame ( previous conversion )
+    auto start = std::chrono::high_resolution_clock::now();
+    ERROR_CHECK( colorFrame->CopyConvertedFrameDataToArray( static_cast<UINT>( colorBuffer.size() ), &colorBuffer[0], ColorImageFormat::ColorImageFormat_Bgra ) );
+    auto end = std::chrono::high_resolution_clock::now();
+    convertTime += std::chrono::duration<double, std::milli>( end - start ).count();
+
+    // Decode Regions of Faces and Preview
+    start = std::chrono::high_resolution_clock::now();
+    if( !decodeColor( colorFrame ) ){
+        throw std::runtime_error( "failed Kinect::decodeColor()" );
+    }
+    end = std::chrono::high_resolution_clock::now();
+    decodeTime += std::chrono::duration<double, std::milli>( end - start ).count();
+    decodedPixels += static_cast<double>( decoder.getPixels() ) / ( colorWidth * colorHeight );
+
+    // Print Average every 100 Frames
+    if( ++frameCount == 100 ){
+        std::cout << "convert : " << convertTime / frameCount << " [ms/frame], "
+                  << "decode : " << decodeTime / frameCount << " [ms/frame] ( " << decodedPixels / frameCount * 100.0 << " [%] of pixels )" << std::endl;
+        convertTime = 0.0;
+        decodeTime = 0.0;
+        decodedPixels = 0.0;
+        frameCount = 0;
+    }
+}
+#endif
+
+// Update Snapshot
+inline void Kinect::updateSnapshot()
+{
+    // Rethrow Error of Face Stage
+    if( failed ){
+        std::rethrow_exception( error );
+    }
+
+    // Receive Latest Face Snapshot
+    if( !mailbox.receive( faces ) ){
+        return;
+    }
+
+    // Record Face Snapshot
+    if( recorder.isOpened() ){
+        if( !recorder.write( faces ) ){
+            throw std::runtime_error( "failed FaceSnapshotRecorder::write()" );
+        }
+    }
+}
+
+// Toggle Recording
+// Snapshots are recorded as received by main thread, so that gaps of sequence show snapshots skipped by drawing.
+void Kinect::toggleRecording()
+{
+    // Stop Recording
+    if( recorder.isOpened() ){
+        std::cout << "Stop Recording Face ( " << recorder.getFrames() << " frames, " << recorder.getBytes() << " bytes )" << std::endl;
+        recorder.close();
+        return;
+    }
+
+    // Start Recording
+    std::cout << "Start Recording Face to File" << std::endl;
+    if( !recorder.open( "Face.bin" ) ){
+        throw std::runtime_error( "failed FaceSnapshotRecorder::open( Face.bin )" );
+    }
+}
+
+// Face Stage
+// Retrieve bodies and face results on worker thread, and publish snapshot of faces when something is updated.
+void Kinect::faceStage()
+{
+    try{
+        while( running ){
+            // Update Body
+            const bool bodyUpdated = updateBody();
+
+            // Update Face
+            const bool faceUpdated = updateFace();
+
+            // Publish Face Snapshot ( with head pose smoothed per TrackingId )
+            if( bodyUpdated || faceUpdated ){
+                headPoseFilter.update( snapshot );
+                snapshot.sequence++;
+                mailbox.publish( snapshot );
+                continue;
+            }
+
+            // Wait for Next Frame
+            std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) );
+        }
+    } catch( ... ){
+        // Pass Error to Main Thread
+        error = std::current_exception();
+        failed = true;
+    }
 }
 
 // Update Body
-inline void Kinect::updateBody()
+inline bool Kinect::updateBody()
 {
     // Retrieve Body Frame
     ComPtr<IBodyFrame> bodyFrame;
     const HRESULT ret = bodyFrameReader->AcquireLatestFrame( &bodyFrame );
     if( FAILED( ret ) ){
-        return;
+        return false;
     }
 
     // Release Previous Bodies
@@ -222,6 +445,10 @@ inline void Kinect::updateBody()
 
     // Retrieve Body Data
     ERROR_CHECK( bodyFrame->GetAndRefreshBodyData( static_cast<UINT>( bodies.size() ), &bodies[0] ) );
+
+    // Gather Tracking IDs of Tracked Bodies
+    std::array<TrackingIdManager::Candidate, BODY_COUNT> candidates;
+    int candidateCount = 0;
     for( int count = 0; count < BODY_COUNT; count++ ){
         const ComPtr<IBody> body = bodies[count];
         BOOLEAN tracked;
@@ -233,17 +460,29 @@ inline void Kinect::updateBody()
         // Retrieve Tracking ID
         UINT64 trackingId;
         ERROR_CHECK( body->get_TrackingId( &trackingId ) );
+        candidates[candidateCount++] = { trackingId, 0.0f };
+    }
+
+    // Registration Tracking ID only when Assignment of Reader is Changed
+    for( const TrackingIdManager::Event& event : trackingIdManager.update( &candidates[0], candidateCount ) ){
+        // Release Face of Lost Body
+        if( event.type == TrackingIdManager::Lost ){
+            snapshot.faces[event.slot].tracked = 0;
+            continue;
+        }
 
-        // Registration Tracking ID
         ComPtr<IFaceFrameSource> faceFrameSource;
-        ERROR_CHECK( faceFrameReader[count]->get_FaceFrameSource( &faceFrameSource ) );
-        ERROR_CHECK( faceFrameSource->put_TrackingId( trackingId ) );
+        ERROR_CHECK( faceFrameReader[event.slot]->get_FaceFrameSource( &faceFrameSource ) );
+        ERROR_CHECK( faceFrameSource->put_TrackingId( event.trackingId ) );
     }
+
+    return true;
 }
 
 // Update Face
-inline void Kinect::updateFace()
+inline bool Kinect::updateFace()
 {
+    bool updated = false;
     for( int count = 0; count < BODY_COUNT; count++ ){
         // Retrieve Face Frame
         ComPtr<IFaceFrame> faceFrame;
@@ -259,9 +498,69 @@ inline void Kinect::updateFace()
             continue;
         }
 
-        // Release Previous Face Result and Retrieve Face Result
-        ERROR_CHECK( faceFrame->get_FaceFrameResult( &results[count] ) );
+        // Retrieve Face Result
+        ComPtr<IFaceFrameResult> result;
+        ERROR_CHECK( faceFrame->get_FaceFrameResult( &result ) );
+        if( result == nullptr ){
+            // Release Lost Face ( stale points, box and pose are not drawn, logged, filtered or decoded )
+            FaceSnapshot::Face& face = snapshot.faces[count];
+            face.tracked = 0;
+            face.trackingId = 0;
+            face.timestamp = 0;
+            updated = true;
+            continue;
+        }
+
+        // Retrieve Face Snapshot ( each result is retrieved only once )
+        retrieveFace( result, snapshot.faces[count] );
+        snapshot.timestamp = std::max( snapshot.timestamp, snapshot.faces[count].timestamp );
+        updated = true;
+    }
+
+    return updated;
+}
+
+// Retrieve Face Result
+inline void Kinect::retrieveFace( const ComPtr<IFaceFrameResult>& result, FaceSnapshot::Face& face )
+{
+    // Retrieve Tracking ID and Time
+    TIMESPAN timestamp;
+    ERROR_CHECK( result->get_TrackingId( &face.trackingId ) );
+    ERROR_CHECK( result->get_RelativeTime( &timestamp ) );
+    face.timestamp = timestamp;
+
+    // Retrieve Face Points
+    std::array<PointF, FacePointType::FacePointType_Count> facePoints;
+    ERROR_CHECK( result->GetFacePointsInColorSpace( FacePointType::FacePointType_Count, &facePoints[0] ) );
+    for( int point = 0; point < FaceSnapshot::POINTS; point++ ){
+        face.points[point][0] = facePoints[point].X;
+        face.points[point][1] = facePoints[point].Y;
     }
+
+    // Retrieve Face Bounding Box
+    RectI boundingBox;
+    ERROR_CHECK( result->get_FaceBoundingBoxInColorSpace( &boundingBox ) );
+    face.box[0] = boundingBox.Left;
+    face.box[1] = boundingBox.Top;
+    face.box[2] = boundingBox.Right;
+    face.box[3] = boundingBox.Bottom;
+
+    // Retrieve Face Rotation Quaternion
+    Vector4 rotationQuaternion;
+    ERROR_CHECK( result->get_FaceRotationQuaternion( &rotationQuaternion ) );
+    face.quaternion[0] = rotationQuaternion.x;
+    face.quaternion[1] = rotationQuaternion.y;
+    face.quaternion[2] = rotationQuaternion.z;
+    face.quaternion[3] = rotationQuaternion.w;
+
+    // Retrieve Face Properties
+    std::array<DetectionResult, FaceProperty::FaceProperty_Count> detectionResults;
+    ERROR_CHECK( result->GetFaceProperties( FaceProperty::FaceProperty_Count, &detectionResults[0] ) );
+    for( int property = 0; property < FaceSnapshot::PROPERTIES; property++ ){
+        face.properties[property] = static_cast<uint8_t>( detectionResults[property] );
+    }
+
+    face.tracked = 1;
 }
 
 // Draw Data
@@ -275,109 +574,118 @@ void Kinect::draw()
 }
 
 // Draw Color
+// Faces are drawn into image of display resolution, that is resized from whole frame, or composed from preview and decoded regions.
 inline void Kinect::drawColor()
 {
     // Create cv::Mat from Color Buffer
     colorMat = cv::Mat( colorHeight, colorWidth, CV_8UC4, &colorBuffer[0] );
+
+    // Resize Image
+    const double scale = 0.5;
+    if( !decodeRegions || replayer.isOpened() ){
+        cv::resize( colorMat, resizeMat, cv::Size(), scale, scale );
+        return;
+    }
+
+    // Compose Image
+    composeColor( resizeMat, scale );
+}
+
+// Compose Color from Preview and Decoded Regions
+// Preview is enlarged to whole image, and decoded regions are reduced over it, so that faces keep detail of full resolution.
+inline void Kinect::composeColor( cv::Mat& image, const double scale )
+{
+    // Enlarge Preview
+    const cv::Mat previewMat( decoder.getPreviewHeight(), decoder.getPreviewWidth(), CV_8UC4, const_cast<uint8_t*>( decoder.getPreview() ) );
+    cv::resize( previewMat, image, cv::Size( static_cast<int>( colorWidth * scale ), static_cast<int>( colorHeight * scale ) ) );
+
+    // Reduce Decoded Regions into Image
+    for( const ColorRegionDecoder::Region& region : decoder.getRegions() ){
+        const cv::Rect source( region.left, region.top, region.right - region.left, region.bottom - region.top );
+        const cv::Rect target = cv::Rect( cv::Point( cvRound( region.left * scale ), cvRound( region.top * scale ) ), cv::Point( cvRound( region.right * scale ), cvRound( region.bottom * scale ) ) ) & cv::Rect( 0, 0, image.cols, image.rows );
+        if( target.area() == 0 ){
+            continue;
+        }
+
+        cv::Mat targetMat = image( target );
+        cv::resize( colorMat( source ), targetMat, target.size(), 0.0, 0.0, cv::INTER_AREA );
+    }
 }
 
 // Draw Face
 inline void Kinect::drawFace()
 {
-    if( colorMat.empty() ){
+    if( resizeMat.empty() ){
         return;
     }
 
+    const double scale = static_cast<double>( resizeMat.cols ) / colorWidth;
+
     for( int count = 0; count < BODY_COUNT; count++ ){
-        const ComPtr<IFaceFrameResult> result = results[count];
-        if( result == nullptr ){
+        const FaceSnapshot::Face& face = faces.faces[count];
+        if( !face.tracked ){
             continue;
         }
 
-        // Retrieve Face Points
-        std::array<PointF, FacePointType::FacePointType_Count> facePoints;
-        ERROR_CHECK( result->GetFacePointsInColorSpace( FacePointType::FacePointType_Count, &facePoints[0] ) );
-        drawFacePoints( colorMat, facePoints, 5, colors[count] );
+        // Draw Face Points
+        drawFacePoints( resizeMat, face.points, scale, 5, colors[count] );
 
-        // Retrieve Face Bounding Box
-        RectI boundingBox;
-        ERROR_CHECK( result->get_FaceBoundingBoxInColorSpace( &boundingBox ) );
-        drawFaceBoundingBox( colorMat, boundingBox, colors[count] );
+        // Draw Face Bounding Box
+        drawFaceBoundingBox( resizeMat, face.box, scale, colors[count] );
 
-        // Retrieve Face Rotation Quaternion
-        Vector4 rotationQuaternion;
-        ERROR_CHECK( result->get_FaceRotationQuaternion( &rotationQuaternion ) );
-        drawFaceRotation( colorMat, rotationQuaternion, boundingBox, 1.0, colors[count] );
+        // Draw Face Rotation
+        drawFaceRotation( resizeMat, face.pose, face.box, scale, 1.0, colors[count], 1 );
 
-        // Retrieve Face Properties
-        std::array<DetectionResult, FaceProperty::FaceProperty_Count> detectionResults;
-        ERROR_CHECK( result->GetFaceProperties( FaceProperty::FaceProperty_Count, &detectionResults[0] ) );
-        drawFaceProperties( colorMat, detectionResults, boundingBox, 1.0, colors[count] );
+        // Draw Face Properties
+        drawFaceProperties( resizeMat, face.properties, face.box, scale, 1.0, colors[count], 1 );
     }
 }
 
 // Draw Face Points
-inline void Kinect::drawFacePoints( cv::Mat& image, const std::array<PointF, FacePointType::FacePointType_Count>& points, const int radius, const cv::Vec3b& color, const int thickness )
+inline void Kinect::drawFacePoints( cv::Mat& image, const float points[][2], const double scale, const int radius, const cv::Vec3b& color, const int thickness )
 {
     if( image.empty() ){
         return;
     }
 
-    // Draw Points
-    for( const PointF point : points ){
-        const int x = static_cast<int>( point.X + 0.5f );
-        const int y = static_cast<int>( point.Y + 0.5f );
-        cv::circle( image, cv::Point( x, y ), radius, static_cast<cv::Scalar>( color ), thickness, cv::LINE_AA );
+    // Draw Points ( points and radius are scaled from color resolution )
+    for( int point = 0; point < FaceSnapshot::POINTS; point++ ){
+        const int x = cvRound( points[point][0] * scale );
+        const int y = cvRound( points[point][1] * scale );
+        cv::circle( image, cv::Point( x, y ), std::max( cvRound( radius * scale ), 1 ), static_cast<cv::Scalar>( color ), thickness, cv::LINE_AA );
     }
 }
 
 // Draw Face Bounding Box
-inline void Kinect::drawFaceBoundingBox( cv::Mat& image, const RectI& box, const cv::Vec3b& color, const int thickness )
+inline void Kinect::drawFaceBoundingBox( cv::Mat& image, const int32_t box[4], const double scale, const cv::Vec3b& color, const int thickness )
 {
     if( image.empty() ){
         return;
     }
 
-    // Draw Bounding Box
-    const int width = box.Right - box.Left;
-    const int height = box.Bottom - box.Top;
-    cv::rectangle( image, cv::Rect( box.Left, box.Top, width, height ), color, thickness, cv::LINE_AA );
+    // Draw Bounding Box ( Left, Top, Right, Bottom )
+    const cv::Point topLeft( cvRound( box[0] * scale ), cvRound( box[1] * scale ) );
+    const cv::Point bottomRight( cvRound( box[2] * scale ), cvRound( box[3] * scale ) );
+    cv::rectangle( image, cv::Rect( topLeft, bottomRight ), color, thickness, cv::LINE_AA );
 }
 
-// Draw Face Rotation Quaternion
-inline void Kinect::drawFaceRotation( cv::Mat& image, Vector4& quaternion, const RectI& box, const double fontScale,const cv::Vec3b& color, const int thickness )
+// Draw Face Rotation
+inline void Kinect::drawFaceRotation( cv::Mat& image, const float pose[3], const int32_t box[4], const double scale, const double fontScale, const cv::Vec3b& color, const int thickness )
 {
     if( image.empty() ){
         return;
     }
 
-    // Convert Quaternion to Degree
-    int pitch, yaw, roll;
-    quaternion2degree( &quaternion, &pitch, &yaw, &roll );
-
-    // Draw Rotation
+    // Draw Rotation ( smoothed pitch, yaw and roll [deg] )
     const int offset = 30;
-    if( box.Left && box.Bottom ){
-        std::string rotation = "Pitch, Yaw, Roll : " + std::to_string( pitch ) + ", " + std::to_string( yaw ) + ", " + std::to_string( roll );
-        cv::putText( image, rotation, cv::Point( box.Left, box.Bottom + offset ), cv::FONT_HERSHEY_SIMPLEX, fontScale, color, thickness, cv::LINE_AA );
+    if( box[0] && box[3] ){
+        std::string rotation = cv::format( "Pitch, Yaw, Roll : %.1f, %.1f, %.1f", pose[0], pose[1], pose[2] );
+        cv::putText( image, rotation, cv::Point( cvRound( box[0] * scale ), cvRound( ( box[3] + offset ) * scale ) ), cv::FONT_HERSHEY_SIMPLEX, fontScale * scale, color, thickness, cv::LINE_AA );
     }
 }
 
-// Convert Quaternion to Degree
-inline void Kinect::quaternion2degree( const Vector4* quaternion, int* pitch, int* yaw, int* roll )
-{
-    const double x = quaternion->x;
-    const double y = quaternion->y;
-    const double z = quaternion->z;
-    const double w = quaternion->w;
-
-    *pitch = static_cast<int>( std::atan2( 2 * ( y * z + w * x ), w * w - x * x - y * y + z * z ) / M_PI * 180.0f );
-    *yaw = static_cast<int>( std::asin( 2 * ( w * y - x * z ) ) / M_PI * 180.0f );
-    *roll = static_cast<int>( std::atan2( 2 * ( x * y + w * z ), w * w + x * x - y * y - z * z ) / M_PI * 180.0f );
-}
-
 // Draw Face Properties
-inline void Kinect::drawFaceProperties( cv::Mat& image, std::array<DetectionResult, FaceProperty::FaceProperty_Count>& results, const RectI& box, const double fontScale, const cv::Vec3b& color, const int thickness )
+inline void Kinect::drawFaceProperties( cv::Mat& image, const uint8_t properties[], const int32_t box[4], const double scale, const double fontScale, const cv::Vec3b& color, const int thickness )
 {
     if( image.empty() ){
         return;
@@ -386,16 +694,16 @@ inline void Kinect::drawFaceProperties( cv::Mat& image, std::array<DetectionResu
     // Draw Properties
     int offset = 30;
     for( int count = 0; count < FaceProperty::FaceProperty_Count; count++ ){
-        if( box.Left && box.Bottom ){
+        if( box[0] && box[3] ){
             offset += 30;
-            std::string result = labels[count] + " : " + result2string( results[count] );
-            cv::putText( image, result, cv::Point( box.Left, box.Bottom + offset ), cv::FONT_HERSHEY_SIMPLEX, fontScale, color, thickness, cv::LINE_AA );
+            std::string result = labels[count] + " : " + result2string( static_cast<DetectionResult>( properties[count] ) );
+            cv::putText( image, result, cv::Point( cvRound( box[0] * scale ), cvRound( ( box[3] + offset ) * scale ) ), cv::FONT_HERSHEY_SIMPLEX, fontScale * scale, color, thickness, cv::LINE_AA );
         }
     }
 }
 
 // Convert Detection Result to String
-inline std::string Kinect::result2string( DetectionResult& result )
+inline std::string Kinect::result2string( const DetectionResult result )
 {
     switch( result ){
         case DetectionResult::DetectionResult_Yes:
@@ -423,15 +731,10 @@ void Kinect::show()
 // Show Face
 inline void Kinect::showFace()
 {
-    if( colorMat.empty() ){
+    if( resizeMat.empty() ){
         return;
     }
 
-    // Resize Image
-    cv::Mat resizeMat;
-    const double scale = 0.5;
-    cv::resize( colorMat, resizeMat, cv::Size(), scale, scale );
-
     // Show Image
     cv::imshow( "Face", resizeMat );
 }
\ No newline at end of file
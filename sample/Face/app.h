@@ -5,9 +5,17 @@
 #include <Kinect.h>
 #include <Kinect.Face.h>
 #include <opencv2/opencv.hpp>
+#include "TrackingIdManager.h"
+#include "FaceSnapshot.h"
+#include "HeadPoseFilter.h"
+#include "ColorRegionDecoder.h"
 
 #include <vector>
 #include <array>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <exception>
 
 #include <wrl/client.h>
 using namespace Microsoft::WRL;
@@ -35,17 +43,36 @@ private:
     unsigned int colorBytesPerPixel;
     cv::Mat colorMat;
 
+    // Color Region Decoder ( faces are decoded at full resolution, and whole frame at 1/4 resolution as preview )
+    ColorRegionDecoder decoder;
+    bool decodeRegions;
+    cv::Mat resizeMat;
+
     // Body Buffer
     std::array<IBody*, BODY_COUNT> bodies;
 
-    // Face Buffer
-    std::array<ComPtr<IFaceFrameResult>, BODY_COUNT> results;
+    // Tracking ID Manager ( assign bodies to face frame readers )
+    TrackingIdManager trackingIdManager;
+
+    // Face Stage ( bodies and faces are retrieved on worker thread, and published as snapshot )
+    FaceSnapshot snapshot;
+    HeadPoseFilter headPoseFilter;
+    FaceMailbox mailbox;
+    std::thread faceThread;
+    std::atomic<bool> running;
+    std::atomic<bool> failed;
+    std::exception_ptr error;
+
+    // Face Snapshot ( received from face stage or replay, drawing and recording never touch COM )
+    FaceSnapshot faces;
+    FaceSnapshotRecorder recorder;
+    FaceSnapshotReplayer replayer;
     std::array<std::string, FaceProperty::FaceProperty_Count> labels;
     std::array<cv::Vec3b, BODY_COUNT> colors;
 
 public:
-    // Constructor
-    Kinect();
+    // Constructor ( replay recorded face snapshot file instead of sensor if specified )
+    Kinect( const std::string& replay = "", const bool realtime = true );
 
     // Destructor
     ~Kinect();
@@ -69,6 +96,9 @@ private:
     // Initialize Face
     inline void initializeFace();
 
+    // Initialize Replay
+    inline void initializeReplay();
+
     // Finalize
     void finalize();
 
@@ -78,11 +108,29 @@ private:
     // Update Color
     inline void updateColor();
 
-    // Update Body
-    inline void updateBody();
+    // Decode Color ( return false if raw format is not YUY2 )
+    inline bool decodeColor( const ComPtr<IColorFrame>& colorFrame );
+
+    // Benchmark Color
+    inline void benchmarkColor( const ComPtr<IColorFrame>& colorFrame );
+
+    // Update Snapshot
+    inline void updateSnapshot();
+
+    // Toggle Recording
+    void toggleRecording();
 
-    // Update Face
-    inline void updateFace();
+    // Face Stage
+    void faceStage();
+
+    // Update Body ( face stage )
+    inline bool updateBody();
+
+    // Update Face ( face stage )
+    inline bool updateFace();
+
+    // Retrieve Face Result ( face stage )
+    inline void retrieveFace( const ComPtr<IFaceFrameResult>& result, FaceSnapshot::Face& face );
 
     // Draw Data
     void draw();
@@ -90,26 +138,26 @@ private:
     // Draw Color
     inline void drawColor();
 
+    // Compose Color from Preview and Decoded Regions
+    inline void composeColor( cv::Mat& image, const double scale );
+
     // Draw Face
     inline void drawFace();
 
     // Draw Face Points
-    inline void drawFacePoints( cv::Mat& image, const std::array<PointF, FacePointType::FacePointType_Count>& points, const int radius, const cv::Vec3b& color, const int thickness = -1 );
+    inline void drawFacePoints( cv::Mat& image, const float points[][2], const double scale, const int radius, const cv::Vec3b& color, const int thickness = -1 );
 
     // Draw Face Bounding Box
-    inline void drawFaceBoundingBox( cv::Mat& image, const RectI& box, const cv::Vec3b& color, const int thickness = 1 );
+    inline void drawFaceBoundingBox( cv::Mat& image, const int32_t box[4], const double scale, const cv::Vec3b& color, const int thickness = 1 );
 
     // Draw Face Rotation
-    inline void drawFaceRotation( cv::Mat& image, Vector4& quaternion, const RectI& box, const double fontScale, const cv::Vec3b& color, const int thickness = 2 );
-
-    // Convert Quaternion to Degree
-    inline void quaternion2degree( const Vector4* quaternion, int* pitch, int* yaw, int* roll );
+    inline void drawFaceRotation( cv::Mat& image, const float pose[3], const int32_t box[4], const double scale, const double fontScale, const cv::Vec3b& color, const int thickness = 2 );
 
     // Draw Face Properties
-    inline void drawFaceProperties( cv::Mat& image, std::array<DetectionResult, FaceProperty::FaceProperty_Count>& detections, const RectI& box, const double fontScale, const cv::Vec3b& color, const int thickness = 2 );
+    inline void drawFaceProperties( cv::Mat& image, const uint8_t properties[], const int32_t box[4], const double scale, const double fontScale, const cv::Vec3b& color, const int thickness = 2 );
 
     // Convert Detection Result to String
-    inline std::string Kinect::result2string( DetectionResult& result );
+    inline std::string Kinect::result2string( const DetectionResult result );
 
     // Show Data
     void show();
@@ -1,12 +1,28 @@
 #include <iostream>
 #include <sstream>
+#include <string>
 
 #include "app.h"
+#include "HeadPoseBenchmark.h"
 
 int main( int argc, char* argv[] )
 {
     try{
-        Kinect kinect;
+        // Benchmark Head Pose Conversion and Smoothing ( accuracy versus speed against scalar reference )
+        if( argc > 1 && std::string( argv[1] ) == "benchmark" ){
+            HeadPoseBenchmark benchmark;
+            benchmark.run();
+            benchmark.print( std::cout );
+            return 0;
+        }
+
+        // Choose Replay ( recorded face snapshot file, sensor if not specified )
+        const std::string replay = ( argc > 1 ) ? argv[1] : "";
+
+        // Choose Pacing of Replay ( realtime : paced by recorded time, max : maximum speed )
+        const bool realtime = !( argc > 2 && std::string( argv[2] ) == "max" );
+
+        Kinect kinect( replay, realtime );
         kinect.run();
     } catch( std::exception& ex ){
         std::cout << ex.what() << std::endl;
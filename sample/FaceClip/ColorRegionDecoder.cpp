@@ -0,0 +1,164 @@
+#include "ColorRegionDecoder.h"
+
+#include <algorithm>
+
+// Saturate to 8 bits
+static inline uint8_t saturate( const int value )
+{
+    return static_cast<uint8_t>( ( value < 0 ) ? 0 : ( ( value > 255 ) ? 255 : value ) );
+}
+
+// Convert Pixel ( chroma terms are shared by pair of pixels )
+static inline void convert( const int luma, const int red, const int green, const int blue, uint8_t* pixel )
+{
+    const int y = 298 * ( luma - 16 ) + 128;
+    pixel[0] = saturate( ( y + blue ) >> 8 );
+    pixel[1] = saturate( ( y + green ) >> 8 );
+    pixel[2] = saturate( ( y + red ) >> 8 );
+    pixel[3] = 255;
+}
+
+// Convert Pairs of Pixels ( Y0, U, Y1, V ) to BGRA
+static inline void convertRow( const uint8_t* source, uint8_t* destination, const int pairs )
+{
+    for( int pair = 0; pair < pairs; pair++, source += 4, destination += 8 ){
+        const int u = source[1] - 128;
+        const int v = source[3] - 128;
+        const int red = 409 * v;
+        const int green = -100 * u - 208 * v;
+        const int blue = 516 * u;
+        convert( source[0], red, green, blue, destination );
+        convert( source[2], red, green, blue, destination + 4 );
+    }
+}
+
+// Constructor
+ColorRegionDecoder::ColorRegionDecoder()
+    : width( 0 ),
+      height( 0 ),
+      factor( 0 ),
+      pixels( 0 )
+{
+}
+
+// Initialize
+void ColorRegionDecoder::initialize( const int width, const int height, const int factor )
+{
+    this->width = width;
+    this->height = height;
+    this->factor = ( factor == 2 || factor == 4 || factor == 8 ) ? factor : 0;
+
+    // Allocate Preview ( opaque black until first decode )
+    preview.assign( static_cast<size_t>( getPreviewWidth() ) * getPreviewHeight() * 4, 0 );
+    for( size_t index = 3; index < preview.size(); index += 4 ){
+        preview[index] = 255;
+    }
+
+    requests.clear();
+    regions.clear();
+    pixels = 0;
+}
+
+// Clear Requested Regions
+void ColorRegionDecoder::clear()
+{
+    requests.clear();
+}
+
+// Request Region
+void ColorRegionDecoder::request( const int left, const int top, const int right, const int bottom )
+{
+    // Clamp to Image and Align to Pairs of Pixels
+    Region region;
+    region.left = std::max( left, 0 ) & ~1;
+    region.top = std::max( top, 0 );
+    region.right = std::min( ( right + 1 ) & ~1, width & ~1 );
+    region.bottom = std::min( bottom, height );
+    if( region.left >= region.right || region.top >= region.bottom ){
+        return;
+    }
+
+    requests.push_back( region );
+}
+
+// Merge Requests into Regions
+// Overlapping or touching regions are replaced by their bounding box, which may overlap other regions, so scan restarts after each merge.
+void ColorRegionDecoder::merge()
+{
+    regions.clear();
+    for( const Region& request : requests ){
+        Region region = request;
+        size_t index = 0;
+        while( index < regions.size() ){
+            const Region& other = regions[index];
+            if( region.right < other.left || other.right < region.left || region.bottom < other.top || other.bottom < region.top ){
+                index++;
+                continue;
+            }
+
+            region.left = std::min( region.left, other.left );
+            region.top = std::min( region.top, other.top );
+            region.right = std::max( region.right, other.right );
+            region.bottom = std::max( region.bottom, other.bottom );
+            regions[index] = regions.back();
+            regions.pop_back();
+            index = 0;
+        }
+        regions.push_back( region );
+    }
+}
+
+// Decode Raw Frame into Regions of Image and Preview
+void ColorRegionDecoder::decode( const uint8_t* source, uint8_t* image )
+{
+    // Merge Requests
+    merge();
+
+    const size_t sourceStride = static_cast<size_t>( width ) * 2;
+    const size_t imageStride = static_cast<size_t>( width ) * 4;
+    pixels = 0;
+
+    // Convert Regions at Full Resolution
+    for( const Region& region : regions ){
+        const int pairs = ( region.right - region.left ) / 2;
+
+        #pragma omp parallel for
+        for( int y = region.top; y < region.bottom; y++ ){
+            convertRow( source + y * sourceStride + region.left * 2, image + y * imageStride + region.left * 4, pairs );
+        }
+        pixels += static_cast<size_t>( region.right - region.left ) * ( region.bottom - region.top );
+    }
+
+    if( !factor ){
+        return;
+    }
+
+    // Convert Preview ( one pair of pixels per preview pixel, luma of pair is averaged )
+    const int previewWidth = getPreviewWidth();
+    const int previewHeight = getPreviewHeight();
+
+    #pragma omp parallel for
+    for( int y = 0; y < previewHeight; y++ ){
+        const uint8_t* pair = source + static_cast<size_t>( y ) * factor * sourceStride;
+        uint8_t* pixel = &preview[static_cast<size_t>( y ) * previewWidth * 4];
+        for( int x = 0; x < previewWidth; x++, pair += factor * 2, pixel += 4 ){
+            const int u = pair[1] - 128;
+            const int v = pair[3] - 128;
+            convert( ( pair[0] + pair[2] + 1 ) >> 1, 409 * v, -100 * u - 208 * v, 516 * u, pixel );
+        }
+    }
+    pixels += static_cast<size_t>( previewWidth ) * previewHeight;
+}
+
+// Check Rectangle is inside Decoded Regions
+// Decoded regions never touch each other, so rectangle inside their union is inside one of them.
+bool ColorRegionDecoder::contains( const int left, const int top, const int right, const int bottom ) const
+{
+    for( const Region& region : regions ){
+        if( region.left <= left && right <= region.right && region.top <= top && bottom <= region.bottom ){
+            return true;
+        }
+    }
+
+    return false;
+}
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include "FaceCropBatcher.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Canonical Face Points of 112x112 Crop ( eyes, nose and mouth corners in image order from left to right )
+static const float TEMPLATE[FaceCropBatcher::POINTS][2] = {
+    { 38.2946f, 51.6963f },
+    { 73.5318f, 51.5014f },
+    { 56.0252f, 71.7366f },
+    { 41.5493f, 92.3655f },
+    { 70.7299f, 92.2041f }
+};
+
+// Constructor
+FaceCropBatcher::FaceCropBatcher( const int size, const Layout layout, const int capacity, const int count )
+    : layout( layout ),
+      size( size ),
+      capacity( capacity ),
+      batches( count )
+{
+    // Scale Canonical Points to Crop Size
+    const float scale = size / 112.0f;
+    for( int point = 0; point < POINTS; point++ ){
+        canonical[point][0] = TEMPLATE[point][0] * scale;
+        canonical[point][1] = TEMPLATE[point][1] * scale;
+    }
+
+    // Allocate Batches
+    const size_t elements = static_cast<size_t>( capacity ) * 3 * size * size;
+    for( Batch& batch : batches ){
+        batch.layout = layout;
+        batch.size = size;
+        batch.count = 0;
+        batch.capacity = capacity;
+        batch.entries.resize( capacity );
+        if( layout == NHWC ){
+            batch.pixels.resize( elements );
+        }
+        else{
+            batch.tensor.resize( elements );
+        }
+        pool.push_back( &batch );
+    }
+}
+
+// Crop Faces from Image
+FaceCropBatcher::Batch* FaceCropBatcher::crop( const uint8_t* image, const int width, const int height, const int channels, const size_t stride, const Face* faces, const int count )
+{
+    // Acquire Batch from Pool
+    Batch* batch = nullptr;
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        if( pool.empty() ){
+            return nullptr;
+        }
+        batch = pool.back();
+        pool.pop_back();
+    }
+
+    // Align Each Face into Own Range of Batch
+    batch->count = std::min( count, capacity );
+    #pragma omp parallel for
+    for( int index = 0; index < batch->count; index++ ){
+        const Face& face = faces[index];
+        Entry& entry = batch->entries[index];
+        entry.slot = face.slot;
+        entry.trackingId = face.trackingId;
+        entry.timestamp = face.timestamp;
+        estimate( face.points, entry.transform );
+        warp( image, width, height, channels, stride, entry.transform, *batch, index );
+    }
+
+    return batch;
+}
+
+// Release Batch to Pool
+void FaceCropBatcher::release( Batch* batch )
+{
+    if( batch == nullptr ){
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock( mutex );
+    pool.push_back( batch );
+}
+
+// Retrieve Number of Free Batches
+int FaceCropBatcher::available()
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    return static_cast<int>( pool.size() );
+}
+
+// Estimate Similarity Transform
+void FaceCropBatcher::estimate( const float points[POINTS][2], float transform[6] ) const
+{
+    // Sort Pairs of Eyes and Mouth Corners by X, so that mirrored image is aligned to same template
+    float target[POINTS][2];
+    const int order[POINTS] = {
+        points[0][0] <= points[1][0] ? 0 : 1, points[0][0] <= points[1][0] ? 1 : 0,
+        2,
+        points[3][0] <= points[4][0] ? 3 : 4, points[3][0] <= points[4][0] ? 4 : 3
+    };
+    for( int point = 0; point < POINTS; point++ ){
+        target[point][0] = points[order[point]][0];
+        target[point][1] = points[order[point]][1];
+    }
+
+    // Centroids
+    double sourceX = 0.0, sourceY = 0.0, targetX = 0.0, targetY = 0.0;
+    for( int point = 0; point < POINTS; point++ ){
+        sourceX += canonical[point][0];
+        sourceY += canonical[point][1];
+        targetX += target[point][0];
+        targetY += target[point][1];
+    }
+    sourceX /= POINTS;
+    sourceY /= POINTS;
+    targetX /= POINTS;
+    targetY /= POINTS;
+
+    // Rotation and Scale ( [a -b; b a] ) that minimizes squared error of centered points
+    double dot = 0.0, cross = 0.0, norm = 0.0;
+    for( int point = 0; point < POINTS; point++ ){
+        const double x = canonical[point][0] - sourceX;
+        const double y = canonical[point][1] - sourceY;
+        const double u = target[point][0] - targetX;
+        const double v = target[point][1] - targetY;
+        dot += x * u + y * v;
+        cross += x * v - y * u;
+        norm += x * x + y * y;
+    }
+    const double a = dot / norm;
+    const double b = cross / norm;
+
+    transform[0] = static_cast<float>( a );
+    transform[1] = static_cast<float>( -b );
+    transform[2] = static_cast<float>( targetX - ( a * sourceX - b * sourceY ) );
+    transform[3] = static_cast<float>( b );
+    transform[4] = static_cast<float>( a );
+    transform[5] = static_cast<float>( targetY - ( b * sourceX + a * sourceY ) );
+}
+
+// Warp Image into Crop
+void FaceCropBatcher::warp( const uint8_t* image, const int width, const int height, const int channels, const size_t stride, const float transform[6], Batch& batch, const int index ) const
+{
+    const size_t area = static_cast<size_t>( size ) * size;
+    uint8_t* pixels = ( layout == NHWC ) ? batch.image( index ) : nullptr;
+    float* planes = ( layout == NCHW ) ? batch.planes( index ) : nullptr;
+
+    for( int v = 0; v < size; v++ ){
+        for( int u = 0; u < size; u++ ){
+            // Position in Image ( clamped to border )
+            const float x = std::min( std::max( transform[0] * u + transform[1] * v + transform[2], 0.0f ), static_cast<float>( width - 1 ) );
+            const float y = std::min( std::max( transform[3] * u + transform[4] * v + transform[5], 0.0f ), static_cast<float>( height - 1 ) );
+            const int x0 = static_cast<int>( x );
+            const int y0 = static_cast<int>( y );
+            const int x1 = std::min( x0 + 1, width - 1 );
+            const int y1 = std::min( y0 + 1, height - 1 );
+            const float fx = x - x0;
+            const float fy = y - y0;
+
+            // Bilinear Interpolation of BGR
+            const uint8_t* row0 = image + y0 * stride;
+            const uint8_t* row1 = image + y1 * stride;
+            const uint8_t* p00 = row0 + x0 * channels;
+            const uint8_t* p01 = row0 + x1 * channels;
+            const uint8_t* p10 = row1 + x0 * channels;
+            const uint8_t* p11 = row1 + x1 * channels;
+
+            const size_t offset = static_cast<size_t>( v ) * size + u;
+            for( int channel = 0; channel < 3; channel++ ){
+                const float top = p00[channel] + ( p01[channel] - p00[channel] ) * fx;
+                const float bottom = p10[channel] + ( p11[channel] - p10[channel] ) * fx;
+                const float value = top + ( bottom - top ) * fy;
+
+                if( pixels != nullptr ){
+                    pixels[offset * 3 + channel] = static_cast<uint8_t>( value + 0.5f );
+                }
+                else{
+                    planes[( 2 - channel ) * area + offset] = ( value - 127.5f ) / 128.0f;
+                }
+            }
+        }
+    }
+}
\ No newline at end of file
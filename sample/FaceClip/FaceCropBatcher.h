@@ -0,0 +1,109 @@
+#ifndef __FACE_CROP_BATCHER__
+#define __FACE_CROP_BATCHER__
+
+#include <vector>
+#include <mutex>
+#include <cstdint>
+
+// Face Crop Batcher
+// Each face is aligned to canonical fixed size crop ( e.g. 112x112 ) by similarity transform estimated from five face points.
+// Crops of all faces in a frame are written into one contiguous batch buffer, batch buffers are pre-allocated in pool and reused.
+// Pixels outside the image are clamped to the border, so crops near image edges are valid without padding the image.
+// Downstream recognisers receive a batch without allocation per frame, and release it to the pool when they are done.
+// This class has no dependency on Kinect SDK and OpenCV.
+class FaceCropBatcher
+{
+public:
+    // Number of Face Points ( same order as FacePointType, EyeLeft, EyeRight, Nose, MouthCornerLeft, MouthCornerRight )
+    static const int POINTS = 5;
+
+    // Layout of Batch Buffer
+    enum Layout
+    {
+        NHWC, // uint8_t, BGR interleaved ( same as CV_8UC3 )
+        NCHW  // float, RGB planar, normalized to ( value - 127.5 ) / 128
+    };
+
+    // Face to Crop
+    struct Face
+    {
+        int slot;                // Face reader slot
+        uint64_t trackingId;
+        int64_t timestamp;       // RelativeTime ( 100 [ns] unit )
+        float points[POINTS][2]; // X, Y in image
+    };
+
+    // Crop in Batch
+    struct Entry
+    {
+        int slot;
+        uint64_t trackingId;
+        int64_t timestamp;
+        float transform[6]; // Affine transform from crop to image ( x = [0] * u + [1] * v + [2], y = [3] * u + [4] * v + [5] )
+    };
+
+    // Batch of Crops
+    struct Batch
+    {
+        Layout layout;
+        int size;     // Width and height of crop
+        int count;    // Number of crops
+        int capacity; // Maximum number of crops
+        std::vector<Entry> entries;
+        std::vector<uint8_t> pixels; // NHWC
+        std::vector<float> tensor;   // NCHW
+
+        // Retrieve Crop ( size * size * 3 elements )
+        uint8_t* image( const int index )
+        {
+            return &pixels[static_cast<size_t>( index ) * size * size * 3];
+        }
+
+        float* planes( const int index )
+        {
+            return &tensor[static_cast<size_t>( index ) * 3 * size * size];
+        }
+    };
+
+private:
+    Layout layout;
+    int size;
+    int capacity;
+
+    // Canonical Face Points in Crop
+    float canonical[POINTS][2];
+
+    // Pool of Batches
+    std::vector<Batch> batches;
+    std::vector<Batch*> pool;
+    std::mutex mutex;
+
+public:
+    // Constructor ( size of crop, layout of batch buffer, maximum faces per batch, number of batches in pool )
+    FaceCropBatcher( const int size = 112, const Layout layout = NHWC, const int capacity = 6, const int count = 3 );
+
+    // Crop Faces from Image ( BGR or BGRA interleaved, channels is 3 or 4, stride is bytes per row )
+    // Return batch acquired from pool, or nullptr if all batches are in use ( frame should be dropped ).
+    Batch* crop( const uint8_t* image, const int width, const int height, const int channels, const size_t stride, const Face* faces, const int count );
+
+    // Release Batch to Pool
+    void release( Batch* batch );
+
+    // Retrieve Number of Free Batches
+    int available();
+
+    // Retrieve Size of Crop
+    int getSize() const
+    {
+        return size;
+    }
+
+    // Estimate Similarity Transform from Canonical Points to Face Points ( least squares )
+    void estimate( const float points[POINTS][2], float transform[6] ) const;
+
+private:
+    // Warp Image into Crop with Bilinear Interpolation
+    void warp( const uint8_t* image, const int width, const int height, const int channels, const size_t stride, const float transform[6], Batch& batch, const int index ) const;
+};
+
+#endif // __FACE_CROP_BATCHER__
\ No newline at end of file
@@ -0,0 +1,209 @@
+#include "FaceCropWriter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+// Conversion from Radian to Degree
+static const double DEGREE = 180.0 / 3.14159265358979323846;
+
+// Constructor
+FaceCropWriter::FaceCropWriter()
+    : size( 0 ),
+      head( 0 ),
+      count( 0 ),
+      running( false ),
+      submitted( 0 ),
+      written( 0 ),
+      dropped( 0 ),
+      failed( 0 )
+{
+}
+
+// Destructor
+FaceCropWriter::~FaceCropWriter()
+{
+    // Close Writer
+    close();
+}
+
+// Open Writer
+bool FaceCropWriter::open( const std::string& directory, const int size, const std::string& extension, const int threadCount, const int capacity )
+{
+    close();
+
+    // Open Manifest
+    manifest.open( directory + "/manifest.csv", std::ios::trunc );
+    if( !manifest.is_open() ){
+        return false;
+    }
+    manifest << "file,trackingId,timestamp,pitch,yaw,roll,qx,qy,qz,qw,"
+             << "happy,engaged,wearingGlasses,leftEyeClosed,rightEyeClosed,mouthOpen,mouthMoved,lookingAway" << std::endl;
+
+    this->directory = directory;
+    this->extension = extension;
+    this->size = size;
+
+    // Encoding Parameters
+    parameters.clear();
+    if( extension == ".jpg" || extension == ".jpeg" ){
+        parameters = { cv::IMWRITE_JPEG_QUALITY, 95 };
+    }
+    else if( extension == ".png" ){
+        parameters = { cv::IMWRITE_PNG_COMPRESSION, 1 };
+    }
+
+    // Allocate Queue
+    items.resize( capacity );
+    freeItems.clear();
+    for( int index = 0; index < capacity; index++ ){
+        items[index].pixels.resize( static_cast<size_t>( size ) * size * 3 );
+        freeItems.push_back( index );
+    }
+    pending.assign( capacity, 0 );
+    head = 0;
+    count = 0;
+
+    // Reset Counters
+    submitted = 0;
+    written = 0;
+    dropped = 0;
+    failed = 0;
+
+    // Start Thread Pool
+    running = true;
+    for( int index = 0; index < threadCount; index++ ){
+        threads.push_back( std::thread( &FaceCropWriter::worker, this ) );
+    }
+
+    return true;
+}
+
+// Close Writer
+void FaceCropWriter::close()
+{
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        running = false;
+    }
+    condition.notify_all();
+
+    for( std::thread& thread : threads ){
+        if( thread.joinable() ){
+            thread.join();
+        }
+    }
+    threads.clear();
+
+    if( manifest.is_open() ){
+        manifest.close();
+    }
+}
+
+// Push Crop
+bool FaceCropWriter::push( const uint8_t* image, const Record& record )
+{
+    submitted++;
+
+    // Take Free Item ( drop if queue is full )
+    int index;
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        if( !running || freeItems.empty() ){
+            dropped++;
+            return false;
+        }
+        index = freeItems.back();
+        freeItems.pop_back();
+    }
+
+    // Copy Crop into Item ( item is owned by this thread until it is queued )
+    Item& item = items[index];
+    item.record = record;
+    std::memcpy( &item.pixels[0], image, item.pixels.size() );
+
+    // Queue Item
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        pending[( head + count ) % pending.size()] = index;
+        count++;
+    }
+    condition.notify_one();
+
+    return true;
+}
+
+// Retrieve Number of Crops in Queue
+int FaceCropWriter::getPending()
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    return count;
+}
+
+// Worker Thread
+void FaceCropWriter::worker()
+{
+    while( true ){
+        // Wait for Pending Item ( pending items are written before exit )
+        int index;
+        {
+            std::unique_lock<std::mutex> lock( mutex );
+            condition.wait( lock, [ & ](){
+                return !running || count > 0;
+            } );
+            if( count == 0 ){
+                break;
+            }
+            index = pending[head];
+            head = ( head + 1 ) % pending.size();
+            count--;
+        }
+
+        // Encode and Write Crop
+        const Item& item = items[index];
+        const std::string file = std::to_string( item.record.trackingId ) + "_" + std::to_string( item.record.timestamp ) + extension;
+        const cv::Mat image( size, size, CV_8UC3, const_cast<uint8_t*>( &item.pixels[0] ) );
+        bool success = false;
+        try{
+            success = cv::imwrite( directory + "/" + file, image, parameters );
+        } catch( cv::Exception& ){
+            success = false;
+        }
+
+        if( success ){
+            writeManifest( file, item.record );
+            written++;
+        }
+        else{
+            failed++;
+        }
+
+        // Return Item to Free List
+        {
+            std::lock_guard<std::mutex> lock( mutex );
+            freeItems.push_back( index );
+        }
+    }
+}
+
+// Write Manifest Line
+void FaceCropWriter::writeManifest( const std::string& file, const Record& record )
+{
+    // Convert Quaternion to Degree
+    const double x = record.quaternion[0];
+    const double y = record.quaternion[1];
+    const double z = record.quaternion[2];
+    const double w = record.quaternion[3];
+    const double pitch = std::atan2( 2 * ( y * z + w * x ), w * w - x * x - y * y + z * z ) * DEGREE;
+    const double yaw = std::asin( std::min( std::max( 2 * ( w * y - x * z ), -1.0 ), 1.0 ) ) * DEGREE;
+    const double roll = std::atan2( 2 * ( x * y + w * z ), w * w + x * x - y * y - z * z ) * DEGREE;
+
+    std::lock_guard<std::mutex> lock( manifestMutex );
+    manifest << file << "," << record.trackingId << "," << record.timestamp << ","
+             << pitch << "," << yaw << "," << roll << ","
+             << x << "," << y << "," << z << "," << w;
+    for( int property = 0; property < PROPERTIES; property++ ){
+        manifest << "," << static_cast<int>( record.properties[property] );
+    }
+    manifest << "\n";
+}
\ No newline at end of file
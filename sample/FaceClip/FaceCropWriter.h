@@ -0,0 +1,123 @@
+#ifndef __FACE_CROP_WRITER__
+#define __FACE_CROP_WRITER__
+
+#include <opencv2/opencv.hpp>
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+
+// Asynchronous Face Crop Writer
+// Face crops are copied into bounded queue of pre-allocated items, then encoded ( PNG or JPEG ) and written on small thread pool.
+// Each written crop is appended to manifest ( CSV ) with TrackingId, timestamp, pose and face properties.
+// If queue is full, crop is dropped and counted, so that capture loop never waits for disk or encoder.
+class FaceCropWriter
+{
+public:
+    // Number of Face Properties ( same as FaceProperty_Count )
+    static const int PROPERTIES = 8;
+
+    // Metadata of Crop
+    struct Record
+    {
+        uint64_t trackingId;
+        int64_t timestamp;              // RelativeTime ( 100 [ns] unit )
+        float quaternion[4];            // X, Y, Z, W
+        uint8_t properties[PROPERTIES]; // DetectionResult
+    };
+
+private:
+    // Queue Item ( crop is copied into pixels )
+    struct Item
+    {
+        Record record;
+        std::vector<uint8_t> pixels;
+    };
+
+    // Output
+    std::string directory;
+    std::string extension;
+    std::vector<int> parameters;
+    int size;
+    std::ofstream manifest;
+    std::mutex manifestMutex;
+
+    // Bounded Queue ( free items and pending ring of item indices )
+    std::vector<Item> items;
+    std::vector<int> freeItems;
+    std::vector<int> pending;
+    int head;
+    int count;
+
+    // Thread Pool
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool running;
+
+    // Counters
+    std::atomic<uint64_t> submitted;
+    std::atomic<uint64_t> written;
+    std::atomic<uint64_t> dropped;
+    std::atomic<uint64_t> failed;
+
+public:
+    // Constructor
+    FaceCropWriter();
+
+    // Destructor
+    ~FaceCropWriter();
+
+    // Open Writer ( directory must exist, extension is ".png" or ".jpg", capacity is number of crops in queue )
+    bool open( const std::string& directory, const int size, const std::string& extension = ".png", const int threadCount = 2, const int capacity = 64 );
+
+    // Close Writer ( pending crops are written before threads exit )
+    void close();
+
+    // Check Opened
+    bool isOpened() const
+    {
+        return !threads.empty();
+    }
+
+    // Push Crop ( size * size BGR ), return false if it is dropped because queue is full
+    bool push( const uint8_t* image, const Record& record );
+
+    // Retrieve Counters
+    uint64_t getSubmitted() const
+    {
+        return submitted;
+    }
+
+    uint64_t getWritten() const
+    {
+        return written;
+    }
+
+    uint64_t getDropped() const
+    {
+        return dropped;
+    }
+
+    uint64_t getFailed() const
+    {
+        return failed;
+    }
+
+    // Retrieve Number of Crops in Queue
+    int getPending();
+
+private:
+    // Worker Thread
+    void worker();
+
+    // Write Manifest Line
+    void writeManifest( const std::string& file, const Record& record );
+};
+
+#endif // __FACE_CROP_WRITER__
\ No newline at end of file
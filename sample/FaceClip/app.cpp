@@ -3,13 +3,20 @@
 
 #include <thread>
 #include <chrono>
+#include <iostream>
+#include <limits>
+#include <algorithm>
 #define _USE_MATH_DEFINES
 #include <math.h>
 
 #include <omp.h>
 
+//#define BENCHMARK
+
 // Constructor
 Kinect::Kinect()
+    : decodeRegions( true ),
+      batch( nullptr )
 {
     // Initialize
     initialize();
@@ -41,6 +48,12 @@ void Kinect::run()
         if( key == VK_ESCAPE || GetKeyState( VK_ESCAPE ) < 0 ){
             break;
         }
+        else if( key == 's' ){
+            toggleWriting();
+        }
+        else if( key == 'd' ){
+            decodeRegions = !decodeRegions;
+        }
     }
 }
 
@@ -101,6 +114,9 @@ inline void Kinect::initializeColor()
 
     // Allocation Color Buffer
     colorBuffer.resize( colorWidth * colorHeight * colorBytesPerPixel );
+
+    // Initialize Color Region Decoder ( without preview )
+    decoder.initialize( colorWidth, colorHeight, 0 );
 }
 
 // Initialize Body
@@ -122,7 +138,17 @@ inline void Kinect::initializeFace()
 {
     // Set Face Features to Enable
     DWORD features =
-        FaceFrameFeatures::FaceFrameFeatures_BoundingBoxInColorSpace;
+        FaceFrameFeatures::FaceFrameFeatures_BoundingBoxInColorSpace
+        | FaceFrameFeatures::FaceFrameFeatures_PointsInColorSpace
+        | FaceFrameFeatures::FaceFrameFeatures_RotationOrientation
+        | FaceFrameFeatures::FaceFrameFeatures_Happy
+        | FaceFrameFeatures::FaceFrameFeatures_RightEyeClosed
+        | FaceFrameFeatures::FaceFrameFeatures_LeftEyeClosed
+        | FaceFrameFeatures::FaceFrameFeatures_MouthOpen
+        | FaceFrameFeatures::FaceFrameFeatures_MouthMoved
+        | FaceFrameFeatures::FaceFrameFeatures_LookingAway
+        | FaceFrameFeatures::FaceFrameFeatures_Glasses
+        | FaceFrameFeatures::FaceFrameFeatures_FaceEngagement;
 
     for( int count = 0; count < BODY_COUNT; count++ ){
         // Create Face Sources
@@ -139,6 +165,13 @@ void Kinect::finalize()
 {
     cv::destroyAllWindows();
 
+    // Close Dataset Writing ( pending crops are written )
+    faceCropWriter.close();
+
+    // Release Face Clip Batch
+    faceCropBatcher.release( batch );
+    batch = nullptr;
+
     // Release Body Buffer
     for( auto& body : bodies ){
         SafeRelease( body );
@@ -173,9 +206,81 @@ inline void Kinect::updateColor()
         return;
     }
 
+#ifdef BENCHMARK
+    // Benchmark Color
+    benchmarkColor( colorFrame );
+#else
+    // Decode Regions of Face Clips ( fall back to conversion of whole frame if raw format is not YUY2 )
+    if( decodeRegions && decodeColor( colorFrame ) ){
+        return;
+    }
+    decodeRegions = false;
+
     // Convert Format ( YUY2 -> BGRA )
     ERROR_CHECK( colorFrame->CopyConvertedFrameDataToArray( static_cast<UINT>( colorBuffer.size() ), &colorBuffer[0], ColorImageFormat::ColorImageFormat_Bgra ) );
+#endif
+}
+
+// Decode Color
+// Regions are requested by drawFaceClip() from face clips of previous frame.
+inline bool Kinect::decodeColor( const ComPtr<IColorFrame>& colorFrame )
+{
+    // Check Raw Format
+    ColorImageFormat format;
+    ERROR_CHECK( colorFrame->get_RawColorImageFormat( &format ) );
+    if( format != ColorImageFormat::ColorImageFormat_Yuy2 ){
+        return false;
+    }
+
+    // Access Raw Frame without Copy ( valid while color frame is held )
+    UINT capacity;
+    BYTE* buffer;
+    ERROR_CHECK( colorFrame->AccessRawUnderlyingBuffer( &capacity, &buffer ) );
+    if( capacity < static_cast<UINT>( colorWidth * colorHeight * 2 ) ){
+        throw std::runtime_error( "failed IColorFrame::AccessRawUnderlyingBuffer()" );
+    }
+
+    // Decode Regions into Color Buffer
+    decoder.decode( buffer, &colorBuffer[0] );
+
+    return true;
+}
+
+#ifdef BENCHMARK
+// Benchmark Color
+inline void Kinect::benchmarkColor( const ComPtr<IColorFrame>& colorFrame )
+{
+    static double convertTime = 0.0;
+    static double decodeTime = 0.0;
+    static double decodedPixels = 0.0;
+    static int frameCount = 0;
+
+    // Convert Whole Frame ( previous conversion )
+    auto start = std::chrono::high_resolution_clock::now();
+    ERROR_CHECK( colorFrame->CopyConvertedFrameDataToArray( static_cast<UINT>( colorBuffer.size() ), &colorBuffer[0], ColorImageFormat::ColorImageFormat_Bgra ) );
+    auto end = std::chrono::high_resolution_clock::now();
+    convertTime += std::chrono::duration<double, std::milli>( end - start ).count();
+
+    // Decode Regions of Face Clips
+    start = std::chrono::high_resolution_clock::now();
+    if( !decodeColor( colorFrame ) ){
+        throw std::runtime_error( "failed Kinect::decodeColor()" );
+    }
+    end = std::chrono::high_resolution_clock::now();
+    decodeTime += std::chrono::duration<double, std::milli>( end - start ).count();
+    decodedPixels += static_cast<double>( decoder.getPixels() ) / ( colorWidth * colorHeight );
+
+    // Print Average every 100 Frames
+    if( ++frameCount == 100 ){
+        std::cout << "convert : " << convertTime / frameCount << " [ms/frame], "
+                  << "decode : " << decodeTime / frameCount << " [ms/frame] ( " << decodedPixels / frameCount * 100.0 << " [%] of pixels )" << std::endl;
+        convertTime = 0.0;
+        decodeTime = 0.0;
+        decodedPixels = 0.0;
+        frameCount = 0;
+    }
 }
+#endif
 
 // Update Body
 inline void Kinect::updateBody()
@@ -194,6 +299,10 @@ inline void Kinect::updateBody()
 
     // Retrieve Body Data
     ERROR_CHECK( bodyFrame->GetAndRefreshBodyData( static_cast<UINT>( bodies.size() ), &bodies[0] ) );
+
+    // Gather Tracking IDs of Tracked Bodies
+    std::array<TrackingIdManager::Candidate, BODY_COUNT> candidates;
+    int candidateCount = 0;
     for( int count = 0; count < BODY_COUNT; count++ ){
         const ComPtr<IBody> body = bodies[count];
         BOOLEAN tracked;
@@ -205,11 +314,20 @@ inline void Kinect::updateBody()
         // Retrieve Tracking ID
         UINT64 trackingId;
         ERROR_CHECK( body->get_TrackingId( &trackingId ) );
+        candidates[candidateCount++] = { trackingId, 0.0f };
+    }
+
+    // Registration Tracking ID only when Assignment of Reader is Changed
+    for( const TrackingIdManager::Event& event : trackingIdManager.update( &candidates[0], candidateCount ) ){
+        // Release Face Result of Lost Body
+        if( event.type == TrackingIdManager::Lost ){
+            results[event.slot].Reset();
+            continue;
+        }
 
-        // Registration Tracking ID
         ComPtr<IFaceFrameSource> faceFrameSource;
-        ERROR_CHECK( faceFrameReader[count]->get_FaceFrameSource( &faceFrameSource ) );
-        ERROR_CHECK( faceFrameSource->put_TrackingId( trackingId ) );
+        ERROR_CHECK( faceFrameReader[event.slot]->get_FaceFrameSource( &faceFrameSource ) );
+        ERROR_CHECK( faceFrameSource->put_TrackingId( event.trackingId ) );
     }
 }
 
@@ -236,6 +354,25 @@ inline void Kinect::updateFace()
     }
 }
 
+// Toggle Dataset Writing
+void Kinect::toggleWriting()
+{
+    // Stop Writing
+    if( faceCropWriter.isOpened() ){
+        faceCropWriter.close();
+        std::cout << "Stop Writing Face Clips ( " << faceCropWriter.getWritten() << " written, " << faceCropWriter.getDropped() << " dropped, " << faceCropWriter.getFailed() << " failed )" << std::endl;
+        return;
+    }
+
+    // Start Writing
+    std::cout << "Start Writing Face Clips to Dataset Directory" << std::endl;
+    pushed.fill( -1 );
+    CreateDirectoryA( "Dataset", nullptr );
+    if( !faceCropWriter.open( "Dataset", 112, ".png" ) ){
+        throw std::runtime_error( "failed FaceCropWriter::open( Dataset )" );
+    }
+}
+
 // Draw Data
 void Kinect::draw()
 {
@@ -256,32 +393,135 @@ inline void Kinect::drawColor()
 // Draw Face
 inline void Kinect::drawFaceClip()
 {
+    // Release Previous Batch to Pool
+    faceCropBatcher.release( batch );
+    batch = nullptr;
+
+    // Retrieve Face Points of Each Face
+    std::array<FaceCropBatcher::Face, BODY_COUNT> faces;
+    int faceCount = 0;
+    decoder.clear();
     for( int count = 0; count < BODY_COUNT; count++ ){
         const ComPtr<IFaceFrameResult> result = results[count];
         if( result == nullptr ){
             continue;
         }
 
-        // Retrieve Bounding Box
-        RectI boundingBox;
-        ERROR_CHECK( result->get_FaceBoundingBoxInColorSpace( &boundingBox ) );
+        retrieveFaceClip( result, count, faces[faceCount] );
 
-        // Retrieve Face Clip using Bounding Box
-        retrieveFaceClip( faceClipMat[count], boundingBox );
+        if( decodeRegions ){
+            // Request Region of Face Clip for Next Frame ( enlarged by quarter of crop for motion )
+            int box[4];
+            boundFaceClip( faces[faceCount], box );
+            const int margin = ( box[2] - box[0] ) / 4;
+            decoder.request( box[0] - margin, box[1] - margin, box[2] + margin, box[3] + margin );
+
+            // Skip Face Clip outside Decoded Regions ( new face is cropped from next frame )
+            if( !decoder.contains( std::max( box[0], 0 ), std::max( box[1], 0 ), std::min( box[2], colorWidth ), std::min( box[3], colorHeight ) ) ){
+                continue;
+            }
+        }
+
+        faceCount++;
     }
+
+    // Crop Aligned Faces into Batch ( nullptr if all batches are still used by consumers )
+    batch = faceCropBatcher.crop( &colorBuffer[0], colorWidth, colorHeight, colorBytesPerPixel, colorWidth * colorBytesPerPixel, &faces[0], faceCount );
+
+    // Write Face Clip
+    writeFaceClip();
 }
 
 // Retrieve Face Clip
-inline void Kinect::retrieveFaceClip( cv::Mat& image, const RectI& box )
+inline void Kinect::retrieveFaceClip( const ComPtr<IFaceFrameResult>& result, const int slot, FaceCropBatcher::Face& face )
+{
+    face.slot = slot;
+
+    // Retrieve Tracking ID and Time
+    TIMESPAN timestamp;
+    ERROR_CHECK( result->get_TrackingId( &face.trackingId ) );
+    ERROR_CHECK( result->get_RelativeTime( &timestamp ) );
+    face.timestamp = timestamp;
+
+    // Retrieve Face Points
+    std::array<PointF, FacePointType::FacePointType_Count> facePoints;
+    ERROR_CHECK( result->GetFacePointsInColorSpace( FacePointType::FacePointType_Count, &facePoints[0] ) );
+    for( int point = 0; point < FaceCropBatcher::POINTS; point++ ){
+        face.points[point][0] = facePoints[point].X;
+        face.points[point][1] = facePoints[point].Y;
+    }
+
+    // Retrieve Metadata for Dataset Manifest
+    if( !faceCropWriter.isOpened() ){
+        return;
+    }
+
+    FaceCropWriter::Record& record = records[slot];
+    record.trackingId = face.trackingId;
+    record.timestamp = face.timestamp;
+
+    // Retrieve Face Rotation Quaternion
+    Vector4 rotationQuaternion;
+    ERROR_CHECK( result->get_FaceRotationQuaternion( &rotationQuaternion ) );
+    record.quaternion[0] = rotationQuaternion.x;
+    record.quaternion[1] = rotationQuaternion.y;
+    record.quaternion[2] = rotationQuaternion.z;
+    record.quaternion[3] = rotationQuaternion.w;
+
+    // Retrieve Face Properties
+    std::array<DetectionResult, FaceProperty::FaceProperty_Count> detectionResults;
+    ERROR_CHECK( result->GetFaceProperties( FaceProperty::FaceProperty_Count, &detectionResults[0] ) );
+    for( int property = 0; property < FaceCropWriter::PROPERTIES; property++ ){
+        record.properties[property] = static_cast<uint8_t>( detectionResults[property] );
+    }
+}
+
+// Bound Face Clip
+// Corners of crop are transformed into color image, and enlarged by 1 [px] for bilinear interpolation.
+inline void Kinect::boundFaceClip( const FaceCropBatcher::Face& face, int box[4] )
 {
-    if( colorMat.empty() ){
+    // Estimate Transform from Crop to Color Image
+    float transform[6];
+    faceCropBatcher.estimate( face.points, transform );
+
+    // Bounding Box of Corners
+    const float size = static_cast<float>( faceCropBatcher.getSize() );
+    const float corners[4][2] = { { 0.0f, 0.0f }, { size, 0.0f }, { 0.0f, size }, { size, size } };
+    float left = std::numeric_limits<float>::max(), top = std::numeric_limits<float>::max();
+    float right = std::numeric_limits<float>::lowest(), bottom = std::numeric_limits<float>::lowest();
+    for( const auto& corner : corners ){
+        const float x = transform[0] * corner[0] + transform[1] * corner[1] + transform[2];
+        const float y = transform[3] * corner[0] + transform[4] * corner[1] + transform[5];
+        left = std::min( left, x );
+        top = std::min( top, y );
+        right = std::max( right, x );
+        bottom = std::max( bottom, y );
+    }
+
+    box[0] = static_cast<int>( std::floor( left ) ) - 1;
+    box[1] = static_cast<int>( std::floor( top ) ) - 1;
+    box[2] = static_cast<int>( std::ceil( right ) ) + 2;
+    box[3] = static_cast<int>( std::ceil( bottom ) ) + 2;
+}
+
+// Write Face Clip
+inline void Kinect::writeFaceClip()
+{
+    if( batch == nullptr || !faceCropWriter.isOpened() ){
         return;
     }
 
-    // Retrieve Face Clip using Bounding Box
-    const int width = box.Right - box.Left;
-    const int height = box.Bottom - box.Top;
-    image = colorMat( cv::Rect( box.Left, box.Top, width, height ) ).clone();
+    // Queue Crops of Batch ( crops are copied, dropped crops are counted by writer )
+    // Face result is updated only when new face frame arrives, so crop of same RelativeTime is pushed only once.
+    for( int index = 0; index < batch->count; index++ ){
+        const FaceCropBatcher::Entry& entry = batch->entries[index];
+        if( entry.timestamp == pushed[entry.slot] ){
+            continue;
+        }
+
+        faceCropWriter.push( batch->image( index ), records[entry.slot] );
+        pushed[entry.slot] = entry.timestamp;
+    }
 }
 
 // Show Data
@@ -294,16 +534,22 @@ void Kinect::show()
 // Show Face Clip
 inline void Kinect::showFaceClip()
 {
+    if( batch == nullptr ){
+        return;
+    }
+
+    // Show Crops in Batch without Copy ( NHWC, BGR )
+    std::array<bool, BODY_COUNT> shown = {};
+    for( int index = 0; index < batch->count; index++ ){
+        const int slot = batch->entries[index].slot;
+        cv::Mat faceClipMat( batch->size, batch->size, CV_8UC3, batch->image( index ) );
+        cv::imshow( "Face" + std::to_string( slot ), faceClipMat );
+        shown[slot] = true;
+    }
+
     for( int count = 0; count < BODY_COUNT; count++ ){
-        if( faceClipMat[count].empty() ){
+        if( !shown[count] ){
             cv::destroyWindow( "Face" + std::to_string( count ) );
-            continue;
         }
-
-        // Resize Clip to Constant Size
-        //cv::resize( faceClipMat[count], faceClipMat[count], cv::Size( 200, 200) );
-
-        // Show Image
-        cv::imshow( "Face" + std::to_string( count ) , faceClipMat[count] );
     }
 }
\ No newline at end of file
@@ -5,6 +5,10 @@
 #include <Kinect.h>
 #include <Kinect.Face.h>
 #include <opencv2/opencv.hpp>
+#include "TrackingIdManager.h"
+#include "FaceCropBatcher.h"
+#include "FaceCropWriter.h"
+#include "ColorRegionDecoder.h"
 
 #include <vector>
 #include <array>
@@ -35,12 +39,27 @@ private:
     unsigned int colorBytesPerPixel;
     cv::Mat colorMat;
 
+    // Color Region Decoder ( only regions of face clips are decoded, image outside regions is not shown )
+    ColorRegionDecoder decoder;
+    bool decodeRegions;
+
     // Body Buffer
     std::array<IBody*, BODY_COUNT> bodies;
 
     // Face Buffer
     std::array<ComPtr<IFaceFrameResult>, BODY_COUNT> results;
-    std::array<cv::Mat, BODY_COUNT> faceClipMat;
+
+    // Tracking ID Manager ( assign bodies to face frame readers )
+    TrackingIdManager trackingIdManager;
+
+    // Face Crop Batcher ( aligned 112x112 crops of all faces in one pooled batch buffer )
+    FaceCropBatcher faceCropBatcher;
+    FaceCropBatcher::Batch* batch;
+
+    // Face Crop Writer ( harvest crops and manifest into dataset directory in background )
+    FaceCropWriter faceCropWriter;
+    std::array<FaceCropWriter::Record, BODY_COUNT> records;
+    std::array<int64_t, BODY_COUNT> pushed; // RelativeTime of last crop pushed for each slot ( crop is pushed once per face frame )
 
 public:
     // Constructor
@@ -77,12 +96,21 @@ private:
     // Update Color
     inline void updateColor();
 
+    // Decode Color ( return false if raw format is not YUY2 )
+    inline bool decodeColor( const ComPtr<IColorFrame>& colorFrame );
+
+    // Benchmark Color
+    inline void benchmarkColor( const ComPtr<IColorFrame>& colorFrame );
+
     // Update Body
     inline void updateBody();
 
     // Update Face
     inline void updateFace();
 
+    // Toggle Dataset Writing
+    void toggleWriting();
+
     // Draw Data
     void draw();
 
@@ -93,7 +121,13 @@ private:
     inline void drawFaceClip();
 
     // Retrieve Face Clip
-    inline void retrieveFaceClip( cv::Mat& image, const RectI& box );
+    inline void retrieveFaceClip( const ComPtr<IFaceFrameResult>& result, const int slot, FaceCropBatcher::Face& face );
+
+    // Bound Face Clip ( bounding box of crop in color image, Left, Top, Right, Bottom )
+    inline void boundFaceClip( const FaceCropBatcher::Face& face, int box[4] );
+
+    // Write Face Clip
+    inline void writeFaceClip();
 
     // Show Data
     void show();
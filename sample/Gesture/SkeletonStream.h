@@ -0,0 +1,149 @@
+#ifndef __SKELETON_STREAM__
+#define __SKELETON_STREAM__
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <chrono>
+#include <cstdint>
+
+// Skeleton Frame
+// Snapshot of IBody data of all bodies in plain structure ( no dependency on Kinect SDK ).
+// Enumerations ( TrackingState, HandState, TrackingConfidence ) are stored as same values as Kinect SDK.
+struct SkeletonFrame
+{
+    // Number of Bodies and Joints ( same as BODY_COUNT and JointType_Count )
+    static const int BODIES = 6;
+    static const int JOINTS = 25;
+
+    struct Body
+    {
+        uint8_t tracked;
+        uint64_t trackingId;
+        float positions[JOINTS][3];    // X, Y, Z [m]
+        float orientations[JOINTS][4]; // X, Y, Z, W
+        uint8_t states[JOINTS];        // TrackingState
+        uint8_t handLeftState;         // HandState
+        uint8_t handLeftConfidence;    // TrackingConfidence
+        uint8_t handRightState;        // HandState
+        uint8_t handRightConfidence;   // TrackingConfidence
+        float lean[2];                 // X, Y
+        uint8_t leanState;             // TrackingState
+    };
+
+    int64_t timestamp; // RelativeTime ( 100 [ns] unit )
+    Body bodies[BODIES];
+};
+
+// Skeleton Stream State
+// Quantized values of previous frame that next frame is delta coded against.
+// Positions are fixed point of 0.1 [mm], orientations are fixed point of 1/16384, lean is fixed point of 1/1000.
+struct SkeletonStreamState
+{
+    struct Body
+    {
+        uint8_t tracked;
+        uint64_t trackingId;
+        int32_t positions[SkeletonFrame::JOINTS][3];
+        int32_t orientations[SkeletonFrame::JOINTS][4];
+        int32_t lean[2];
+    };
+
+    int64_t timestamp;
+    int frames;
+    Body bodies[SkeletonFrame::BODIES];
+
+    // Reset State ( next frame is key frame )
+    void reset();
+};
+
+// Skeleton Recorder
+// Writes frames with quantized fixed point values and inter-frame delta coding.
+// Each body that keeps same TrackingId is coded as difference from previous frame, and a key frame is inserted periodically.
+class SkeletonRecorder
+{
+private:
+    std::ofstream file;
+    std::vector<uint8_t> buffer;
+    SkeletonStreamState state;
+    uint64_t bytes;
+
+public:
+    // Constructor
+    SkeletonRecorder();
+
+    // Destructor
+    ~SkeletonRecorder();
+
+    // Open File
+    bool open( const std::string& path );
+
+    // Close File
+    void close();
+
+    // Check Opened
+    bool isOpened() const
+    {
+        return file.is_open();
+    }
+
+    // Write Frame
+    bool write( const SkeletonFrame& frame );
+
+    // Retrieve Number of Frames and Bytes Written
+    int getFrames() const
+    {
+        return state.frames;
+    }
+
+    uint64_t getBytes() const
+    {
+        return bytes;
+    }
+};
+
+// Skeleton Replayer
+// Reads frames written by SkeletonRecorder, at real-time ( paced by RelativeTime ) or at maximum speed.
+class SkeletonReplayer
+{
+private:
+    std::ifstream file;
+    std::vector<uint8_t> buffer;
+    SkeletonStreamState state;
+    std::streampos begin;
+
+    // Pacing
+    bool realtime;
+    int64_t origin;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    // Constructor
+    SkeletonReplayer();
+
+    // Open File
+    bool open( const std::string& path );
+
+    // Close File
+    void close();
+
+    // Check Opened
+    bool isOpened() const
+    {
+        return file.is_open();
+    }
+
+    // Set Pacing ( true is real-time, false is maximum speed )
+    void setRealtime( const bool realtime )
+    {
+        this->realtime = realtime;
+    }
+
+    // Read Next Frame ( return false at the end of file )
+    bool read( SkeletonFrame& frame );
+
+    // Rewind to First Frame
+    void rewind();
+};
+
+#endif // __SKELETON_STREAM__
\ No newline at end of file
@@ -41,6 +41,9 @@ void Kinect::run()
         if( key == VK_ESCAPE ){
             break;
         }
+        else if( key == 'r' ){
+            toggleRecording();
+        }
     }
 }
 
@@ -212,6 +215,17 @@ inline void Kinect::updateBody()
     std::array<ComPtr<IBody>, BODY_COUNT> bodies;
     ERROR_CHECK( bodyFrame->GetAndRefreshBodyData( static_cast<UINT>( bodies.size() ), &bodies[0] ) );
 
+    // Record Skeleton Frame
+    if( recorder.isOpened() ){
+        retrieveFrame( bodyFrame, bodies );
+        if( !recorder.write( frame ) ){
+            throw std::runtime_error( "failed SkeletonRecorder::write()" );
+        }
+    }
+
+    // Gather Tracking IDs of Tracked Bodies
+    std::array<TrackingIdManager::Candidate, BODY_COUNT> candidates;
+    int candidateCount = 0;
     for( int count = 0; count < BODY_COUNT; count++ ){
         const ComPtr<IBody> body = bodies[count];
         BOOLEAN tracked;
@@ -223,11 +237,105 @@ inline void Kinect::updateBody()
         // Retrieve Tracking ID
         UINT64 trackingId;
         ERROR_CHECK( body->get_TrackingId( &trackingId ) );
+        candidates[candidateCount++] = { trackingId, 0.0f };
+    }
+
+    // Registration Tracking ID only when Assignment of Reader is Changed
+    for( const TrackingIdManager::Event& event : trackingIdManager.update( &candidates[0], candidateCount ) ){
+        if( event.type == TrackingIdManager::Lost ){
+            continue;
+        }
 
-        // Registration Tracking ID
         ComPtr<IVisualGestureBuilderFrameSource> gestureFrameSource;
-        ERROR_CHECK( gestureFrameReader[count]->get_VisualGestureBuilderFrameSource( &gestureFrameSource ) );
-        gestureFrameSource->put_TrackingId( trackingId );
+        ERROR_CHECK( gestureFrameReader[event.slot]->get_VisualGestureBuilderFrameSource( &gestureFrameSource ) );
+        gestureFrameSource->put_TrackingId( event.trackingId );
+    }
+}
+
+// Retrieve Skeleton Frame
+inline void Kinect::retrieveFrame( const ComPtr<IBodyFrame>& bodyFrame, const std::array<ComPtr<IBody>, BODY_COUNT>& bodies )
+{
+    // Retrieve Timestamp
+    TIMESPAN relativeTime;
+    ERROR_CHECK( bodyFrame->get_RelativeTime( &relativeTime ) );
+    frame.timestamp = relativeTime;
+
+    for( int index = 0; index < BODY_COUNT; index++ ){
+        SkeletonFrame::Body& data = frame.bodies[index];
+        data.tracked = 0;
+        data.trackingId = 0;
+
+        const ComPtr<IBody> body = bodies[index];
+        if( body == nullptr ){
+            continue;
+        }
+
+        // Check Body Tracked
+        BOOLEAN tracked = FALSE;
+        ERROR_CHECK( body->get_IsTracked( &tracked ) );
+        if( !tracked ){
+            continue;
+        }
+        data.tracked = 1;
+
+        // Retrieve Tracking ID
+        ERROR_CHECK( body->get_TrackingId( &data.trackingId ) );
+
+        // Retrieve Joints and Joint Orientations
+        std::array<Joint, JointType::JointType_Count> joints;
+        std::array<JointOrientation, JointType::JointType_Count> orientations;
+        ERROR_CHECK( body->GetJoints( static_cast<UINT>( joints.size() ), &joints[0] ) );
+        ERROR_CHECK( body->GetJointOrientations( static_cast<UINT>( orientations.size() ), &orientations[0] ) );
+        for( int type = 0; type < JointType::JointType_Count; type++ ){
+            const CameraSpacePoint& position = joints[type].Position;
+            const Vector4& orientation = orientations[type].Orientation;
+            data.positions[type][0] = position.X;
+            data.positions[type][1] = position.Y;
+            data.positions[type][2] = position.Z;
+            data.orientations[type][0] = orientation.x;
+            data.orientations[type][1] = orientation.y;
+            data.orientations[type][2] = orientation.z;
+            data.orientations[type][3] = orientation.w;
+            data.states[type] = static_cast<uint8_t>( joints[type].TrackingState );
+        }
+
+        // Retrieve Hand States
+        HandState handLeftState, handRightState;
+        TrackingConfidence handLeftConfidence, handRightConfidence;
+        ERROR_CHECK( body->get_HandLeftState( &handLeftState ) );
+        ERROR_CHECK( body->get_HandLeftConfidence( &handLeftConfidence ) );
+        ERROR_CHECK( body->get_HandRightState( &handRightState ) );
+        ERROR_CHECK( body->get_HandRightConfidence( &handRightConfidence ) );
+        data.handLeftState = static_cast<uint8_t>( handLeftState );
+        data.handLeftConfidence = static_cast<uint8_t>( handLeftConfidence );
+        data.handRightState = static_cast<uint8_t>( handRightState );
+        data.handRightConfidence = static_cast<uint8_t>( handRightConfidence );
+
+        // Retrieve Amount of Body Lean
+        PointF amount;
+        TrackingState leanState;
+        ERROR_CHECK( body->get_Lean( &amount ) );
+        ERROR_CHECK( body->get_LeanTrackingState( &leanState ) );
+        data.lean[0] = amount.X;
+        data.lean[1] = amount.Y;
+        data.leanState = static_cast<uint8_t>( leanState );
+    }
+}
+
+// Toggle Recording
+void Kinect::toggleRecording()
+{
+    // Stop Recording
+    if( recorder.isOpened() ){
+        std::cout << "Stop Recording Skeleton ( " << recorder.getFrames() << " frames, " << recorder.getBytes() << " bytes )" << std::endl;
+        recorder.close();
+        return;
+    }
+
+    // Start Recording
+    std::cout << "Start Recording Skeleton to File" << std::endl;
+    if( !recorder.open( "Skeleton.bin" ) ){
+        throw std::runtime_error( "failed SkeletonRecorder::open( Skeleton.bin )" );
     }
 }
 
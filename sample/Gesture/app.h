@@ -5,6 +5,8 @@
 #include <Kinect.h>
 #include <Kinect.VisualGestureBuilder.h>
 #include <opencv2/opencv.hpp>
+#include "SkeletonStream.h"
+#include "TrackingIdManager.h"
 
 #include <vector>
 #include <array>
@@ -39,9 +41,16 @@ private:
     std::vector<ComPtr<IGesture>> gestures;
     std::array<std::vector<std::string>, BODY_COUNT> results;
 
+    // Tracking ID Manager ( assign bodies to gesture frame readers )
+    TrackingIdManager trackingIdManager;
+
     std::array<cv::Vec3b, BODY_COUNT> colors;
     int offset;
 
+    // Skeleton Stream ( record body frames that gestures are detected from )
+    SkeletonFrame frame;
+    SkeletonRecorder recorder;
+
 public:
     // Constructor
     Kinect();
@@ -80,6 +89,12 @@ private:
     // Update Body
     inline void updateBody();
 
+    // Retrieve Skeleton Frame
+    inline void retrieveFrame( const ComPtr<IBodyFrame>& bodyFrame, const std::array<ComPtr<IBody>, BODY_COUNT>& bodies );
+
+    // Toggle Recording
+    void toggleRecording();
+
     // Update Gesture
     inline void updateGesture();
 
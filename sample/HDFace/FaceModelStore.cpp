@@ -0,0 +1,164 @@
+#include "FaceModelStore.h"
+
+#include <fstream>
+#include <vector>
+#include <cstring>
+#include <cmath>
+#include <cstdio>
+
+// File Header ( magic, version, number of shape units )
+static const char MAGIC[4] = { 'F', 'M', 'D', 'L' };
+static const uint8_t VERSION = 1;
+
+// Size of Model Record ( scale, hair color, skin color, shape units )
+static const size_t MODEL_BYTES = 4 + 4 + 4 + FaceModelStore::SHAPE_UNITS * 4;
+
+// Write Integer ( little endian )
+static inline void writeInteger( std::vector<uint8_t>& buffer, const uint64_t value, const int bytes )
+{
+    for( int byte = 0; byte < bytes; byte++ ){
+        buffer.push_back( static_cast<uint8_t>( value >> ( byte * 8 ) ) );
+    }
+}
+
+// Write Float ( IEEE 754, little endian )
+static inline void writeFloat( std::vector<uint8_t>& buffer, const float value )
+{
+    uint32_t bits;
+    std::memcpy( &bits, &value, sizeof( bits ) );
+    writeInteger( buffer, bits, 4 );
+}
+
+// Read Integer ( little endian )
+static inline uint64_t readInteger( const uint8_t*& data, const int bytes )
+{
+    uint64_t value = 0;
+    for( int byte = 0; byte < bytes; byte++ ){
+        value |= static_cast<uint64_t>( *data++ ) << ( byte * 8 );
+    }
+    return value;
+}
+
+// Read Float ( IEEE 754, little endian )
+static inline float readFloat( const uint8_t*& data )
+{
+    const uint32_t bits = static_cast<uint32_t>( readInteger( data, 4 ) );
+    float value;
+    std::memcpy( &value, &bits, sizeof( value ) );
+    return value;
+}
+
+// Constructor
+FaceModelStore::FaceModelStore( const std::string& directory )
+    : directory( directory )
+{
+}
+
+// Check Operator ID
+bool FaceModelStore::isValid( const std::string& id )
+{
+    if( id.empty() || id.size() > 64 ){
+        return false;
+    }
+
+    for( const char character : id ){
+        const bool alphanumeric = ( '0' <= character && character <= '9' ) || ( 'A' <= character && character <= 'Z' ) || ( 'a' <= character && character <= 'z' );
+        if( !alphanumeric && character != '-' && character != '_' ){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Save Face Model of Operator
+bool FaceModelStore::save( const std::string& id, const Model& model ) const
+{
+    if( !isValid( id ) ){
+        return false;
+    }
+
+    // Serialize Model
+    std::vector<uint8_t> buffer;
+    buffer.reserve( sizeof( MAGIC ) + 4 + MODEL_BYTES );
+    buffer.insert( buffer.end(), MAGIC, MAGIC + sizeof( MAGIC ) );
+    buffer.push_back( VERSION );
+    buffer.push_back( 0 );
+    writeInteger( buffer, SHAPE_UNITS, 2 );
+    writeFloat( buffer, model.scale );
+    writeInteger( buffer, model.hairColor, 4 );
+    writeInteger( buffer, model.skinColor, 4 );
+    for( int unit = 0; unit < SHAPE_UNITS; unit++ ){
+        writeFloat( buffer, model.shapeUnits[unit] );
+    }
+
+    // Write to Temporary File, then Replace Saved File ( previous model is kept if writing failed )
+    const std::string temporary = path( id ) + ".tmp";
+    std::ofstream file( temporary, std::ios::binary | std::ios::trunc );
+    if( !file.is_open() ){
+        return false;
+    }
+    file.write( reinterpret_cast<const char*>( &buffer[0] ), buffer.size() );
+    file.close();
+    if( !file ){
+        std::remove( temporary.c_str() );
+        return false;
+    }
+
+    std::remove( path( id ).c_str() );
+    return std::rename( temporary.c_str(), path( id ).c_str() ) == 0;
+}
+
+// Load Face Model of Operator
+bool FaceModelStore::load( const std::string& id, Model& model ) const
+{
+    if( !isValid( id ) ){
+        return false;
+    }
+
+    std::ifstream file( path( id ), std::ios::binary );
+    if( !file.is_open() ){
+        return false;
+    }
+
+    // Read Whole File ( header and one model record )
+    std::vector<uint8_t> buffer( sizeof( MAGIC ) + 4 + MODEL_BYTES );
+    file.read( reinterpret_cast<char*>( &buffer[0] ), buffer.size() );
+    if( file.gcount() != static_cast<std::streamsize>( buffer.size() ) ){
+        return false;
+    }
+
+    // Check Header
+    const uint8_t* data = &buffer[0];
+    if( std::memcmp( data, MAGIC, sizeof( MAGIC ) ) != 0 ){
+        return false;
+    }
+    data += sizeof( MAGIC );
+    const uint8_t version = *data++;
+    data++;
+    const uint64_t units = readInteger( data, 2 );
+    if( version != VERSION || units != SHAPE_UNITS ){
+        return false;
+    }
+
+    // Deserialize Model
+    Model loaded;
+    loaded.scale = readFloat( data );
+    loaded.hairColor = static_cast<uint32_t>( readInteger( data, 4 ) );
+    loaded.skinColor = static_cast<uint32_t>( readInteger( data, 4 ) );
+    for( int unit = 0; unit < SHAPE_UNITS; unit++ ){
+        loaded.shapeUnits[unit] = readFloat( data );
+    }
+    if( !std::isfinite( loaded.scale ) || !( loaded.scale > 0.0f ) ){
+        return false;
+    }
+
+    model = loaded;
+    return true;
+}
+
+// Retrieve File Path of Operator
+std::string FaceModelStore::path( const std::string& id ) const
+{
+    return directory + "/" + id + ".bin";
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#ifndef __FACE_MODEL_STORE__
+#define __FACE_MODEL_STORE__
+
+#include <string>
+#include <cstdint>
+
+// Face Model Store
+// Produced face model ( shape units, scale, hair and skin color ) is saved to compact file keyed by operator ID,
+// so that face model of returning operator is created directly without face data collection.
+// Each operator is saved to "<directory>/<id>.bin" ( ID is limited to alphanumeric, '-' and '_' ).
+// This class has no dependency on Kinect SDK.
+class FaceModelStore
+{
+public:
+    // Number of Shape Units ( same as FaceShapeDeformations_Count )
+    static const int SHAPE_UNITS = 94;
+
+    // Face Model
+    struct Model
+    {
+        float scale;
+        uint32_t hairColor;             // XBGR ( 0 if not collected )
+        uint32_t skinColor;             // XBGR ( 0 if not collected )
+        float shapeUnits[SHAPE_UNITS];  // Deformations from default face model
+    };
+
+private:
+    std::string directory;
+
+public:
+    // Constructor
+    FaceModelStore( const std::string& directory = "FaceModels" );
+
+    // Check Operator ID
+    static bool isValid( const std::string& id );
+
+    // Save Face Model of Operator ( return false if failed )
+    bool save( const std::string& id, const Model& model ) const;
+
+    // Load Face Model of Operator ( return false if not saved or broken )
+    bool load( const std::string& id, Model& model ) const;
+
+    // Retrieve Directory
+    const std::string& getDirectory() const
+    {
+        return directory;
+    }
+
+private:
+    // Retrieve File Path of Operator
+    std::string path( const std::string& id ) const;
+};
+
+#endif // __FACE_MODEL_STORE__
\ No newline at end of file
@@ -0,0 +1,747 @@
+#include "FaceStream.h"
+
+#include <cmath>
+#include <cstring>
+#include <thread>
+#include <algorithm>
+
+// File Header ( magic, version, number of animation units, flags )
+static const char MAGIC[4] = { 'H', 'D', 'F', 'S' };
+static const uint8_t VERSION = 1;
+
+// Chunk Header ( magic, frames, bytes, timestamp of first frame ), Index and Footer
+static const char CHUNK_MAGIC[4] = { 'C', 'H', 'N', 'K' };
+static const char INDEX_MAGIC[4] = { 'I', 'N', 'D', 'X' };
+static const char FOOTER_MAGIC[4] = { 'H', 'D', 'F', 'E' };
+static const size_t CHUNK_HEADER_BYTES = 4 + 4 + 4 + 8;
+static const size_t INDEX_ENTRY_BYTES = 8 + 8 + 4;
+static const size_t FOOTER_BYTES = 8 + 4;
+
+// Number of Frames in Chunk ( 1 [s] at 30 [fps] )
+static const int CHUNK_FRAMES = 30;
+
+// Scale of Fixed Point
+static const float ANIMATION_UNIT_SCALE = 10000.0f;
+static const float PIVOT_SCALE = 10000.0f;
+static const float ORIENTATION_SCALE = 16384.0f;
+static const float VERTEX_SCALE = 10000.0f;
+
+// File Flags
+static const uint8_t FLAG_VERTEXES = 0x01;
+
+// Frame Flags
+static const uint8_t FLAG_TRACKED = 0x01;
+static const uint8_t FLAG_FRAME_VERTEXES = 0x02;
+static const uint8_t FLAG_TRACKING_ID = 0x04;
+
+// Quantize to Fixed Point
+static inline int32_t quantize( const float value, const float scale )
+{
+    return static_cast<int32_t>( std::lround( value * scale ) );
+}
+
+// Write Integer ( fixed length, little endian )
+static inline void writeInteger( std::vector<uint8_t>& buffer, const uint64_t value, const int bytes )
+{
+    for( int byte = 0; byte < bytes; byte++ ){
+        buffer.push_back( static_cast<uint8_t>( value >> ( byte * 8 ) ) );
+    }
+}
+
+// Read Integer ( fixed length, little endian )
+static inline uint64_t readInteger( const uint8_t*& data, const int bytes )
+{
+    uint64_t value = 0;
+    for( int byte = 0; byte < bytes; byte++ ){
+        value |= static_cast<uint64_t>( *data++ ) << ( byte * 8 );
+    }
+    return value;
+}
+
+// Write Variable Length Integer ( 7 bits per byte, little endian )
+static inline void writeVarint( std::vector<uint8_t>& buffer, uint64_t value )
+{
+    while( value >= 0x80 ){
+        buffer.push_back( static_cast<uint8_t>( value | 0x80 ) );
+        value >>= 7;
+    }
+    buffer.push_back( static_cast<uint8_t>( value ) );
+}
+
+// Write Signed Variable Length Integer ( zigzag coding, small magnitude is short )
+static inline void writeSigned( std::vector<uint8_t>& buffer, const int64_t value )
+{
+    writeVarint( buffer, ( static_cast<uint64_t>( value ) << 1 ) ^ static_cast<uint64_t>( value >> 63 ) );
+}
+
+// Read Variable Length Integer ( return false if buffer is overrun )
+static inline bool readVarint( const uint8_t*& data, const uint8_t* end, uint64_t& value )
+{
+    value = 0;
+    for( int shift = 0; shift < 64; shift += 7 ){
+        if( data == end ){
+            return false;
+        }
+        const uint8_t byte = *data++;
+        value |= static_cast<uint64_t>( byte & 0x7f ) << shift;
+        if( !( byte & 0x80 ) ){
+            return true;
+        }
+    }
+    return false;
+}
+
+// Read Signed Variable Length Integer
+static inline bool readSigned( const uint8_t*& data, const uint8_t* end, int64_t& value )
+{
+    uint64_t zigzag;
+    if( !readVarint( data, end, zigzag ) ){
+        return false;
+    }
+    value = static_cast<int64_t>( zigzag >> 1 ) ^ -static_cast<int64_t>( zigzag & 1 );
+    return true;
+}
+
+// Read Variable Length Integer from File
+static inline bool readVarint( std::istream& stream, uint64_t& value )
+{
+    value = 0;
+    for( int shift = 0; shift < 64; shift += 7 ){
+        const int byte = stream.get();
+        if( byte == std::char_traits<char>::eof() ){
+            return false;
+        }
+        value |= static_cast<uint64_t>( byte & 0x7f ) << shift;
+        if( !( byte & 0x80 ) ){
+            return true;
+        }
+    }
+    return false;
+}
+
+// Restore Unit Quaternion from Fixed Point ( encoder and decoder use same quantized pose )
+static inline void restoreOrientation( const int32_t quantized[4], float orientation[4] )
+{
+    float norm = 0.0f;
+    for( int axis = 0; axis < 4; axis++ ){
+        orientation[axis] = quantized[axis] / ORIENTATION_SCALE;
+        norm += orientation[axis] * orientation[axis];
+    }
+    if( !( norm > 0.0f ) ){
+        orientation[0] = orientation[1] = orientation[2] = 0.0f;
+        orientation[3] = 1.0f;
+        return;
+    }
+    norm = 1.0f / std::sqrt( norm );
+    for( int axis = 0; axis < 4; axis++ ){
+        orientation[axis] *= norm;
+    }
+}
+
+// Rotate Vector by Unit Quaternion ( v + w * t + q x t, t = 2 * q x v )
+static inline void rotate( const float q[4], const float v[3], float r[3] )
+{
+    const float tx = 2.0f * ( q[1] * v[2] - q[2] * v[1] );
+    const float ty = 2.0f * ( q[2] * v[0] - q[0] * v[2] );
+    const float tz = 2.0f * ( q[0] * v[1] - q[1] * v[0] );
+    r[0] = v[0] + q[3] * tx + ( q[1] * tz - q[2] * ty );
+    r[1] = v[1] + q[3] * ty + ( q[2] * tx - q[0] * tz );
+    r[2] = v[2] + q[3] * tz + ( q[0] * ty - q[1] * tx );
+}
+
+// Move Vertexes in Camera Space into Head Space, and Quantize
+static inline void toHead( const float vertexes[][3], const int32_t pivot[3], const int32_t orientation[4], int32_t* head )
+{
+    float q[4];
+    restoreOrientation( orientation, q );
+    const float inverse[4] = { -q[0], -q[1], -q[2], q[3] };
+    const float p[3] = { pivot[0] / PIVOT_SCALE, pivot[1] / PIVOT_SCALE, pivot[2] / PIVOT_SCALE };
+    for( int vertex = 0; vertex < FaceFrame::VERTEXES; vertex++ ){
+        const float v[3] = { vertexes[vertex][0] - p[0], vertexes[vertex][1] - p[1], vertexes[vertex][2] - p[2] };
+        float h[3];
+        rotate( inverse, v, h );
+        for( int axis = 0; axis < 3; axis++ ){
+            head[vertex * 3 + axis] = quantize( h[axis], VERTEX_SCALE );
+        }
+    }
+}
+
+// Reset State
+void FaceStreamState::reset()
+{
+    std::memset( this, 0, sizeof( FaceStreamState ) );
+}
+
+// Constructor
+FaceStreamRecorder::FaceStreamRecorder()
+    : vertexes( false ),
+      frames( 0 ),
+      bytes( 0 )
+{
+    state.reset();
+    current.frames = 0;
+}
+
+// Destructor
+FaceStreamRecorder::~FaceStreamRecorder()
+{
+    // Close File
+    close();
+}
+
+// Open File
+bool FaceStreamRecorder::open( const std::string& path, const FaceFrame* neutral )
+{
+    close();
+
+    // Neutral Face must have Vertexes
+    if( neutral != nullptr && !( neutral->tracked && neutral->hasVertexes ) ){
+        return false;
+    }
+
+    file.open( path, std::ios::binary | std::ios::trunc );
+    if( !file.is_open() ){
+        return false;
+    }
+
+    // Neutral Face in Head Space
+    vertexes = ( neutral != nullptr );
+    this->neutral.clear();
+    if( vertexes ){
+        int32_t pivot[3], orientation[4];
+        for( int axis = 0; axis < 3; axis++ ){
+            pivot[axis] = quantize( neutral->pivot[axis], PIVOT_SCALE );
+        }
+        for( int axis = 0; axis < 4; axis++ ){
+            orientation[axis] = quantize( neutral->orientation[axis], ORIENTATION_SCALE );
+        }
+        this->neutral.resize( FaceFrame::VERTEXES * 3 );
+        toHead( neutral->vertexes, pivot, orientation, &this->neutral[0] );
+    }
+
+    // Write Header
+    buffer.clear();
+    buffer.insert( buffer.end(), MAGIC, MAGIC + sizeof( MAGIC ) );
+    buffer.push_back( VERSION );
+    buffer.push_back( FaceFrame::ANIMATION_UNITS );
+    buffer.push_back( vertexes ? FLAG_VERTEXES : 0 );
+    buffer.push_back( 0 );
+    writeVarint( buffer, vertexes ? FaceFrame::VERTEXES : 0 );
+    for( const int32_t value : this->neutral ){
+        writeSigned( buffer, value );
+    }
+    file.write( reinterpret_cast<const char*>( &buffer[0] ), buffer.size() );
+
+    state.reset();
+    chunk.clear();
+    index.clear();
+    current.frames = 0;
+    frames = 0;
+    bytes = buffer.size();
+
+    return file.good();
+}
+
+// Close File
+void FaceStreamRecorder::close()
+{
+    if( !file.is_open() ){
+        return;
+    }
+
+    // Write Remaining Chunk
+    flush();
+
+    // Write Index and Footer ( footer points to index )
+    const uint64_t offset = bytes;
+    buffer.clear();
+    buffer.insert( buffer.end(), INDEX_MAGIC, INDEX_MAGIC + sizeof( INDEX_MAGIC ) );
+    writeInteger( buffer, index.size(), 4 );
+    for( const Entry& entry : index ){
+        writeInteger( buffer, entry.offset, 8 );
+        writeInteger( buffer, static_cast<uint64_t>( entry.timestamp ), 8 );
+        writeInteger( buffer, entry.frames, 4 );
+    }
+    writeInteger( buffer, offset, 8 );
+    buffer.insert( buffer.end(), FOOTER_MAGIC, FOOTER_MAGIC + sizeof( FOOTER_MAGIC ) );
+    file.write( reinterpret_cast<const char*>( &buffer[0] ), buffer.size() );
+    bytes += buffer.size();
+
+    file.close();
+}
+
+// Write Frame
+bool FaceStreamRecorder::write( const FaceFrame& frame )
+{
+    if( !file.is_open() ){
+        return false;
+    }
+
+    // First Frame of Chunk is Coded from Zero
+    if( current.frames == 0 ){
+        state.reset();
+        current.timestamp = frame.timestamp;
+    }
+
+    // Frame Header
+    const bool tracked = frame.tracked != 0;
+    const bool changed = tracked && frame.trackingId != state.trackingId;
+    const bool coded = tracked && vertexes && frame.hasVertexes;
+    buffer.clear();
+    buffer.push_back( ( tracked ? FLAG_TRACKED : 0 ) | ( coded ? FLAG_FRAME_VERTEXES : 0 ) | ( changed ? FLAG_TRACKING_ID : 0 ) );
+    writeSigned( buffer, frame.timestamp - state.timestamp );
+    state.timestamp = frame.timestamp;
+
+    if( tracked ){
+        // Tracking ID ( only if changed )
+        if( changed ){
+            writeVarint( buffer, frame.trackingId );
+            state.trackingId = frame.trackingId;
+        }
+
+        // Animation Units
+        for( int unit = 0; unit < FaceFrame::ANIMATION_UNITS; unit++ ){
+            const int32_t value = quantize( frame.animationUnits[unit], ANIMATION_UNIT_SCALE );
+            writeSigned( buffer, value - state.animationUnits[unit] );
+            state.animationUnits[unit] = value;
+        }
+
+        // Head Pivot Point and Face Orientation
+        for( int axis = 0; axis < 3; axis++ ){
+            const int32_t value = quantize( frame.pivot[axis], PIVOT_SCALE );
+            writeSigned( buffer, value - state.pivot[axis] );
+            state.pivot[axis] = value;
+        }
+        for( int axis = 0; axis < 4; axis++ ){
+            const int32_t value = quantize( frame.orientation[axis], ORIENTATION_SCALE );
+            writeSigned( buffer, value - state.orientation[axis] );
+            state.orientation[axis] = value;
+        }
+
+        // Vertexes ( difference from neutral face in head space )
+        if( coded ){
+            head.resize( FaceFrame::VERTEXES * 3 );
+            toHead( frame.vertexes, state.pivot, state.orientation, &head[0] );
+            for( int value = 0; value < FaceFrame::VERTEXES * 3; value++ ){
+                writeSigned( buffer, head[value] - neutral[value] );
+            }
+        }
+    }
+
+    // Append Frame with Size Prefix
+    writeVarint( chunk, buffer.size() );
+    chunk.insert( chunk.end(), buffer.begin(), buffer.end() );
+    current.frames++;
+    frames++;
+
+    // Write Chunk when Filled
+    if( current.frames == CHUNK_FRAMES ){
+        return flush();
+    }
+
+    return file.good();
+}
+
+// Write Chunk to File
+bool FaceStreamRecorder::flush()
+{
+    if( current.frames == 0 ){
+        return file.good();
+    }
+
+    // Chunk Header
+    std::vector<uint8_t> header;
+    header.insert( header.end(), CHUNK_MAGIC, CHUNK_MAGIC + sizeof( CHUNK_MAGIC ) );
+    writeInteger( header, current.frames, 4 );
+    writeInteger( header, chunk.size(), 4 );
+    writeInteger( header, static_cast<uint64_t>( current.timestamp ), 8 );
+    file.write( reinterpret_cast<const char*>( &header[0] ), header.size() );
+    file.write( reinterpret_cast<const char*>( &chunk[0] ), chunk.size() );
+
+    // Add Chunk to Index
+    current.offset = bytes;
+    index.push_back( current );
+    bytes += header.size() + chunk.size();
+
+    chunk.clear();
+    current.frames = 0;
+
+    return file.good();
+}
+
+// Constructor
+FaceStreamReplayer::FaceStreamReplayer()
+    : vertexes( false ),
+      frames( 0 ),
+      chunkIndex( -1 ),
+      position( 0 ),
+      frameIndex( 0 ),
+      realtime( true ),
+      paced( false ),
+      origin( 0 )
+{
+    state.reset();
+}
+
+// Open File
+bool FaceStreamReplayer::open( const std::string& path )
+{
+    close();
+
+    file.open( path, std::ios::binary );
+    if( !file.is_open() ){
+        return false;
+    }
+
+    // Check Header
+    char magic[4];
+    uint8_t header[4];
+    file.read( magic, sizeof( magic ) );
+    file.read( reinterpret_cast<char*>( header ), sizeof( header ) );
+    if( !file.good() || std::memcmp( magic, MAGIC, sizeof( MAGIC ) ) != 0 || header[0] != VERSION || header[1] != FaceFrame::ANIMATION_UNITS ){
+        close();
+        return false;
+    }
+
+    // Neutral Face
+    vertexes = ( header[2] & FLAG_VERTEXES ) != 0;
+    uint64_t count;
+    if( !readVarint( file, count ) || count != ( vertexes ? FaceFrame::VERTEXES : 0 ) ){
+        close();
+        return false;
+    }
+    neutral.resize( static_cast<size_t>( count * 3 ) );
+    for( int32_t& value : neutral ){
+        uint64_t zigzag;
+        if( !readVarint( file, zigzag ) ){
+            close();
+            return false;
+        }
+        value = static_cast<int32_t>( static_cast<int64_t>( zigzag >> 1 ) ^ -static_cast<int64_t>( zigzag & 1 ) );
+    }
+    const uint64_t begin = static_cast<uint64_t>( file.tellg() );
+
+    // Retrieve File Size
+    file.seekg( 0, std::ios::end );
+    const uint64_t size = static_cast<uint64_t>( file.tellg() );
+
+    // Read Index pointed by Footer, otherwise Scan Chunk Headers ( e.g. recording was not closed )
+    index.clear();
+    bool indexed = false;
+    if( size >= begin + FOOTER_BYTES ){
+        std::vector<uint8_t> footer( FOOTER_BYTES );
+        file.seekg( size - FOOTER_BYTES );
+        file.read( reinterpret_cast<char*>( &footer[0] ), footer.size() );
+        const uint8_t* data = &footer[0];
+        const uint64_t offset = readInteger( data, 8 );
+        if( file.good() && std::memcmp( data, FOOTER_MAGIC, sizeof( FOOTER_MAGIC ) ) == 0 && begin <= offset && offset + 8 <= size - FOOTER_BYTES ){
+            std::vector<uint8_t> buffer( static_cast<size_t>( size - FOOTER_BYTES - offset ) );
+            file.seekg( offset );
+            file.read( reinterpret_cast<char*>( &buffer[0] ), buffer.size() );
+            data = &buffer[0] + sizeof( INDEX_MAGIC );
+            const uint64_t entries = readInteger( data, 4 );
+            if( file.good() && std::memcmp( &buffer[0], INDEX_MAGIC, sizeof( INDEX_MAGIC ) ) == 0 && buffer.size() == 8 + entries * INDEX_ENTRY_BYTES ){
+                indexed = true;
+                int first = 0;
+                for( uint64_t entry = 0; entry < entries; entry++ ){
+                    Entry chunk;
+                    chunk.offset = readInteger( data, 8 );
+                    chunk.timestamp = static_cast<int64_t>( readInteger( data, 8 ) );
+                    chunk.frames = static_cast<int>( readInteger( data, 4 ) );
+                    chunk.first = first;
+                    if( chunk.offset < begin || chunk.offset + CHUNK_HEADER_BYTES > offset ){
+                        indexed = false;
+                        break;
+                    }
+                    first += chunk.frames;
+                    index.push_back( chunk );
+                }
+            }
+        }
+    }
+    file.clear();
+    if( !indexed && !scan( begin, size ) ){
+        close();
+        return false;
+    }
+
+    // Total Number of Frames
+    frames = index.empty() ? 0 : index.back().first + index.back().frames;
+
+    rewind();
+
+    return true;
+}
+
+// Close File
+void FaceStreamReplayer::close()
+{
+    if( file.is_open() ){
+        file.close();
+    }
+    index.clear();
+    frames = 0;
+}
+
+// Build Index by Scanning Chunk Headers
+bool FaceStreamReplayer::scan( const uint64_t begin, const uint64_t end )
+{
+    index.clear();
+
+    // Follow Chunk Headers until Index, Truncated Chunk, or End of File
+    uint64_t offset = begin;
+    int first = 0;
+    uint8_t header[CHUNK_HEADER_BYTES];
+    while( offset + CHUNK_HEADER_BYTES <= end ){
+        file.seekg( offset );
+        file.read( reinterpret_cast<char*>( header ), sizeof( header ) );
+        if( !file.good() || std::memcmp( header, CHUNK_MAGIC, sizeof( CHUNK_MAGIC ) ) != 0 ){
+            break;
+        }
+
+        const uint8_t* data = header + sizeof( CHUNK_MAGIC );
+        Entry chunk;
+        chunk.offset = offset;
+        chunk.frames = static_cast<int>( readInteger( data, 4 ) );
+        const uint64_t bytes = readInteger( data, 4 );
+        chunk.timestamp = static_cast<int64_t>( readInteger( data, 8 ) );
+        chunk.first = first;
+        if( offset + CHUNK_HEADER_BYTES + bytes > end ){
+            break;
+        }
+
+        index.push_back( chunk );
+        first += chunk.frames;
+        offset += CHUNK_HEADER_BYTES + bytes;
+    }
+    file.clear();
+
+    return true;
+}
+
+// Rewind to First Frame
+void FaceStreamReplayer::rewind()
+{
+    if( !file.is_open() ){
+        return;
+    }
+
+    chunkIndex = -1;
+    position = 0;
+    frameIndex = 0;
+    paced = false;
+    state.reset();
+}
+
+// Load Chunk
+bool FaceStreamReplayer::load( const int chunk )
+{
+    if( chunk < 0 || chunk >= static_cast<int>( index.size() ) ){
+        return false;
+    }
+
+    // Read Chunk Header and Frames
+    uint8_t header[CHUNK_HEADER_BYTES];
+    file.clear();
+    file.seekg( index[chunk].offset );
+    file.read( reinterpret_cast<char*>( header ), sizeof( header ) );
+    if( !file.good() || std::memcmp( header, CHUNK_MAGIC, sizeof( CHUNK_MAGIC ) ) != 0 ){
+        return false;
+    }
+    const uint8_t* data = header + sizeof( CHUNK_MAGIC ) + 4;
+    this->chunk.resize( static_cast<size_t>( readInteger( data, 4 ) ) );
+    if( !this->chunk.empty() && !file.read( reinterpret_cast<char*>( &this->chunk[0] ), this->chunk.size() ) ){
+        return false;
+    }
+
+    // First Frame of Chunk is Coded from Zero
+    chunkIndex = chunk;
+    position = 0;
+    frameIndex = index[chunk].first;
+    state.reset();
+
+    return true;
+}
+
+// Decode Next Frame of Loaded Chunk ( only state is updated if frame is not specified )
+bool FaceStreamReplayer::decode( FaceFrame* frame )
+{
+    const uint8_t* data = chunk.data() + position;
+    const uint8_t* end = chunk.data() + chunk.size();
+
+    // Frame Size
+    uint64_t size;
+    if( !readVarint( data, end, size ) || size == 0 || size > static_cast<uint64_t>( end - data ) ){
+        return false;
+    }
+    end = data + size;
+
+    // Frame Header
+    const uint8_t flags = *data++;
+    int64_t timestamp;
+    if( !readSigned( data, end, timestamp ) ){
+        return false;
+    }
+    state.timestamp += timestamp;
+    const bool tracked = ( flags & FLAG_TRACKED ) != 0;
+    const bool coded = ( flags & FLAG_FRAME_VERTEXES ) != 0;
+    if( coded && !( tracked && vertexes ) ){
+        return false;
+    }
+
+    if( tracked ){
+        // Tracking ID ( only if changed )
+        if( flags & FLAG_TRACKING_ID ){
+            if( !readVarint( data, end, state.trackingId ) ){
+                return false;
+            }
+        }
+
+        // Animation Units, Head Pivot Point and Face Orientation
+        int32_t* values[3] = { state.animationUnits, state.pivot, state.orientation };
+        const int counts[3] = { FaceFrame::ANIMATION_UNITS, 3, 4 };
+        for( int group = 0; group < 3; group++ ){
+            for( int value = 0; value < counts[group]; value++ ){
+                int64_t delta;
+                if( !readSigned( data, end, delta ) ){
+                    return false;
+                }
+                values[group][value] += static_cast<int32_t>( delta );
+            }
+        }
+
+        // Vertexes ( difference from neutral face in head space )
+        if( coded && frame != nullptr ){
+            float q[4];
+            restoreOrientation( state.orientation, q );
+            const float p[3] = { state.pivot[0] / PIVOT_SCALE, state.pivot[1] / PIVOT_SCALE, state.pivot[2] / PIVOT_SCALE };
+            for( int vertex = 0; vertex < FaceFrame::VERTEXES; vertex++ ){
+                float h[3];
+                for( int axis = 0; axis < 3; axis++ ){
+                    int64_t delta;
+                    if( !readSigned( data, end, delta ) ){
+                        return false;
+                    }
+                    h[axis] = ( neutral[vertex * 3 + axis] + static_cast<int32_t>( delta ) ) / VERTEX_SCALE;
+                }
+                float v[3];
+                rotate( q, h, v );
+                for( int axis = 0; axis < 3; axis++ ){
+                    frame->vertexes[vertex][axis] = v[axis] + p[axis];
+                }
+            }
+        }
+    }
+
+    // Output Frame
+    if( frame != nullptr ){
+        frame->timestamp = state.timestamp;
+        frame->tracked = tracked ? 1 : 0;
+        frame->trackingId = tracked ? state.trackingId : 0;
+        frame->hasVertexes = coded ? 1 : 0;
+        for( int unit = 0; unit < FaceFrame::ANIMATION_UNITS; unit++ ){
+            frame->animationUnits[unit] = tracked ? state.animationUnits[unit] / ANIMATION_UNIT_SCALE : 0.0f;
+        }
+        for( int axis = 0; axis < 3; axis++ ){
+            frame->pivot[axis] = tracked ? state.pivot[axis] / PIVOT_SCALE : 0.0f;
+        }
+        for( int axis = 0; axis < 4; axis++ ){
+            frame->orientation[axis] = tracked ? state.orientation[axis] / ORIENTATION_SCALE : 0.0f;
+        }
+    }
+
+    // Move to Next Frame ( vertexes that are not reconstructed are skipped by frame size )
+    position = end - chunk.data();
+    frameIndex++;
+
+    return true;
+}
+
+// Read Next Frame
+bool FaceStreamReplayer::read( FaceFrame& frame )
+{
+    if( !file.is_open() || frameIndex >= frames ){
+        return false;
+    }
+
+    // Load Next Chunk when Loaded Chunk is Finished
+    if( chunkIndex < 0 || frameIndex >= index[chunkIndex].first + index[chunkIndex].frames ){
+        if( !load( chunkIndex + 1 ) ){
+            return false;
+        }
+    }
+
+    if( !decode( &frame ) ){
+        return false;
+    }
+
+    // Pace by RelativeTime ( first frame after open, rewind or seek is the origin )
+    if( !paced ){
+        paced = true;
+        origin = frame.timestamp;
+        start = std::chrono::steady_clock::now();
+    }
+    if( realtime ){
+        const std::chrono::microseconds elapsed( ( frame.timestamp - origin ) / 10 );
+        std::this_thread::sleep_until( start + elapsed );
+    }
+
+    return true;
+}
+
+// Seek to Frame
+bool FaceStreamReplayer::seek( const int frame )
+{
+    if( !file.is_open() || frame < 0 || frame >= frames ){
+        return false;
+    }
+
+    // Find Chunk that Contains Frame
+    const auto entry = std::upper_bound( index.begin(), index.end(), frame, []( const int frame, const Entry& entry ){ return frame < entry.first; } );
+    if( !load( static_cast<int>( entry - index.begin() ) - 1 ) ){
+        return false;
+    }
+
+    // Decode Preceding Frames of Chunk ( delta coded )
+    while( frameIndex < frame ){
+        if( !decode( nullptr ) ){
+            return false;
+        }
+    }
+    paced = false;
+
+    return true;
+}
+
+// Seek to Time
+bool FaceStreamReplayer::seekTime( const int64_t timestamp )
+{
+    if( !file.is_open() || frames == 0 ){
+        return false;
+    }
+
+    // Find Last Chunk that Starts at or before Timestamp
+    const auto entry = std::upper_bound( index.begin(), index.end(), timestamp, []( const int64_t timestamp, const Entry& entry ){ return timestamp < entry.timestamp; } );
+    if( !load( std::max( static_cast<int>( entry - index.begin() ) - 1, 0 ) ) ){
+        return false;
+    }
+
+    // Decode Frames before Timestamp ( next chunk starts after timestamp if this chunk is finished )
+    const int last = index[chunkIndex].first + index[chunkIndex].frames;
+    while( frameIndex < last ){
+        const FaceStreamState previous = state;
+        const size_t previousPosition = position;
+        if( !decode( nullptr ) ){
+            return false;
+        }
+        if( state.timestamp >= timestamp ){
+            state = previous;
+            position = previousPosition;
+            frameIndex--;
+            break;
+        }
+    }
+    paced = false;
+
+    return frameIndex < frames;
+}
\ No newline at end of file
@@ -0,0 +1,213 @@
+#ifndef __FACE_STREAM__
+#define __FACE_STREAM__
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <chrono>
+#include <cstdint>
+
+// Face Frame
+// Snapshot of HDFace alignment of one face in plain structure ( no dependency on Kinect SDK ).
+// Animation units are stored as same order as FaceShapeAnimations, vertexes are same order as face model.
+struct FaceFrame
+{
+    // Number of Animation Units and Vertexes ( same as FaceShapeAnimations_Count and GetFaceModelVertexCount() )
+    static const int ANIMATION_UNITS = 17;
+    static const int VERTEXES = 1347;
+
+    int64_t timestamp;                       // RelativeTime ( 100 [ns] unit )
+    uint8_t tracked;
+    uint64_t trackingId;
+    float animationUnits[ANIMATION_UNITS];
+    float pivot[3];                          // Head pivot point X, Y, Z [m]
+    float orientation[4];                    // Face orientation X, Y, Z, W
+    uint8_t hasVertexes;
+    float vertexes[VERTEXES][3];             // X, Y, Z [m] in camera space
+};
+
+// Face Stream State
+// Quantized values of previous frame that next frame in same chunk is delta coded against.
+// Animation units are fixed point of 1/10000, pivot is fixed point of 0.1 [mm], orientation is fixed point of 1/16384.
+struct FaceStreamState
+{
+    int64_t timestamp;
+    uint64_t trackingId;
+    int32_t animationUnits[FaceFrame::ANIMATION_UNITS];
+    int32_t pivot[3];
+    int32_t orientation[4];
+
+    // Reset State ( next frame is first frame of chunk )
+    void reset();
+};
+
+// Face Stream Recorder
+// Writes frames in chunks of fixed number of frames, and index of chunks when closed, so that replayer can seek.
+// Animation units and head pose are delta coded from previous frame in same chunk ( each chunk is decoded independently ).
+// Vertexes are optional, and moved into head space ( by pivot and orientation ) and coded as quantized difference from neutral face,
+// which is head space vertexes of the frame given at open ( start recording with neutral expression ).
+class FaceStreamRecorder
+{
+private:
+    std::ofstream file;
+    std::vector<uint8_t> chunk;
+    std::vector<uint8_t> buffer;
+    FaceStreamState state;
+    bool vertexes;
+    std::vector<int32_t> neutral;
+    std::vector<int32_t> head;
+
+    // Index of Chunks
+    struct Entry
+    {
+        uint64_t offset;
+        int64_t timestamp;
+        uint32_t frames;
+    };
+    std::vector<Entry> index;
+    Entry current;
+
+    int frames;
+    uint64_t bytes;
+
+public:
+    // Constructor
+    FaceStreamRecorder();
+
+    // Destructor
+    ~FaceStreamRecorder();
+
+    // Open File ( vertexes are recorded only if neutral face is specified )
+    bool open( const std::string& path, const FaceFrame* neutral = nullptr );
+
+    // Close File ( write remaining chunk and index )
+    void close();
+
+    // Check Opened
+    bool isOpened() const
+    {
+        return file.is_open();
+    }
+
+    // Write Frame
+    bool write( const FaceFrame& frame );
+
+    // Retrieve Number of Frames and Bytes Written
+    int getFrames() const
+    {
+        return frames;
+    }
+
+    uint64_t getBytes() const
+    {
+        return bytes;
+    }
+
+private:
+    // Write Chunk to File
+    bool flush();
+};
+
+// Face Stream Replayer
+// Reads frames written by FaceStreamRecorder, at real-time ( paced by RelativeTime ) or at maximum speed.
+// Chunks are found by index of file, or by scanning chunk headers if file was not closed.
+class FaceStreamReplayer
+{
+private:
+    std::ifstream file;
+    std::vector<uint8_t> chunk;
+    FaceStreamState state;
+    bool vertexes;
+    std::vector<int32_t> neutral;
+
+    // Index of Chunks
+    struct Entry
+    {
+        uint64_t offset;
+        int64_t timestamp;
+        int first;  // Index of first frame
+        int frames;
+    };
+    std::vector<Entry> index;
+    int frames;
+
+    // Position
+    int chunkIndex;   // Index of loaded chunk ( -1 if not loaded )
+    size_t position;  // Read position in loaded chunk
+    int frameIndex;   // Index of next frame
+
+    // Pacing
+    bool realtime;
+    bool paced;
+    int64_t origin;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    // Constructor
+    FaceStreamReplayer();
+
+    // Open File
+    bool open( const std::string& path );
+
+    // Close File
+    void close();
+
+    // Check Opened
+    bool isOpened() const
+    {
+        return file.is_open();
+    }
+
+    // Set Pacing ( true is real-time, false is maximum speed )
+    void setRealtime( const bool realtime )
+    {
+        this->realtime = realtime;
+    }
+
+    // Check Vertexes are Recorded
+    bool hasVertexes() const
+    {
+        return vertexes;
+    }
+
+    // Retrieve Number of Frames and Chunks
+    int getFrames() const
+    {
+        return frames;
+    }
+
+    int getChunks() const
+    {
+        return static_cast<int>( index.size() );
+    }
+
+    // Retrieve Index of Next Frame
+    int tell() const
+    {
+        return frameIndex;
+    }
+
+    // Read Next Frame ( return false at the end of file )
+    bool read( FaceFrame& frame );
+
+    // Seek to Frame ( next read returns the frame )
+    bool seek( const int frame );
+
+    // Seek to Time ( next read returns first frame at or after the timestamp )
+    bool seekTime( const int64_t timestamp );
+
+    // Rewind to First Frame
+    void rewind();
+
+private:
+    // Build Index by Scanning Chunk Headers
+    bool scan( const uint64_t begin, const uint64_t end );
+
+    // Load Chunk
+    bool load( const int chunk );
+
+    // Decode Next Frame of Loaded Chunk ( only state is updated if frame is nullptr )
+    bool decode( FaceFrame* frame );
+};
+
+#endif // __FACE_STREAM__
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include "FaceStreamBenchmark.h"
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <algorithm>
+
+// Constructor
+FaceStreamBenchmark::FaceStreamBenchmark()
+    : frames( 0 ),
+      chunks( 0 ),
+      tracked( 0 ),
+      vertexes( false ),
+      bytes( 0.0 ),
+      rawBytes( 0.0 ),
+      readTime( 0.0 ),
+      seekTime( 0.0 ),
+      duration( 0.0 )
+{
+    std::fill( minimum, minimum + FaceFrame::ANIMATION_UNITS, 0.0f );
+    std::fill( maximum, maximum + FaceFrame::ANIMATION_UNITS, 0.0f );
+    std::fill( mean, mean + FaceFrame::ANIMATION_UNITS, 0.0 );
+}
+
+// Run Benchmark on Recorded File
+bool FaceStreamBenchmark::run( const std::string& path, const int seeks )
+{
+    this->path = path;
+
+    FaceStreamReplayer replayer;
+    if( !replayer.open( path ) ){
+        return false;
+    }
+    replayer.setRealtime( false );
+    frames = replayer.getFrames();
+    chunks = replayer.getChunks();
+    vertexes = replayer.hasVertexes();
+    if( frames == 0 ){
+        return true;
+    }
+
+    // Size of File
+    std::ifstream file( path, std::ios::binary | std::ios::ate );
+    bytes = static_cast<double>( file.tellg() ) / frames;
+    rawBytes = sizeof( FaceFrame );
+
+    // Sequential Read ( frame is large, so it is allocated on heap )
+    std::unique_ptr<FaceFrame> frame( new FaceFrame() );
+    std::fill( minimum, minimum + FaceFrame::ANIMATION_UNITS, 1.0f );
+    std::fill( maximum, maximum + FaceFrame::ANIMATION_UNITS, -1.0f );
+    std::fill( mean, mean + FaceFrame::ANIMATION_UNITS, 0.0 );
+    tracked = 0;
+    int64_t first = 0, last = 0;
+    int count = 0;
+    const std::chrono::steady_clock::time_point readStart = std::chrono::steady_clock::now();
+    while( replayer.read( *frame ) ){
+        if( count++ == 0 ){
+            first = frame->timestamp;
+        }
+        last = frame->timestamp;
+        if( !frame->tracked ){
+            continue;
+        }
+
+        // Summarize Animation Units
+        tracked++;
+        for( int unit = 0; unit < FaceFrame::ANIMATION_UNITS; unit++ ){
+            minimum[unit] = std::min( minimum[unit], frame->animationUnits[unit] );
+            maximum[unit] = std::max( maximum[unit], frame->animationUnits[unit] );
+            mean[unit] += frame->animationUnits[unit];
+        }
+    }
+    readTime = std::chrono::duration<double, std::micro>( std::chrono::steady_clock::now() - readStart ).count() / std::max( count, 1 );
+    duration = ( last - first ) / 10000000.0;
+    for( int unit = 0; unit < FaceFrame::ANIMATION_UNITS; unit++ ){
+        mean[unit] = tracked ? mean[unit] / tracked : 0.0;
+    }
+
+    // Random Seek and Read
+    std::mt19937 random( 0 );
+    std::uniform_int_distribution<int> distribution( 0, frames - 1 );
+    const std::chrono::steady_clock::time_point seekStart = std::chrono::steady_clock::now();
+    for( int seek = 0; seek < seeks; seek++ ){
+        replayer.seek( distribution( random ) );
+        replayer.read( *frame );
+    }
+    seekTime = std::chrono::duration<double, std::micro>( std::chrono::steady_clock::now() - seekStart ).count() / std::max( seeks, 1 );
+
+    return true;
+}
+
+// Print Results
+void FaceStreamBenchmark::print( std::ostream& stream ) const
+{
+    stream << path << " : " << frames << " frames ( " << tracked << " tracked ), " << chunks << " chunks, "
+           << std::fixed << std::setprecision( 1 ) << duration << " [s], " << ( vertexes ? "with" : "without" ) << " vertexes" << std::endl;
+
+    stream << std::endl;
+    stream << std::left << std::setw( 10 ) << "Stream" << std::right
+           << std::setw( 14 ) << "Bytes/Frame"
+           << std::setw( 14 ) << "Raw/Frame"
+           << std::setw( 14 ) << "Read [us]"
+           << std::setw( 14 ) << "Seek [us]" << std::endl;
+    stream << std::left << std::setw( 10 ) << "Face" << std::right << std::fixed << std::setprecision( 1 )
+           << std::setw( 14 ) << bytes
+           << std::setw( 14 ) << rawBytes
+           << std::setw( 14 ) << readTime
+           << std::setw( 14 ) << seekTime << std::endl;
+
+    stream << std::endl;
+    stream << std::left << std::setw( 10 ) << "AU" << std::right
+           << std::setw( 14 ) << "Min"
+           << std::setw( 14 ) << "Mean"
+           << std::setw( 14 ) << "Max" << std::endl;
+    for( int unit = 0; unit < FaceFrame::ANIMATION_UNITS; unit++ ){
+        stream << std::left << std::setw( 10 ) << unit << std::right << std::fixed << std::setprecision( 4 )
+               << std::setw( 14 ) << ( tracked ? minimum[unit] : 0.0f )
+               << std::setw( 14 ) << mean[unit]
+               << std::setw( 14 ) << ( tracked ? maximum[unit] : 0.0f ) << std::endl;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#ifndef __FACE_STREAM_BENCHMARK__
+#define __FACE_STREAM_BENCHMARK__
+
+#include "FaceStream.h"
+
+#include <string>
+#include <ostream>
+
+// Face Stream Benchmark
+// Recorded face stream is replayed at maximum speed to measure size, decoding and seeking ( e.g. analysis on Linux ).
+// Animation units of tracked frames are summarized, so that recording can be checked before retargeting.
+// This class has no dependency on Kinect SDK.
+class FaceStreamBenchmark
+{
+private:
+    std::string path;
+    int frames;
+    int chunks;
+    int tracked;
+    bool vertexes;
+    double bytes;       // [byte/frame], file size per frame
+    double rawBytes;    // [byte/frame], FaceFrame per frame
+    double readTime;    // [us/frame], sequential read
+    double seekTime;    // [us/seek], random seek and read
+    double duration;    // [s], RelativeTime from first to last frame
+    float minimum[FaceFrame::ANIMATION_UNITS];
+    float maximum[FaceFrame::ANIMATION_UNITS];
+    double mean[FaceFrame::ANIMATION_UNITS];
+
+public:
+    // Constructor
+    FaceStreamBenchmark();
+
+    // Run Benchmark on Recorded File ( return false if file can not be opened )
+    bool run( const std::string& path, const int seeks = 1000 );
+
+    // Print Results
+    void print( std::ostream& stream ) const;
+};
+
+#endif // __FACE_STREAM_BENCHMARK__
\ No newline at end of file
@@ -0,0 +1,28 @@
+#include <iostream>
+#include <string>
+#include <stdexcept>
+
+#include "FaceStreamBenchmark.h"
+
+// Face Stream Benchmark
+// Recorded face stream is benchmarked without sensor ( e.g. analysis on Linux ), same as "HDFace benchmark <file>".
+// This program has no dependency on Kinect SDK and OpenCV.
+int main( int argc, char* argv[] )
+{
+    try{
+        if( argc < 2 ){
+            throw std::runtime_error( "usage : FaceStreamBenchmark <recorded face stream file>" );
+        }
+
+        FaceStreamBenchmark benchmark;
+        if( !benchmark.run( argv[1] ) ){
+            throw std::runtime_error( "failed FaceStreamBenchmark::run( " + std::string( argv[1] ) + " )" );
+        }
+        benchmark.print( std::cout );
+        return 0;
+    } catch( std::exception& ex ){
+        std::cout << ex.what() << std::endl;
+    }
+
+    return 1;
+}
\ No newline at end of file
@@ -0,0 +1,216 @@
+#include "MeshRasterizer.h"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+// Minimum Width of Bounding Box to Find Span of Each Row [px]
+static const int SPAN = 8;
+
+// Constructor
+MeshRasterizer::MeshRasterizer()
+    : count( 0 )
+{
+}
+
+// Set Triangles
+void MeshRasterizer::setTriangles( const uint32_t* indices, const int triangles )
+{
+    this->indices.assign( indices, indices + triangles * 3 );
+    setups.resize( triangles );
+    count = 0;
+}
+
+// Set Up Triangles Visible in Image
+bool MeshRasterizer::setup( const int width, const int height, const VertexProjection& projection, const float scale, int& left, int& top, int& right, int& bottom )
+{
+    const VertexProjection::CameraPoint* vertexes = projection.getCameraPoints();
+    const VertexProjection::ColorPoint* points = projection.getColorPoints();
+    const int vertexCount = projection.getCount();
+
+    left = width;
+    top = height;
+    right = -1;
+    bottom = -1;
+    count = 0;
+
+    for( size_t triangle = 0; triangle < indices.size(); triangle += 3 ){
+        // Projected Points ( invalid points are mapped to -Infinity )
+        float x[3], y[3], z[3];
+        bool valid = true;
+        for( int corner = 0; corner < 3; corner++ ){
+            const uint32_t index = indices[triangle + corner];
+            if( index >= static_cast<uint32_t>( vertexCount ) ){
+                valid = false;
+                break;
+            }
+            x[corner] = points[index].X * scale;
+            y[corner] = points[index].Y * scale;
+            z[corner] = vertexes[index].Z;
+            valid = valid && std::isfinite( x[corner] ) && std::isfinite( y[corner] ) && z[corner] > 0.0f;
+        }
+        if( !valid ){
+            continue;
+        }
+
+        // Skip Degenerate Triangle
+        const float area = ( x[1] - x[0] ) * ( y[2] - y[0] ) - ( x[2] - x[0] ) * ( y[1] - y[0] );
+        if( std::abs( area ) < 1e-6f ){
+            continue;
+        }
+
+        // Bounding Box in Image
+        Setup& s = setups[count];
+        s.left = std::max( static_cast<int>( std::floor( std::min( { x[0], x[1], x[2] } ) ) ), 0 );
+        s.top = std::max( static_cast<int>( std::floor( std::min( { y[0], y[1], y[2] } ) ) ), 0 );
+        s.right = std::min( static_cast<int>( std::ceil( std::max( { x[0], x[1], x[2] } ) ) ), width - 1 );
+        s.bottom = std::min( static_cast<int>( std::ceil( std::max( { y[0], y[1], y[2] } ) ) ), height - 1 );
+        if( s.left > s.right || s.top > s.bottom ){
+            continue;
+        }
+
+        // Planes of Barycentric Coordinates and Depth
+        const float inverse = 1.0f / area;
+        for( int corner = 0; corner < 3; corner++ ){
+            const int a = ( corner + 1 ) % 3, b = ( corner + 2 ) % 3;
+            s.edges[corner][0] = ( y[a] - y[b] ) * inverse;
+            s.edges[corner][1] = ( x[b] - x[a] ) * inverse;
+            s.edges[corner][2] = ( x[a] * y[b] - x[b] * y[a] ) * inverse;
+            s.distances[corner] = std::abs( area ) / std::max( std::sqrt( ( x[b] - x[a] ) * ( x[b] - x[a] ) + ( y[b] - y[a] ) * ( y[b] - y[a] ) ), 1e-6f );
+        }
+        for( int axis = 0; axis < 3; axis++ ){
+            s.depth[axis] = s.edges[0][axis] * z[0] + s.edges[1][axis] * z[1] + s.edges[2][axis] * z[2];
+        }
+
+        // Flat Shading ( angle between normal and direction to camera )
+        const VertexProjection::CameraPoint& p0 = vertexes[indices[triangle]];
+        const VertexProjection::CameraPoint& p1 = vertexes[indices[triangle + 1]];
+        const VertexProjection::CameraPoint& p2 = vertexes[indices[triangle + 2]];
+        const float ux = p1.X - p0.X, uy = p1.Y - p0.Y, uz = p1.Z - p0.Z;
+        const float vx = p2.X - p0.X, vy = p2.Y - p0.Y, vz = p2.Z - p0.Z;
+        const float nx = uy * vz - uz * vy, ny = uz * vx - ux * vz, nz = ux * vy - uy * vx;
+        const float cx = p0.X + p1.X + p2.X, cy = p0.Y + p1.Y + p2.Y, cz = p0.Z + p1.Z + p2.Z;
+        const float length = std::sqrt( ( nx * nx + ny * ny + nz * nz ) * ( cx * cx + cy * cy + cz * cz ) );
+        s.intensity = 0.3f + 0.7f * ( length > 0.0f ? std::abs( nx * cx + ny * cy + nz * cz ) / length : 1.0f );
+
+        left = std::min( left, s.left );
+        top = std::min( top, s.top );
+        right = std::max( right, s.right );
+        bottom = std::max( bottom, s.bottom );
+        count++;
+    }
+
+    return count > 0;
+}
+
+// Draw Mesh into Image
+void MeshRasterizer::draw( uint8_t* image, const int width, const int height, const int step, const int channels, const VertexProjection& projection, const float scale, const Mode mode, const uint8_t color[3], const float opacity )
+{
+    // Set Up Triangles
+    int left, top, right, bottom;
+    if( !setup( width, height, projection, scale, left, top, right, bottom ) ){
+        return;
+    }
+
+    // Tiles Covering Visible Triangles
+    const int columns = ( right - left ) / TILE + 1;
+    const int rows = ( bottom - top ) / TILE + 1;
+    const float infinity = std::numeric_limits<float>::infinity();
+    const bool wireframe = ( mode == Wireframe );
+
+    #pragma omp parallel for schedule( dynamic )
+    for( int tile = 0; tile < columns * rows; tile++ ){
+        const int x0 = left + ( tile % columns ) * TILE;
+        const int y0 = top + ( tile / columns ) * TILE;
+        const int x1 = std::min( x0 + TILE - 1, right );
+        const int y1 = std::min( y0 + TILE - 1, bottom );
+
+        // Z-Buffer and Shade of Tile ( shade is negative if no triangle is drawn )
+        float depths[TILE * TILE];
+        float shades[TILE * TILE];
+        std::fill( depths, depths + TILE * TILE, infinity );
+        std::fill( shades, shades + TILE * TILE, -1.0f );
+
+        // Rasterize Triangles Overlapping Tile
+        bool drawn = false;
+        for( int triangle = 0; triangle < count; triangle++ ){
+            const Setup& s = setups[triangle];
+            if( s.right < x0 || x1 < s.left || s.bottom < y0 || y1 < s.top ){
+                continue;
+            }
+            drawn = true;
+
+            const int xs = std::max( s.left, x0 ), xe = std::min( s.right, x1 );
+            const int ys = std::max( s.top, y0 ), ye = std::min( s.bottom, y1 );
+            const bool wide = ( xe - xs ) >= SPAN;
+
+            // Copy Steps to Local ( stores into tile buffer may alias triangle setup )
+            const float steps[4] = { s.edges[0][0], s.edges[1][0], s.edges[2][0], s.depth[0] };
+            const float distances[3] = { s.distances[0], s.distances[1], s.distances[2] };
+            const float intensity = s.intensity;
+            for( int y = ys; y <= ye; y++ ){
+                const float py = y + 0.5f;
+
+                // Span of Row inside Triangle ( only for wide triangle, small triangle is tested in whole bounding box )
+                float minimum = static_cast<float>( xs ), maximum = static_cast<float>( xe );
+                for( int edge = 0; wide && edge < 3; edge++ ){
+                    const float a = s.edges[edge][0];
+                    const float c = s.edges[edge][1] * py + s.edges[edge][2];
+                    if( a > 0.0f ){
+                        minimum = std::max( minimum, -c / a - 0.5f - 1.0f );
+                    }
+                    else if( a < 0.0f ){
+                        maximum = std::min( maximum, -c / a - 0.5f + 1.0f );
+                    }
+                    else if( c < 0.0f ){
+                        maximum = minimum - 1.0f;
+                    }
+                }
+                if( !( minimum <= maximum ) ){
+                    continue;
+                }
+
+                // Barycentric Coordinates and Depth at First Pixel Center of Span ( stepped by 1 [px] )
+                // Span is not negative, so that truncation is floor ( std::ceil and std::floor are not inlined without SSE4.1 )
+                const int end = static_cast<int>( maximum );
+                int begin = static_cast<int>( minimum );
+                begin += ( begin < minimum ) ? 1 : 0;
+                const float px = begin + 0.5f;
+                float b0 = s.edges[0][0] * px + s.edges[0][1] * py + s.edges[0][2];
+                float b1 = s.edges[1][0] * px + s.edges[1][1] * py + s.edges[1][2];
+                float b2 = s.edges[2][0] * px + s.edges[2][1] * py + s.edges[2][2];
+                float z = s.depth[0] * px + s.depth[1] * py + s.depth[2];
+                float* depth = depths + ( y - y0 ) * TILE + ( begin - x0 );
+                float* shade = shades + ( y - y0 ) * TILE + ( begin - x0 );
+                for( int x = begin; x <= end; x++, depth++, shade++, b0 += steps[0], b1 += steps[1], b2 += steps[2], z += steps[3] ){
+                    // Shade ( wireframe is drawn within 1 [px] from edges, and hidden inside of triangle )
+                    const float distance = std::min( std::min( b0 * distances[0], b1 * distances[1] ), b2 * distances[2] );
+                    const float value = wireframe ? ( ( distance < 1.0f ) ? 1.0f : 0.0f ) : intensity;
+
+                    // Inside Test at Pixel Center and Depth Test ( selection without branch, inside test is not predictable )
+                    const bool visible = ( b0 >= 0.0f ) & ( b1 >= 0.0f ) & ( b2 >= 0.0f ) & ( z < *depth );
+                    *depth = visible ? z : *depth;
+                    *shade = visible ? value : *shade;
+                }
+            }
+        }
+        if( !drawn ){
+            continue;
+        }
+
+        // Blend Shaded Color into Image
+        for( int y = y0; y <= y1; y++ ){
+            uint8_t* pixel = image + y * step + x0 * channels;
+            const float* shade = shades + ( y - y0 ) * TILE;
+            for( int x = 0; x <= x1 - x0; x++, pixel += channels ){
+                if( !( shade[x] > 0.0f ) ){
+                    continue;
+                }
+                const float weight = opacity * shade[x];
+                for( int channel = 0; channel < 3; channel++ ){
+                    pixel[channel] = static_cast<uint8_t>( pixel[channel] * ( 1.0f - opacity ) + color[channel] * weight + 0.5f );
+                }
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#ifndef __MESH_RASTERIZER__
+#define __MESH_RASTERIZER__
+
+#include "VertexProjection.h"
+
+#include <vector>
+#include <cstdint>
+
+// Mesh Rasterizer
+// Triangles of face model are rasterized with z-buffer, and drawn as flat shaded surface or wireframe of visible edges.
+// Image is split into tiles that are rasterized in parallel, and each tile has its own z-buffer on stack,
+// so that memory is allocated only for triangle setup when triangles are set ( nothing is allocated per frame ).
+// Projected points can be scaled to draw into image of other resolution ( e.g. half resolution preview ).
+// This class has no dependency on Kinect SDK.
+class MeshRasterizer
+{
+public:
+    // Drawing Mode
+    enum Mode
+    {
+        Shaded,
+        Wireframe
+    };
+
+    // Size of Tile [px]
+    static const int TILE = 32;
+
+private:
+    // Triangle Setup ( barycentric coordinates and depth are planes in image space )
+    struct Setup
+    {
+        int left, top, right, bottom; // Bounding box in image [px] ( inclusive )
+        float edges[3][3];            // Barycentric coordinate b = a * x + b * y + c
+        float depth[3];               // Depth z = a * x + b * y + c
+        float distances[3];           // Scale from barycentric coordinate to distance from opposite edge [px]
+        float intensity;              // Flat shading ( Lambert, light at camera )
+    };
+
+    std::vector<uint32_t> indices;
+    std::vector<Setup> setups;
+    int count;
+
+public:
+    // Constructor
+    MeshRasterizer();
+
+    // Set Triangles ( 3 vertex indices per triangle )
+    void setTriangles( const uint32_t* indices, const int triangles );
+
+    // Draw Mesh into Image ( 3 or 4 channels, BGR order ), projected points are multiplied by scale
+    void draw( uint8_t* image, const int width, const int height, const int step, const int channels, const VertexProjection& projection, const float scale, const Mode mode, const uint8_t color[3], const float opacity = 0.6f );
+
+    // Retrieve Number of Triangles
+    int getTriangles() const
+    {
+        return static_cast<int>( indices.size() / 3 );
+    }
+
+private:
+    // Set Up Triangles Visible in Image ( return bounding box of visible triangles )
+    bool setup( const int width, const int height, const VertexProjection& projection, const float scale, int& left, int& top, int& right, int& bottom );
+};
+
+#endif // __MESH_RASTERIZER__
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "TrackingIdManager.h"
+
+#include <algorithm>
+
+// Constructor
+TrackingIdManager::TrackingIdManager( const int count, const int hold, const float margin )
+    : slots( count ),
+      hold( hold ),
+      margin( margin )
+{
+    events.reserve( count * 2 );
+
+    // Clear
+    clear();
+}
+
+// Update Assignment by Candidates of This Frame
+const std::vector<TrackingIdManager::Event>& TrackingIdManager::update( const Candidate* candidates, const int count )
+{
+    events.clear();
+
+    // Continue Bodies of Slots ( lost after missing for hold frames )
+    unassigned.clear();
+    for( int index = 0; index < count; index++ ){
+        unassigned.push_back( index );
+    }
+    for( int index = 0; index < static_cast<int>( slots.size() ); index++ ){
+        Slot& slot = slots[index];
+        if( slot.trackingId == 0 ){
+            continue;
+        }
+
+        const std::vector<int>::iterator it = std::find_if( unassigned.begin(), unassigned.end(), [&]( const int candidate ){ return candidates[candidate].trackingId == slot.trackingId; } );
+        if( it != unassigned.end() ){
+            slot.priority = candidates[*it].priority;
+            slot.missing = 0;
+            unassigned.erase( it );
+            continue;
+        }
+
+        if( ++slot.missing >= hold ){
+            const Event event = { Lost, index, slot.trackingId, 0 };
+            events.push_back( event );
+            slot.trackingId = 0;
+            slot.challenger = 0;
+            slot.challenge = 0;
+        }
+    }
+
+    // Sort Unassigned Candidates by Priority
+    std::stable_sort( unassigned.begin(), unassigned.end(), [&]( const int a, const int b ){ return candidates[a].priority < candidates[b].priority; } );
+
+    // Assign Free Slots to Best Candidates
+    std::vector<int>::iterator best = unassigned.begin();
+    for( int index = 0; index < static_cast<int>( slots.size() ) && best != unassigned.end(); index++ ){
+        Slot& slot = slots[index];
+        if( slot.trackingId != 0 ){
+            continue;
+        }
+
+        slot.trackingId = candidates[*best].trackingId;
+        slot.priority = candidates[*best].priority;
+        slot.missing = 0;
+        const Event event = { Entered, index, 0, slot.trackingId };
+        events.push_back( event );
+        ++best;
+    }
+
+    // Challenge Worst Present Slot by Best Remaining Candidate ( swapped only if better by margin for hold frames )
+    int worst = -1;
+    for( int index = 0; index < static_cast<int>( slots.size() ); index++ ){
+        const Slot& slot = slots[index];
+        if( slot.trackingId != 0 && slot.missing == 0 && ( worst == -1 || slots[worst].priority < slot.priority ) ){
+            worst = index;
+        }
+    }
+    for( int index = 0; index < static_cast<int>( slots.size() ); index++ ){
+        Slot& slot = slots[index];
+        if( index != worst || best == unassigned.end() || !( candidates[*best].priority < slot.priority - margin ) ){
+            slot.challenger = 0;
+            slot.challenge = 0;
+            continue;
+        }
+
+        const Candidate& challenger = candidates[*best];
+        slot.challenge = ( slot.challenger == challenger.trackingId ) ? slot.challenge + 1 : 1;
+        slot.challenger = challenger.trackingId;
+        if( slot.challenge >= hold ){
+            const Event event = { Swapped, index, slot.trackingId, challenger.trackingId };
+            events.push_back( event );
+            slot.trackingId = challenger.trackingId;
+            slot.priority = challenger.priority;
+            slot.challenger = 0;
+            slot.challenge = 0;
+        }
+    }
+
+    return events;
+}
+
+// Release All Slots
+void TrackingIdManager::clear()
+{
+    for( Slot& slot : slots ){
+        slot.trackingId = 0;
+        slot.priority = 0.0f;
+        slot.missing = 0;
+        slot.challenger = 0;
+        slot.challenge = 0;
+    }
+    events.clear();
+}
+
+// Find Slot of Tracking ID
+int TrackingIdManager::find( const uint64_t trackingId ) const
+{
+    if( trackingId == 0 ){
+        return -1;
+    }
+
+    for( int index = 0; index < static_cast<int>( slots.size() ); index++ ){
+        if( slots[index].trackingId == trackingId ){
+            return index;
+        }
+    }
+
+    return -1;
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#ifndef __TRACKING_ID_MANAGER__
+#define __TRACKING_ID_MANAGER__
+
+#include <vector>
+#include <cstdint>
+
+// Tracking ID Manager
+// Tracked bodies are assigned to reader slots ( face, HD face, gesture ) with hysteresis, and lifecycle events of slots are reported.
+// Body keeps its slot while it is tracked, and it is lost only after missing for hold frames ( short dropouts do not restart trackers ).
+// If bodies are more than slots, slot is swapped to better candidate only after it is better by margin for hold frames.
+// So that reader should re-register tracking ID only on Entered or Swapped events.
+// This class has no dependency on Kinect SDK.
+class TrackingIdManager
+{
+public:
+    // Candidate Body
+    struct Candidate
+    {
+        uint64_t trackingId;
+        float priority; // Lower values are preferred ( e.g. distance from sensor )
+    };
+
+    // Lifecycle Event of Slot
+    enum EventType
+    {
+        Entered, // Free slot is assigned to body
+        Lost,    // Body of slot is lost, and slot is free
+        Swapped  // Body of slot is replaced by better candidate
+    };
+
+    struct Event
+    {
+        EventType type;
+        int slot;
+        uint64_t previousId; // 0 if entered
+        uint64_t trackingId; // 0 if lost
+    };
+
+private:
+    // Slot
+    struct Slot
+    {
+        uint64_t trackingId; // 0 if free
+        float priority;
+        int missing;         // Number of frames that body is missing
+        uint64_t challenger; // Better candidate
+        int challenge;       // Number of frames that challenger is better
+    };
+
+    std::vector<Slot> slots;
+    std::vector<Event> events;
+    std::vector<int> unassigned;
+    int hold;
+    float margin;
+
+public:
+    // Constructor ( hold is 15 frames, 0.5 [s] at 30 [fps] )
+    TrackingIdManager( const int count = 6, const int hold = 15, const float margin = 0.1f );
+
+    // Update Assignment by Candidates of This Frame ( return events of this frame )
+    const std::vector<Event>& update( const Candidate* candidates, const int count );
+
+    // Release All Slots
+    void clear();
+
+    // Retrieve Tracking ID of Slot ( 0 if free )
+    uint64_t getTrackingId( const int slot ) const
+    {
+        return slots[slot].trackingId;
+    }
+
+    // Retrieve Number of Slots
+    int getSlots() const
+    {
+        return static_cast<int>( slots.size() );
+    }
+
+    // Find Slot of Tracking ID ( -1 if not assigned )
+    int find( const uint64_t trackingId ) const;
+};
+
+#endif // __TRACKING_ID_MANAGER__
\ No newline at end of file
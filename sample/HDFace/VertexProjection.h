@@ -0,0 +1,89 @@
+#ifndef __VERTEX_PROJECTION__
+#define __VERTEX_PROJECTION__
+
+#include <vector>
+#include <string>
+
+// Vertex Projection
+// Vertices of HD face are kept in persistent buffer, and projected to color space in one batch.
+// Live, the buffer is passed to ICoordinateMapper::MapCameraPointsToColorSpace().
+// Offline ( e.g. on Linux ), it is projected with a pinhole and radial distortion model fitted from the coordinate mapper.
+// This class has no dependency on Kinect SDK.
+class VertexProjection
+{
+public:
+    // Camera Space Point ( same layout as CameraSpacePoint )
+    struct CameraPoint
+    {
+        float X;
+        float Y;
+        float Z;
+    };
+
+    // Color Space Point ( same layout as ColorSpacePoint )
+    struct ColorPoint
+    {
+        float X;
+        float Y;
+    };
+
+    // Color Camera Model ( same as SkeletonProjection::Calibration of JointSmooth sample )
+    // x = ( X + tx ) / Z, y = ( Y + ty ) / Z, d = 1 + k1 * r^2 + k2 * r^4, u = cx + fx * x * d, v = cy + fy * y * d
+    struct Calibration
+    {
+        float fx, fy;
+        float cx, cy;
+        float tx, ty;
+        float k1, k2;
+
+        // Fit Model from Corresponding Points ( return false if points are not enough )
+        bool fit( const CameraPoint* cameraPoints, const ColorPoint* colorPoints, const int count );
+
+        // Save/Load Model to/from Text File
+        bool save( const std::string& path ) const;
+        bool load( const std::string& path );
+    };
+
+private:
+    // Vertex Buffers ( allocated once )
+    std::vector<CameraPoint> cameraPoints;
+    std::vector<ColorPoint> colorPoints;
+
+public:
+    // Constructor
+    VertexProjection();
+
+    // Allocate Buffers for Vertices
+    void resize( const int count );
+
+    // Project Vertices with Color Camera Model
+    void project( const Calibration& calibration );
+
+    // Retrieve Buffers ( vertices are written to camera points, and projected to color points with coordinate mapper )
+    CameraPoint* getCameraPoints()
+    {
+        return cameraPoints.data();
+    }
+
+    const CameraPoint* getCameraPoints() const
+    {
+        return cameraPoints.data();
+    }
+
+    ColorPoint* getColorPoints()
+    {
+        return colorPoints.data();
+    }
+
+    const ColorPoint* getColorPoints() const
+    {
+        return colorPoints.data();
+    }
+
+    int getCount() const
+    {
+        return static_cast<int>( cameraPoints.size() );
+    }
+};
+
+#endif // __VERTEX_PROJECTION__
\ No newline at end of file
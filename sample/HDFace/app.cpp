@@ -1,17 +1,29 @@
 #include "app.h"
 #include "util.h"
 
+#include <iostream>
 #include <thread>
 #include <chrono>
 #include <limits>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
 #define _USE_MATH_DEFINES
 #include <math.h>
 
 #include <omp.h>
 
+//#define BENCHMARK
+
 // Constructor
-Kinect::Kinect()
+Kinect::Kinect( const std::string& operatorId )
+    : operatorId( operatorId )
 {
+    // Check Operator ID
+    if( !operatorId.empty() && !FaceModelStore::isValid( operatorId ) ){
+        throw std::runtime_error( "invalid operator ID ( " + operatorId + " )" );
+    }
+
     // Initialize
     initialize();
 }
@@ -42,6 +54,27 @@ void Kinect::run()
         if( key == VK_ESCAPE ){
             break;
         }
+        else if( key == 'c' ){
+            saveCalibration();
+        }
+        else if( key == 'p' && calibrated ){
+            useCalibration = !useCalibration;
+        }
+        else if( key == 'n' && loaded ){
+            restartCollection();
+        }
+        else if( key == 'r' ){
+            toggleRecording( false );
+        }
+        else if( key == 'v' ){
+            toggleRecording( true );
+        }
+        else if( key == 'm' ){
+            drawMode = static_cast<DrawMode>( ( drawMode + 1 ) % 3 );
+        }
+        else if( key == 'd' ){
+            decodeRegions = !decodeRegions;
+        }
     }
 }
 
@@ -62,6 +95,12 @@ void Kinect::initialize()
     // Initialize HDFace
     initializeHDFace();
 
+    // Initialize Face Frame
+    std::memset( &faceFrame, 0, sizeof( FaceFrame ) );
+
+    // Load Calibration of Color Camera ( vertexes are projected with coordinate mapper, unless color camera model is toggled by 'p' )
+    calibrated = calibration.load( "ColorCalibration.txt" );
+
     // Wait a Few Seconds until begins to Retrieve Data from Sensor ( about 2000-[ms] )
     std::this_thread::sleep_for( std::chrono::seconds( 2 ) );
 }
@@ -102,6 +141,9 @@ inline void Kinect::initializeColor()
 
     // Allocation Color Buffer
     colorBuffer.resize( colorWidth * colorHeight * colorBytesPerPixel );
+
+    // Initialize Color Region Decoder
+    decoder.initialize( colorWidth, colorHeight, 4 );
 }
 
 // Initialize Body
@@ -130,10 +172,36 @@ inline void Kinect::initializeHDFace()
     ERROR_CHECK( CreateFaceModel( 1.0f, FaceShapeDeformations::FaceShapeDeformations_Count, &faceShapeUnits[0], &faceModel ) );
     ERROR_CHECK( GetFaceModelVertexCount( &vertexCount ) ); // 1347
 
-    // Create and Start Face Model Builder
-    FaceModelBuilderAttributes attribures = FaceModelBuilderAttributes::FaceModelBuilderAttributes_None;
+    // Allocate Vertex Buffer
+    projection.resize( vertexCount );
+
+    // Retrieve Triangles of Face Model
+    UINT32 triangleCount;
+    ERROR_CHECK( GetFaceModelTriangleCount( &triangleCount ) ); // 2630
+    std::vector<UINT32> triangles( triangleCount * 3 );
+    ERROR_CHECK( GetFaceModelTriangles( static_cast<UINT>( triangles.size() ), &triangles[0] ) );
+    rasterizer.setTriangles( reinterpret_cast<const uint32_t*>( &triangles[0] ), triangleCount );
+
+    // Offsets of Vertex Disk ( radius 2 )
+    const int radius = 2;
+    for( int y = -radius; y <= radius; y++ ){
+        for( int x = -radius; x <= radius; x++ ){
+            if( x * x + y * y <= radius * radius ){
+                disk.push_back( cv::Point( x, y ) );
+            }
+        }
+    }
+
+    // Create Face Model Builder ( hair and skin color are collected to store with face model )
+    FaceModelBuilderAttributes attribures = static_cast<FaceModelBuilderAttributes>( FaceModelBuilderAttributes::FaceModelBuilderAttributes_HairColor | FaceModelBuilderAttributes::FaceModelBuilderAttributes_SkinColor );
     ERROR_CHECK( hdFaceFrameSource->OpenModelBuilder( attribures, &faceModelBuilder ) );
-    ERROR_CHECK( faceModelBuilder->BeginFaceDataCollection() );
+
+    // Load Face Model of Operator, otherwise Start Face Data Collection
+    loaded = loadFaceModel();
+    produced = loaded;
+    if( !loaded ){
+        ERROR_CHECK( faceModelBuilder->BeginFaceDataCollection() );
+    }
 
     // Color Table for Visualization
     colors[0] = cv::Vec3b( 255,   0,   0 ); // Blue
@@ -149,6 +217,11 @@ void Kinect::finalize()
 {
     cv::destroyAllWindows();
 
+    // Wait Face Model Production
+    if( producer.joinable() ){
+        producer.join();
+    }
+
     // Close Sensor
     if( kinect != nullptr ){
         kinect->Close();
@@ -166,6 +239,9 @@ void Kinect::update()
 
     // Update HDFace
     updateHDFace();
+
+    // Update Face Model Production
+    updateProduction();
 }
 
 // Update Color
@@ -178,10 +254,106 @@ inline void Kinect::updateColor()
         return;
     }
 
+#ifdef BENCHMARK
+    // Benchmark Color
+    benchmarkColor( colorFrame );
+#else
+    // Decode Region of Face and Preview ( fall back to conversion of whole frame if raw format is not YUY2 )
+    if( decodeRegions && decodeColor( colorFrame ) ){
+        return;
+    }
+    decodeRegions = false;
+
     // Convert Format ( YUY2 -> BGRA )
     ERROR_CHECK( colorFrame->CopyConvertedFrameDataToArray( static_cast<UINT>( colorBuffer.size() ), &colorBuffer[0], ColorImageFormat::ColorImageFormat_Bgra ) );
+#endif
+}
+
+// Decode Color
+// Region is requested from bounding box of latest projected vertexes, enlarged by quarter for motion until vertexes of this frame are projected.
+inline bool Kinect::decodeColor( const ComPtr<IColorFrame>& colorFrame )
+{
+    // Check Raw Format
+    ColorImageFormat format;
+    ERROR_CHECK( colorFrame->get_RawColorImageFormat( &format ) );
+    if( format != ColorImageFormat::ColorImageFormat_Yuy2 ){
+        return false;
+    }
+
+    // Request Region of Face ( invalid points are mapped to -Infinity )
+    decoder.clear();
+    if( faceFrame.tracked ){
+        const VertexProjection::ColorPoint* points = projection.getColorPoints();
+        float left = std::numeric_limits<float>::max(), top = std::numeric_limits<float>::max();
+        float right = std::numeric_limits<float>::lowest(), bottom = std::numeric_limits<float>::lowest();
+        for( int index = 0; index < projection.getCount(); index++ ){
+            if( !std::isfinite( points[index].X ) || !std::isfinite( points[index].Y ) ){
+                continue;
+            }
+
+            left = std::min( left, points[index].X );
+            top = std::min( top, points[index].Y );
+            right = std::max( right, points[index].X );
+            bottom = std::max( bottom, points[index].Y );
+        }
+
+        if( left <= right && top <= bottom ){
+            const float marginX = ( right - left ) / 4.0f;
+            const float marginY = ( bottom - top ) / 4.0f;
+            decoder.request( static_cast<int>( std::floor( left - marginX ) ), static_cast<int>( std::floor( top - marginY ) ), static_cast<int>( std::ceil( right + marginX ) ), static_cast<int>( std::ceil( bottom + marginY ) ) );
+        }
+    }
+
+    // Access Raw Frame without Copy ( valid while color frame is held )
+    UINT capacity;
+    BYTE* buffer;
+    ERROR_CHECK( colorFrame->AccessRawUnderlyingBuffer( &capacity, &buffer ) );
+    if( capacity < static_cast<UINT>( colorWidth * colorHeight * 2 ) ){
+        throw std::runtime_error( "failed IColorFrame::AccessRawUnderlyingBuffer()" );
+    }
+
+    // Decode Region into Color Buffer and Preview
+    decoder.decode( buffer, &colorBuffer[0] );
+
+    return true;
 }
 
+#ifdef BENCHMARK
+// Benchmark Color
+inline void Kinect::benchmarkColor( const ComPtr<IColorFrame>& colorFrame )
+{
+    static double convertTime = 0.0;
+    static double decodeTime = 0.0;
+    static double decodedPixels = 0.0;
+    static int frameCount = 0;
+
+    // Convert Whole Frame ( previous conversion )
+    auto start = std::chrono::high_resolution_clock::now();
+    ERROR_CHECK( colorFrame->CopyConvertedFrameDataToArray( static_cast<UINT>( colorBuffer.size() ), &colorBuffer[0], ColorImageFormat::ColorImageFormat_Bgra ) );
+    auto end = std::chrono::high_resolution_clock::now();
+    convertTime += std::chrono::duration<double, std::milli>( end - start ).count();
+
+    // Decode Region of Face and Preview
+    start = std::chrono::high_resolution_clock::now();
+    if( !decodeColor( colorFrame ) ){
+        throw std::runtime_error( "failed Kinect::decodeColor()" );
+    }
+    end = std::chrono::high_resolution_clock::now();
+    decodeTime += std::chrono::duration<double, std::milli>( end - start ).count();
+    decodedPixels += static_cast<double>( decoder.getPixels() ) / ( colorWidth * colorHeight );
+
+    // Print Average every 100 Frames
+    if( ++frameCount == 100 ){
+        std::cout << "convert : " << convertTime / frameCount << " [ms/frame], "
+                  << "decode : " << decodeTime / frameCount << " [ms/frame] ( " << decodedPixels / frameCount * 100.0 << " [%] of pixels )" << std::endl;
+        convertTime = 0.0;
+        decodeTime = 0.0;
+        decodedPixels = 0.0;
+        frameCount = 0;
+    }
+}
+#endif
+
 // Update Body
 inline void Kinect::updateBody()
 {
@@ -203,7 +375,10 @@ inline void Kinect::updateBody()
 // Find Closest Body
 inline void Kinect::findClosestBody( const std::array<ComPtr<IBody>, BODY_COUNT>& bodies )
 {
-    float closestDistance = std::numeric_limits<float>::max();
+    // Gather Distances of Tracked Bodies
+    std::array<TrackingIdManager::Candidate, BODY_COUNT> candidates;
+    std::array<int, BODY_COUNT> indices;
+    int candidateCount = 0;
     for( int count = 0; count < BODY_COUNT; count++ ){
         const ComPtr<IBody> body = bodies[count];
         BOOLEAN tracked;
@@ -223,24 +398,36 @@ inline void Kinect::findClosestBody( const std::array<ComPtr<IBody>, BODY_COUNT>
         // Calculate Distance from Sensor ( ��( x^2 + y^2 + z^2 ) )
         const CameraSpacePoint point = joint.Position;
         const float distance = std::sqrt( std::pow( point.X, 2 ) + std::pow( point.Y, 2 ) + std::pow( point.Z, 2 ) );
-        if( closestDistance <= distance ){
-            continue;
-        }
-        closestDistance = distance;
 
         // Retrieve Tracking ID
         UINT64 trackingId;
         ERROR_CHECK( body->get_TrackingId( &trackingId ) );
-        if( this->trackingId != trackingId ){
-            // Registration Tracking ID
-            ComPtr<IHighDefinitionFaceFrameSource> hdFaceFrameSource;
-            ERROR_CHECK( hdFaceFrameReader->get_HighDefinitionFaceFrameSource( &hdFaceFrameSource ) );
-            ERROR_CHECK( hdFaceFrameSource->put_TrackingId( trackingId ) );
-
-            // Update Current
-            this->trackingId = trackingId;
-            this->trackingCount = count;
-            this->produced = false;
+        candidates[candidateCount] = { trackingId, distance };
+        indices[candidateCount] = count;
+        candidateCount++;
+    }
+
+    // Registration Tracking ID only when Closest Body is Really Changed
+    for( const TrackingIdManager::Event& event : trackingIdManager.update( &candidates[0], candidateCount ) ){
+        if( event.type == TrackingIdManager::Lost ){
+            continue;
+        }
+
+        ComPtr<IHighDefinitionFaceFrameSource> hdFaceFrameSource;
+        ERROR_CHECK( hdFaceFrameReader->get_HighDefinitionFaceFrameSource( &hdFaceFrameSource ) );
+        ERROR_CHECK( hdFaceFrameSource->put_TrackingId( event.trackingId ) );
+
+        // Restart Face Model Production ( loaded face model is kept for operator )
+        if( !loaded ){
+            produced = false;
+            generation++;
+        }
+    }
+
+    // Update Current
+    for( int index = 0; index < candidateCount; index++ ){
+        if( candidates[index].trackingId == trackingIdManager.getTrackingId( 0 ) ){
+            trackingCount = indices[index];
         }
     }
 }
@@ -258,23 +445,220 @@ inline void Kinect::updateHDFace()
     // Check Traced
     BOOLEAN tracked;
     ERROR_CHECK( hdFaceFrame->get_IsFaceTracked( &tracked ) );
+    TIMESPAN relativeTime;
+    ERROR_CHECK( hdFaceFrame->get_RelativeTime( &relativeTime ) );
+    faceFrame.timestamp = relativeTime;
+    faceFrame.tracked = tracked ? 1 : 0;
     if( !tracked ){
+        // Record Lost Face
+        if( recorder.isOpened() ){
+            faceFrame.hasVertexes = 0;
+            recorder.write( faceFrame );
+        }
         return;
     }
+    ERROR_CHECK( hdFaceFrame->get_TrackingId( &faceFrame.trackingId ) );
 
     // Retrieve Face Alignment Result
     ERROR_CHECK( hdFaceFrame->GetAndRefreshFaceAlignmentResult( faceAlignment.Get() ) );
 
+    // Record Face Frame
+    if( recorder.isOpened() ){
+        retrieveFaceFrame( recordVertexes );
+        recorder.write( faceFrame );
+    }
+
     // Check Face Model Builder Status
     FaceModelBuilderCollectionStatus collection;
     ERROR_CHECK( faceModelBuilder->get_CollectionStatus( &collection ) );
-    if( !collection ){
-        // Retrieve Fitting Face Model
-        ComPtr<IFaceModelData> faceModelData;
-        ERROR_CHECK( faceModelBuilder->GetFaceData( &faceModelData ) );
-        ERROR_CHECK( faceModelData->ProduceFaceModel( &faceModel ) );
-        produced = true;
+    if( !produced && !producing && !collection ){
+        // Start Face Model Production
+        startProduction();
+    }
+}
+
+// Retrieve Face Frame from Face Alignment
+inline void Kinect::retrieveFaceFrame( const bool vertexes )
+{
+    // Retrieve Animation Units ... Motion of Face Parts that Represent Expression (17 AUs)
+    ERROR_CHECK( faceAlignment->GetAnimationUnits( FaceShapeAnimations::FaceShapeAnimations_Count, faceFrame.animationUnits ) );
+
+    // Retrieve Head Pivot Point and Face Orientation
+    CameraSpacePoint pivot;
+    ERROR_CHECK( faceAlignment->get_HeadPivotPoint( &pivot ) );
+    faceFrame.pivot[0] = pivot.X;
+    faceFrame.pivot[1] = pivot.Y;
+    faceFrame.pivot[2] = pivot.Z;
+    Vector4 orientation;
+    ERROR_CHECK( faceAlignment->get_FaceOrientation( &orientation ) );
+    faceFrame.orientation[0] = orientation.x;
+    faceFrame.orientation[1] = orientation.y;
+    faceFrame.orientation[2] = orientation.z;
+    faceFrame.orientation[3] = orientation.w;
+
+    // Retrieve Vertexes ( same layout as CameraSpacePoint )
+    faceFrame.hasVertexes = vertexes ? 1 : 0;
+    if( vertexes ){
+        ERROR_CHECK( faceModel->CalculateVerticesForAlignment( faceAlignment.Get(), vertexCount, reinterpret_cast<CameraSpacePoint*>( faceFrame.vertexes ) ) );
+    }
+}
+
+// Toggle Recording
+void Kinect::toggleRecording( const bool vertexes )
+{
+    // Stop Recording
+    if( recorder.isOpened() ){
+        std::cout << "Stop Recording HDFace ( " << recorder.getFrames() << " frames, " << recorder.getBytes() << " bytes )" << std::endl;
+        recorder.close();
+        return;
+    }
+
+    // Neutral Face is Current Face ( start recording with neutral expression )
+    if( vertexes ){
+        if( !faceFrame.tracked ){
+            std::cout << "Face is not Tracked, Look at Sensor with Neutral Expression to Record Vertexes" << std::endl;
+            return;
+        }
+        if( vertexCount != FaceFrame::VERTEXES ){
+            throw std::runtime_error( "unexpected vertex count of face model" );
+        }
+        retrieveFaceFrame( true );
+    }
+
+    // Start Recording
+    std::cout << "Start Recording HDFace to File" << ( vertexes ? " with Vertexes" : "" ) << std::endl;
+    if( !recorder.open( "HDFace.hdf", vertexes ? &faceFrame : nullptr ) ){
+        throw std::runtime_error( "failed FaceStreamRecorder::open( HDFace.hdf )" );
+    }
+    recordVertexes = vertexes;
+}
+
+// Start Face Model Production
+// Fitting face model takes a long time, so ProduceFaceModel() is called on worker thread and the result is handed off by promise.
+inline void Kinect::startProduction()
+{
+    // Retrieve Face Data
+    collected = std::chrono::high_resolution_clock::now();
+    ComPtr<IFaceModelData> faceModelData;
+    ERROR_CHECK( faceModelBuilder->GetFaceData( &faceModelData ) );
+    retrieveTime = std::chrono::duration<double, std::milli>( std::chrono::high_resolution_clock::now() - collected ).count();
+
+    // Wait Previous Worker ( already finished because its result was received )
+    if( producer.joinable() ){
+        producer.join();
+    }
+
+    // Produce Fitting Face Model on Worker Thread
+    std::promise<Production> promise;
+    production = promise.get_future();
+    producer = std::thread( []( std::promise<Production> promise, ComPtr<IFaceModelData> faceModelData ){
+        try{
+            const auto start = std::chrono::high_resolution_clock::now();
+            Production result;
+            ERROR_CHECK( faceModelData->ProduceFaceModel( &result.faceModel ) );
+            result.produceTime = std::chrono::duration<double, std::milli>( std::chrono::high_resolution_clock::now() - start ).count();
+            promise.set_value( result );
+        }
+        catch( ... ){
+            promise.set_exception( std::current_exception() );
+        }
+    }, std::move( promise ), faceModelData );
+
+    producing = true;
+    productionGeneration = generation;
+}
+
+// Update Face Model Production
+inline void Kinect::updateProduction()
+{
+    // Check Result of Worker without Waiting
+    if( !producing || production.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready ){
+        return;
+    }
+    producing = false;
+
+    // Retrieve Result ( exception of worker is rethrown here )
+    Production result = production.get();
+
+    // Discard Result if Face Model Production was Restarted ( e.g. closest body changed )
+    if( productionGeneration != generation ){
+        return;
+    }
+
+    // Swap Face Model ( face model is used only by this thread, so next drawing uses new face model entirely )
+    const auto start = std::chrono::high_resolution_clock::now();
+    faceModel.Swap( result.faceModel );
+    const auto end = std::chrono::high_resolution_clock::now();
+    const double swapTime = std::chrono::duration<double, std::milli>( end - start ).count();
+    const double totalTime = std::chrono::duration<double, std::milli>( end - collected ).count();
+    produced = true;
+
+    std::cout << "Face Model Produced "
+              << "GetFaceData : " << retrieveTime << " [ms], "
+              << "ProduceFaceModel : " << result.produceTime << " [ms], "
+              << "Swap : " << swapTime << " [ms], "
+              << "Total : " << totalTime << " [ms]" << std::endl;
+
+    // Save Face Model of Operator
+    saveFaceModel();
+}
+
+// Load Face Model of Operator
+inline bool Kinect::loadFaceModel()
+{
+    if( operatorId.empty() ){
+        return false;
+    }
+
+    // Load Shape Units and Scale
+    FaceModelStore::Model model;
+    if( !faceModelStore.load( operatorId, model ) ){
+        std::cout << "Face Model of " << operatorId << " is not Saved, Start Face Data Collection" << std::endl;
+        return false;
+    }
+
+    // Create Face Model Directly ( hair and skin color are not used by CreateFaceModel )
+    ComPtr<IFaceModel> storedFaceModel;
+    ERROR_CHECK( CreateFaceModel( model.scale, FaceShapeDeformations::FaceShapeDeformations_Count, model.shapeUnits, &storedFaceModel ) );
+    faceModel = storedFaceModel;
+    std::cout << "Load Face Model of " << operatorId << std::endl;
+
+    return true;
+}
+
+// Save Face Model of Operator
+inline void Kinect::saveFaceModel()
+{
+    if( operatorId.empty() ){
+        return;
+    }
+
+    // Retrieve Shape Units and Scale
+    FaceModelStore::Model model;
+    ERROR_CHECK( faceModel->GetFaceShapeDeformations( FaceShapeDeformations::FaceShapeDeformations_Count, model.shapeUnits ) );
+    ERROR_CHECK( faceModel->get_Scale( &model.scale ) );
+
+    // Retrieve Hair and Skin Color ( 0 if not collected )
+    UINT32 color;
+    model.hairColor = SUCCEEDED( faceModel->get_HairColor( &color ) ) ? color : 0;
+    model.skinColor = SUCCEEDED( faceModel->get_SkinColor( &color ) ) ? color : 0;
+
+    // Save to Face Model Store
+    CreateDirectoryA( faceModelStore.getDirectory().c_str(), nullptr );
+    if( !faceModelStore.save( operatorId, model ) ){
+        throw std::runtime_error( "failed FaceModelStore::save( " + operatorId + " )" );
     }
+    std::cout << "Save Face Model of " << operatorId << std::endl;
+}
+
+// Restart Face Data Collection
+// Loaded face model is kept until new face model is produced ( e.g. operator changed appearance ).
+void Kinect::restartCollection()
+{
+    loaded = false;
+    produced = false;
+    generation++;
+    ERROR_CHECK( faceModelBuilder->BeginFaceDataCollection() );
 }
 
 // Draw Data
@@ -301,13 +685,19 @@ inline void Kinect::drawHDFace()
         return;
     }
 
-    // Draw Face Model Builder Status
-    drawFaceModelBuilderStatus( colorMat, cv::Point( 50, 50 ), 1.0, colors[trackingCount] );
-
-    // Retrieve Vertexes
-    std::vector<CameraSpacePoint> vertexes( vertexCount );
-    ERROR_CHECK( faceModel->CalculateVerticesForAlignment( faceAlignment.Get(), vertexCount, &vertexes[0] ) );
-    drawVertexes( colorMat, vertexes, 2, colors[trackingCount] );
+#ifdef BENCHMARK
+    // Benchmark Vertexes and Mesh
+    benchmarkVertexes();
+    benchmarkMesh();
+#else
+    // Retrieve Vertexes and Project to Color Space
+    projectVertexes();
+#endif
+
+    // Draw Vertexes ( mesh is drawn into preview )
+    if( drawMode == DrawMode::Vertexes ){
+        drawVertexes( colorMat, projection.getColorPoints(), projection.getCount(), colors[trackingCount] );
+    }
 
     /*
     // Retrieve Head Pivot Point
@@ -370,6 +760,18 @@ inline void Kinect::drawFaceModelBuilderStatus( cv::Mat& image, const cv::Point&
         return;
     }
 
+    // Check Loaded
+    if( loaded ){
+        cv::putText( image, "Face Model Loaded : " + operatorId, cv::Point( point.x, point.y ), cv::FONT_HERSHEY_SIMPLEX, scale, color, thickness, cv::LINE_AA );
+        return;
+    }
+
+    // Check Producing
+    if( producing ){
+        cv::putText( image, "Producing Face Model", cv::Point( point.x, point.y ), cv::FONT_HERSHEY_SIMPLEX, scale, color, thickness, cv::LINE_AA );
+        return;
+    }
+
     // Check Produced
     if( produced ){
         cv::putText( image, "Collection Complete", cv::Point( point.x, point.y ), cv::FONT_HERSHEY_SIMPLEX, scale, color, thickness, cv::LINE_AA );
@@ -431,23 +833,222 @@ inline std::string Kinect::status2string( const FaceModelBuilderCaptureStatus ca
     return status;
 }
 
+// Project Vertexes
+inline void Kinect::projectVertexes()
+{
+    // Retrieve Vertexes into Vertex Buffer
+    ERROR_CHECK( faceModel->CalculateVerticesForAlignment( faceAlignment.Get(), vertexCount, reinterpret_cast<CameraSpacePoint*>( projection.getCameraPoints() ) ) );
+
+    // Project Vertexes with Color Camera Model ( only if toggled, live projection uses coordinate mapper )
+    if( useCalibration ){
+        projection.project( calibration );
+        return;
+    }
+
+    // Project Vertexes with Coordinate Mapper ( one call for all vertexes )
+    ERROR_CHECK( coordinateMapper->MapCameraPointsToColorSpace( vertexCount, reinterpret_cast<CameraSpacePoint*>( projection.getCameraPoints() ), vertexCount, reinterpret_cast<ColorSpacePoint*>( projection.getColorPoints() ) ) );
+}
+
+// Save Calibration of Color Camera
+// The calibration is fitted to coordinate mapper, and used to project vertexes without coordinate mapper ( e.g. on Linux ).
+void Kinect::saveCalibration()
+{
+    // Sample Points in Field of View
+    std::vector<CameraSpacePoint> cameraSpacePoints;
+    for( float z = 0.5f; z <= 4.5f; z += 0.25f ){
+        for( float y = -0.5f; y <= 0.5f; y += 0.1f ){
+            for( float x = -0.8f; x <= 0.8f; x += 0.1f ){
+                cameraSpacePoints.push_back( { x * z, y * z, z } );
+            }
+        }
+    }
+
+    // Retrieve Mapped Coordinates
+    std::vector<ColorSpacePoint> colorSpacePoints( cameraSpacePoints.size() );
+    ERROR_CHECK( coordinateMapper->MapCameraPointsToColorSpace( static_cast<UINT>( cameraSpacePoints.size() ), &cameraSpacePoints[0], static_cast<UINT>( colorSpacePoints.size() ), &colorSpacePoints[0] ) );
+
+    // Fit and Save Color Camera Model
+    if( !calibration.fit( reinterpret_cast<const VertexProjection::CameraPoint*>( &cameraSpacePoints[0] ), reinterpret_cast<const VertexProjection::ColorPoint*>( &colorSpacePoints[0] ), static_cast<int>( cameraSpacePoints.size() ) ) ){
+        throw std::runtime_error( "failed VertexProjection::Calibration::fit()" );
+    }
+    if( !calibration.save( "ColorCalibration.txt" ) ){
+        throw std::runtime_error( "failed VertexProjection::Calibration::save()" );
+    }
+    calibrated = true;
+}
+
 // Draw Vertexes
-inline void Kinect::drawVertexes( cv::Mat& image, const std::vector<CameraSpacePoint> vertexes, const int radius, const cv::Vec3b& color, const int thickness )
+// Vertexes are stamped as small disks directly into color buffer instead of drawing anti-aliased circle for each vertex.
+inline void Kinect::drawVertexes( cv::Mat& image, const VertexProjection::ColorPoint* points, const int count, const cv::Vec3b& color )
 {
     if( image.empty() ){
         return;
     }
 
-    // Draw Vertex Points Converted to Color Coordinate System
-    for( const CameraSpacePoint vertex : vertexes ){
-        ColorSpacePoint point;
-        ERROR_CHECK( coordinateMapper->MapCameraPointToColorSpace( vertex, &point ) );
-        int x = static_cast<int>( point.X + 0.5f );
-        int y = static_cast<int>( point.Y + 0.5f );
+    // Draw Vertex Points inside Image ( invalid points are mapped to -Infinity )
+    const cv::Vec4b pixel( color[0], color[1], color[2], 255 );
+    const int radius = 2;
+    for( int index = 0; index < count; index++ ){
+        if( !( radius <= points[index].X && points[index].X < image.cols - radius - 1 ) || !( radius <= points[index].Y && points[index].Y < image.rows - radius - 1 ) ){
+            continue;
+        }
+
+        const int x = static_cast<int>( points[index].X + 0.5f );
+        const int y = static_cast<int>( points[index].Y + 0.5f );
+        for( const cv::Point& offset : disk ){
+            image.at<cv::Vec4b>( y + offset.y, x + offset.x ) = pixel;
+        }
+    }
+}
+
+#ifdef BENCHMARK
+// Benchmark Vertexes
+inline void Kinect::benchmarkVertexes()
+{
+    static double calculateTime = 0.0;
+    static double singleTime = 0.0;
+    static double batchTime = 0.0;
+    static double modelTime = 0.0;
+    static double drawTime = 0.0;
+    static float modelError = 0.0f;
+    static int faceCount = 0;
+
+    // Retrieve Vertexes into Vertex Buffer
+    auto start = std::chrono::high_resolution_clock::now();
+    ERROR_CHECK( faceModel->CalculateVerticesForAlignment( faceAlignment.Get(), vertexCount, reinterpret_cast<CameraSpacePoint*>( projection.getCameraPoints() ) ) );
+    auto end = std::chrono::high_resolution_clock::now();
+    calculateTime += std::chrono::duration<double, std::milli>( end - start ).count();
+
+    // Project Vertexes one by one with Coordinate Mapper
+    const CameraSpacePoint* vertexes = reinterpret_cast<const CameraSpacePoint*>( projection.getCameraPoints() );
+    ColorSpacePoint* points = reinterpret_cast<ColorSpacePoint*>( projection.getColorPoints() );
+    start = std::chrono::high_resolution_clock::now();
+    for( UINT32 index = 0; index < vertexCount; index++ ){
+        ERROR_CHECK( coordinateMapper->MapCameraPointToColorSpace( vertexes[index], &points[index] ) );
+    }
+    end = std::chrono::high_resolution_clock::now();
+    singleTime += std::chrono::duration<double, std::milli>( end - start ).count();
+
+    // Project Vertexes with Color Camera Model
+    std::vector<ColorSpacePoint> mapped( points, points + vertexCount );
+    if( calibrated ){
+        start = std::chrono::high_resolution_clock::now();
+        projection.project( calibration );
+        end = std::chrono::high_resolution_clock::now();
+        modelTime += std::chrono::duration<double, std::milli>( end - start ).count();
+
+        // Maximum Error from Coordinate Mapper
+        for( UINT32 index = 0; index < vertexCount; index++ ){
+            modelError = std::max( modelError, std::max( std::abs( points[index].X - mapped[index].X ), std::abs( points[index].Y - mapped[index].Y ) ) );
+        }
+    }
+
+    // Project Vertexes with Coordinate Mapper in One Call
+    start = std::chrono::high_resolution_clock::now();
+    ERROR_CHECK( coordinateMapper->MapCameraPointsToColorSpace( vertexCount, vertexes, vertexCount, points ) );
+    end = std::chrono::high_resolution_clock::now();
+    batchTime += std::chrono::duration<double, std::milli>( end - start ).count();
+
+    // Draw Vertexes into Copy of Color Image
+    cv::Mat image = colorMat.clone();
+    start = std::chrono::high_resolution_clock::now();
+    drawVertexes( image, projection.getColorPoints(), projection.getCount(), colors[trackingCount] );
+    end = std::chrono::high_resolution_clock::now();
+    drawTime += std::chrono::duration<double, std::milli>( end - start ).count();
+
+    // Print Average every 100 Faces
+    if( ++faceCount == 100 ){
+        std::cout << vertexCount << " vertexes "
+                  << "calculate : " << calculateTime / faceCount << " [ms/face], "
+                  << "project ( per vertex ) : " << singleTime / faceCount << " [ms/face], "
+                  << "project ( batch ) : " << batchTime / faceCount << " [ms/face], ";
+        if( calibrated ){
+            std::cout << "project ( model ) : " << modelTime / faceCount << " [ms/face] ( max error " << modelError << " [px] ), ";
+        }
+        std::cout << "draw : " << drawTime / faceCount << " [ms/face]" << std::endl;
+        calculateTime = 0.0;
+        singleTime = 0.0;
+        batchTime = 0.0;
+        modelTime = 0.0;
+        drawTime = 0.0;
+        modelError = 0.0f;
+        faceCount = 0;
+    }
+}
+
+// Benchmark Mesh
+inline void Kinect::benchmarkMesh()
+{
+    static double circleTime = 0.0;
+    static double shadedTime = 0.0;
+    static double wireframeTime = 0.0;
+    static double previewTime = 0.0;
+    static int faceCount = 0;
+
+    // Draw Anti-Aliased Circle for Each Vertex ( previous drawing )
+    cv::Mat image = colorMat.clone();
+    const VertexProjection::ColorPoint* points = projection.getColorPoints();
+    auto start = std::chrono::high_resolution_clock::now();
+    for( int index = 0; index < projection.getCount(); index++ ){
+        const int x = static_cast<int>( points[index].X + 0.5f );
+        const int y = static_cast<int>( points[index].Y + 0.5f );
         if( ( 0 <= x ) && ( x < image.cols ) && ( 0 <= y ) && ( y < image.rows ) ){
-            cv::circle( image, cv::Point( x, y ), radius, color, thickness, cv::LINE_AA );
+            cv::circle( image, cv::Point( x, y ), 2, colors[trackingCount], -1, cv::LINE_AA );
         }
     }
+    auto end = std::chrono::high_resolution_clock::now();
+    circleTime += std::chrono::duration<double, std::milli>( end - start ).count();
+
+    // Draw Shaded Mesh and Wireframe Mesh into Color Image
+    const DrawMode mode = drawMode;
+    drawMode = DrawMode::Shaded;
+    start = std::chrono::high_resolution_clock::now();
+    drawMesh( image, 1.0, colors[trackingCount] );
+    end = std::chrono::high_resolution_clock::now();
+    shadedTime += std::chrono::duration<double, std::milli>( end - start ).count();
+
+    drawMode = DrawMode::Wireframe;
+    start = std::chrono::high_resolution_clock::now();
+    drawMesh( image, 1.0, colors[trackingCount] );
+    end = std::chrono::high_resolution_clock::now();
+    wireframeTime += std::chrono::duration<double, std::milli>( end - start ).count();
+
+    // Draw Shaded Mesh into Half Resolution Preview
+    drawMode = DrawMode::Shaded;
+    cv::Mat preview;
+    cv::resize( colorMat, preview, cv::Size(), 0.5, 0.5 );
+    start = std::chrono::high_resolution_clock::now();
+    drawMesh( preview, 0.5, colors[trackingCount] );
+    end = std::chrono::high_resolution_clock::now();
+    previewTime += std::chrono::duration<double, std::milli>( end - start ).count();
+    drawMode = mode;
+
+    // Print Average every 100 Faces
+    if( ++faceCount == 100 ){
+        std::cout << rasterizer.getTriangles() << " triangles "
+                  << "circles : " << circleTime / faceCount << " [ms/face], "
+                  << "shaded : " << shadedTime / faceCount << " [ms/face], "
+                  << "wireframe : " << wireframeTime / faceCount << " [ms/face], "
+                  << "shaded ( preview ) : " << previewTime / faceCount << " [ms/face]" << std::endl;
+        circleTime = 0.0;
+        shadedTime = 0.0;
+        wireframeTime = 0.0;
+        previewTime = 0.0;
+        faceCount = 0;
+    }
+}
+#endif
+
+// Draw Mesh
+inline void Kinect::drawMesh( cv::Mat& image, const double scale, const cv::Vec3b& color )
+{
+    if( image.empty() || drawMode == DrawMode::Vertexes ){
+        return;
+    }
+
+    // Rasterize Triangles with Z-Buffer into Image
+    const MeshRasterizer::Mode mode = ( drawMode == DrawMode::Shaded ) ? MeshRasterizer::Shaded : MeshRasterizer::Wireframe;
+    rasterizer.draw( image.data, image.cols, image.rows, static_cast<int>( image.step ), image.channels(), projection, static_cast<float>( scale ), mode, &color[0] );
 }
 
 // Show Data
@@ -464,11 +1065,43 @@ inline void Kinect::showHDFace()
         return;
     }
 
-    // Resize Image
+    // Resize Image ( or compose from preview and decoded region )
     cv::Mat resizeMat;
     const double scale = 0.5;
-    cv::resize( colorMat, resizeMat, cv::Size(), scale, scale );
+    if( decodeRegions ){
+        composeColor( resizeMat, scale );
+    }
+    else{
+        cv::resize( colorMat, resizeMat, cv::Size(), scale, scale );
+    }
+
+    // Draw Face Model Builder Status ( outside of decoded region )
+    drawFaceModelBuilderStatus( resizeMat, cv::Point( 25, 25 ), scale, colors[trackingCount], 1 );
+
+    // Draw Mesh
+    drawMesh( resizeMat, scale, colors[trackingCount] );
 
     // Show Image
     cv::imshow( "HDFace", resizeMat );
+}
+
+// Compose Color from Preview and Decoded Regions
+// Preview is enlarged to whole image, and decoded regions ( with vertexes drawn ) are reduced over it, so that face keeps detail of full resolution.
+inline void Kinect::composeColor( cv::Mat& image, const double scale )
+{
+    // Enlarge Preview
+    const cv::Mat previewMat( decoder.getPreviewHeight(), decoder.getPreviewWidth(), CV_8UC4, const_cast<uint8_t*>( decoder.getPreview() ) );
+    cv::resize( previewMat, image, cv::Size( static_cast<int>( colorWidth * scale ), static_cast<int>( colorHeight * scale ) ) );
+
+    // Reduce Decoded Regions into Image
+    for( const ColorRegionDecoder::Region& region : decoder.getRegions() ){
+        const cv::Rect source( region.left, region.top, region.right - region.left, region.bottom - region.top );
+        const cv::Rect target = cv::Rect( cv::Point( cvRound( region.left * scale ), cvRound( region.top * scale ) ), cv::Point( cvRound( region.right * scale ), cvRound( region.bottom * scale ) ) ) & cv::Rect( 0, 0, image.cols, image.rows );
+        if( target.area() == 0 ){
+            continue;
+        }
+
+        cv::Mat targetMat = image( target );
+        cv::resize( colorMat( source ), targetMat, target.size(), 0.0, 0.0, cv::INTER_AREA );
+    }
 }
\ No newline at end of file
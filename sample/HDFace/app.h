@@ -5,9 +5,19 @@
 #include <Kinect.h>
 #include <Kinect.Face.h>
 #include <opencv2/opencv.hpp>
+#include "TrackingIdManager.h"
+#include "VertexProjection.h"
+#include "MeshRasterizer.h"
+#include "FaceModelStore.h"
+#include "FaceStream.h"
+#include "ColorRegionDecoder.h"
 
 #include <vector>
 #include <array>
+#include <string>
+#include <thread>
+#include <future>
+#include <chrono>
 
 #include <wrl/client.h>
 using namespace Microsoft::WRL;
@@ -35,21 +45,66 @@ private:
     unsigned int colorBytesPerPixel;
     cv::Mat colorMat;
 
+    // Color Region Decoder ( face is decoded at full resolution, and whole frame at 1/4 resolution as preview )
+    ColorRegionDecoder decoder;
+    bool decodeRegions = true;
+
     // HDFace Buffer
     ComPtr<IFaceModelBuilder> faceModelBuilder;
     ComPtr<IFaceAlignment> faceAlignment;
     ComPtr<IFaceModel> faceModel;
     std::array<float, FaceShapeDeformations::FaceShapeDeformations_Count> faceShapeUnits = { 0.0f };
     UINT32 vertexCount;
-    UINT64 trackingId;
+    TrackingIdManager trackingIdManager = TrackingIdManager( 1 ); // Closest body is switched only if another body is closer by 0.1 [m] for 0.5 [s]
     int trackingCount = 0;
     bool produced = false;
 
+    // Face Model Store ( face model of operator is loaded at startup, and saved when produced )
+    FaceModelStore faceModelStore;
+    std::string operatorId;
+    bool loaded = false;
+
+    // Face Model Production ( produced on worker thread, previous face model is drawn until new one is swapped in )
+    struct Production
+    {
+        ComPtr<IFaceModel> faceModel;
+        double produceTime; // ProduceFaceModel() [ms]
+    };
+    std::thread producer;
+    std::future<Production> production;
+    bool producing = false;
+    int generation = 0;           // Incremented when face model production is restarted
+    int productionGeneration = 0; // Generation of production in progress
+    std::chrono::high_resolution_clock::time_point collected;
+    double retrieveTime = 0.0;    // GetFaceData() [ms]
+
+    // Vertex Buffer ( allocated once, projected to color space in one batch )
+    VertexProjection projection;
+    VertexProjection::Calibration calibration;
+    bool calibrated = false;      // Calibration is loaded or saved
+    bool useCalibration = false;  // Project vertexes with calibration instead of coordinate mapper ( toggled by 'p' )
+    std::vector<cv::Point> disk;
+
+    // Mesh Rasterizer ( face mesh is drawn into half resolution preview instead of vertexes )
+    MeshRasterizer rasterizer;
+    enum DrawMode
+    {
+        Vertexes,
+        Shaded,
+        Wireframe
+    };
+    DrawMode drawMode = DrawMode::Vertexes;
+
+    // Face Stream ( record animation units, head pose and optionally vertexes of HDFace )
+    FaceStreamRecorder recorder;
+    FaceFrame faceFrame;
+    bool recordVertexes = false;
+
     std::array<cv::Vec3b, BODY_COUNT> colors;
 
 public:
-    // Constructor
-    Kinect();
+    // Constructor ( face model is stored by operator ID if specified )
+    Kinect( const std::string& operatorId = "" );
 
     // Destructor
     ~Kinect();
@@ -82,6 +137,12 @@ private:
     // Update Color
     inline void updateColor();
 
+    // Decode Color ( return false if raw format is not YUY2 )
+    inline bool decodeColor( const ComPtr<IColorFrame>& colorFrame );
+
+    // Benchmark Color
+    inline void benchmarkColor( const ComPtr<IColorFrame>& colorFrame );
+
     // Update Body
     inline void updateBody();
 
@@ -91,6 +152,27 @@ private:
     // Update HDFace
     inline void updateHDFace();
 
+    // Retrieve Face Frame from Face Alignment
+    inline void retrieveFaceFrame( const bool vertexes );
+
+    // Toggle Recording ( vertexes are recorded as difference from current face )
+    void toggleRecording( const bool vertexes );
+
+    // Start Face Model Production
+    inline void startProduction();
+
+    // Update Face Model Production
+    inline void updateProduction();
+
+    // Load Face Model of Operator
+    inline bool loadFaceModel();
+
+    // Save Face Model of Operator
+    inline void saveFaceModel();
+
+    // Restart Face Data Collection
+    void restartCollection();
+
     // Draw Data
     void draw();
 
@@ -109,14 +191,32 @@ private:
     // Convert Capture Status to String
     inline std::string status2string( const FaceModelBuilderCaptureStatus capture );
 
+    // Project Vertexes
+    inline void projectVertexes();
+
+    // Save Calibration of Color Camera
+    void saveCalibration();
+
     // Draw Vertexes
-    inline void Kinect::drawVertexes( cv::Mat& image, const std::vector<CameraSpacePoint> vertexes, const int radius, const cv::Vec3b& color, const int thickness = -1 );
+    inline void drawVertexes( cv::Mat& image, const VertexProjection::ColorPoint* points, const int count, const cv::Vec3b& color );
+
+    // Benchmark Vertexes
+    inline void benchmarkVertexes();
+
+    // Draw Mesh
+    inline void drawMesh( cv::Mat& image, const double scale, const cv::Vec3b& color );
+
+    // Benchmark Mesh
+    inline void benchmarkMesh();
 
     // Show Data
     void show();
 
     // Show HDFace
     inline void showHDFace();
+
+    // Compose Color from Preview and Decoded Regions
+    inline void composeColor( cv::Mat& image, const double scale );
 };
 
 #endif // __APP__
\ No newline at end of file
@@ -1,12 +1,27 @@
 #include <iostream>
 #include <sstream>
+#include <string>
 
 #include "app.h"
+#include "FaceStreamBenchmark.h"
 
 int main( int argc, char* argv[] )
 {
     try{
-        Kinect kinect;
+        // Benchmark Recorded Face Stream ( size, decoding and seeking, summary of animation units )
+        if( argc > 2 && std::string( argv[1] ) == "benchmark" ){
+            FaceStreamBenchmark benchmark;
+            if( !benchmark.run( argv[2] ) ){
+                throw std::runtime_error( "failed FaceStreamBenchmark::run( " + std::string( argv[2] ) + " )" );
+            }
+            benchmark.print( std::cout );
+            return 0;
+        }
+
+        // Choose Operator ( face model is saved and loaded by operator ID, collected every time if not specified )
+        const std::string operatorId = ( argc > 1 ) ? argv[1] : "";
+
+        Kinect kinect( operatorId );
         kinect.run();
     } catch( std::exception& ex ){
         std::cout << ex.what() << std::endl;
@@ -0,0 +1,418 @@
+#include "JointFilterBank.h"
+#include "JointVector.h"
+
+#include <cmath>
+#include <algorithm>
+#include <initializer_list>
+
+// Holt Filter
+// Every case of the original filter is computed for all lanes, and the result is selected by masks.
+template<typename Vector>
+void HoltFilter::update( const Parameters& parameters, const float /*time*/, const JointLanes& lanes, const int begin, const int end )
+{
+    typedef typename Vector::Type Type;
+    typedef typename Vector::Mask Mask;
+
+    float* frameCount = lanes.states[0];
+    float* rawX = lanes.states[1];
+    float* rawY = lanes.states[2];
+    float* rawZ = lanes.states[3];
+    float* filteredX = lanes.states[4];
+    float* filteredY = lanes.states[5];
+    float* filteredZ = lanes.states[6];
+    float* trendX = lanes.states[7];
+    float* trendY = lanes.states[8];
+    float* trendZ = lanes.states[9];
+
+    const Type zero = Vector::set( 0.0f );
+    const Type half = Vector::set( 0.5f );
+    const Type one = Vector::set( 1.0f );
+    const Type two = Vector::set( 2.0f );
+    const Type smoothing = Vector::set( parameters.smoothing );
+    const Type correction = Vector::set( parameters.correction );
+    const Type prediction = Vector::set( parameters.prediction );
+    const Type jitterRadius = Vector::set( std::max( 0.0001f, parameters.jitterRadius ) ); // Check for divide by zero. Use an epsilon of a 10th of a millimeter
+    const Type maxDeviationRadius = Vector::set( parameters.maxDeviationRadius );
+
+    for( int lane = begin; lane < end; lane += Vector::WIDTH ){
+        const Type x = Vector::load( &lanes.inputX[lane] );
+        const Type y = Vector::load( &lanes.inputY[lane] );
+        const Type z = Vector::load( &lanes.inputZ[lane] );
+        const Type scale = Vector::load( &lanes.radiusScale[lane] );
+        const Type previousRawX = Vector::load( &rawX[lane] );
+        const Type previousRawY = Vector::load( &rawY[lane] );
+        const Type previousRawZ = Vector::load( &rawZ[lane] );
+        const Type previousFilteredX = Vector::load( &filteredX[lane] );
+        const Type previousFilteredY = Vector::load( &filteredY[lane] );
+        const Type previousFilteredZ = Vector::load( &filteredZ[lane] );
+        const Type previousTrendX = Vector::load( &trendX[lane] );
+        const Type previousTrendY = Vector::load( &trendY[lane] );
+        const Type previousTrendZ = Vector::load( &trendZ[lane] );
+
+        // If joint is invalid ( 0, 0, 0 ), reset the filter
+        const Mask valid = Vector::bitOr( Vector::bitOr( Vector::notEqual( x, zero ), Vector::notEqual( y, zero ) ), Vector::notEqual( z, zero ) );
+        const Type count = Vector::select( valid, Vector::load( &frameCount[lane] ), zero );
+        const Mask first = Vector::lessEqual( count, zero );
+        const Mask second = Vector::lessEqual( count, one );
+
+        // Second frame ( average of raw positions )
+        const Type secondX = Vector::mul( Vector::add( x, previousRawX ), half );
+        const Type secondY = Vector::mul( Vector::add( y, previousRawY ), half );
+        const Type secondZ = Vector::mul( Vector::add( z, previousRawZ ), half );
+
+        // Following frames ( first apply jitter filter )
+        const Type differenceX = Vector::sub( x, previousFilteredX );
+        const Type differenceY = Vector::sub( y, previousFilteredY );
+        const Type differenceZ = Vector::sub( z, previousFilteredZ );
+        const Type length = Vector::sqrt( Vector::add( Vector::add( Vector::mul( differenceX, differenceX ), Vector::mul( differenceY, differenceY ) ), Vector::mul( differenceZ, differenceZ ) ) );
+        const Type radius = Vector::mul( jitterRadius, scale );
+        const Mask jitter = Vector::lessEqual( length, radius );
+        const Type ratio = Vector::div( length, radius );
+        const Type inverseRatio = Vector::sub( one, ratio );
+        const Type jitterX = Vector::select( jitter, Vector::add( Vector::mul( x, ratio ), Vector::mul( previousFilteredX, inverseRatio ) ), x );
+        const Type jitterY = Vector::select( jitter, Vector::add( Vector::mul( y, ratio ), Vector::mul( previousFilteredY, inverseRatio ) ), y );
+        const Type jitterZ = Vector::select( jitter, Vector::add( Vector::mul( z, ratio ), Vector::mul( previousFilteredZ, inverseRatio ) ), z );
+
+        // Now the double exponential smoothing filter
+        const Type inverseSmoothing = Vector::sub( one, smoothing );
+        const Type followingX = Vector::add( Vector::mul( jitterX, inverseSmoothing ), Vector::mul( Vector::add( previousFilteredX, previousTrendX ), smoothing ) );
+        const Type followingY = Vector::add( Vector::mul( jitterY, inverseSmoothing ), Vector::mul( Vector::add( previousFilteredY, previousTrendY ), smoothing ) );
+        const Type followingZ = Vector::add( Vector::mul( jitterZ, inverseSmoothing ), Vector::mul( Vector::add( previousFilteredZ, previousTrendZ ), smoothing ) );
+
+        // Select Filtered Position by Frame Count ( initial start value is raw position )
+        const Type filtX = Vector::select( first, x, Vector::select( second, secondX, followingX ) );
+        const Type filtY = Vector::select( first, y, Vector::select( second, secondY, followingY ) );
+        const Type filtZ = Vector::select( first, z, Vector::select( second, secondZ, followingZ ) );
+
+        // Trend ( zero at initial start )
+        const Type inverseCorrection = Vector::sub( one, correction );
+        const Type trX = Vector::select( first, zero, Vector::add( Vector::mul( Vector::sub( filtX, previousFilteredX ), correction ), Vector::mul( previousTrendX, inverseCorrection ) ) );
+        const Type trY = Vector::select( first, zero, Vector::add( Vector::mul( Vector::sub( filtY, previousFilteredY ), correction ), Vector::mul( previousTrendY, inverseCorrection ) ) );
+        const Type trZ = Vector::select( first, zero, Vector::add( Vector::mul( Vector::sub( filtZ, previousFilteredZ ), correction ), Vector::mul( previousTrendZ, inverseCorrection ) ) );
+
+        // Predict into the future to reduce latency
+        const Type predictedX = Vector::add( filtX, Vector::mul( trX, prediction ) );
+        const Type predictedY = Vector::add( filtY, Vector::mul( trY, prediction ) );
+        const Type predictedZ = Vector::add( filtZ, Vector::mul( trZ, prediction ) );
+
+        // Check that we are not too far away from raw data
+        const Type deviationX = Vector::sub( predictedX, x );
+        const Type deviationY = Vector::sub( predictedY, y );
+        const Type deviationZ = Vector::sub( predictedZ, z );
+        const Type deviation = Vector::sqrt( Vector::add( Vector::add( Vector::mul( deviationX, deviationX ), Vector::mul( deviationY, deviationY ) ), Vector::mul( deviationZ, deviationZ ) ) );
+        const Type maxDeviation = Vector::mul( maxDeviationRadius, scale );
+        const Mask far = Vector::greater( deviation, maxDeviation );
+        const Type deviationRatio = Vector::div( maxDeviation, deviation );
+        const Type inverseDeviationRatio = Vector::sub( one, deviationRatio );
+        Vector::store( &lanes.outputX[lane], Vector::select( far, Vector::add( Vector::mul( predictedX, deviationRatio ), Vector::mul( x, inverseDeviationRatio ) ), predictedX ) );
+        Vector::store( &lanes.outputY[lane], Vector::select( far, Vector::add( Vector::mul( predictedY, deviationRatio ), Vector::mul( y, inverseDeviationRatio ) ), predictedY ) );
+        Vector::store( &lanes.outputZ[lane], Vector::select( far, Vector::add( Vector::mul( predictedZ, deviationRatio ), Vector::mul( z, inverseDeviationRatio ) ), predictedZ ) );
+
+        // Save the data from this frame
+        Vector::store( &rawX[lane], x );
+        Vector::store( &rawY[lane], y );
+        Vector::store( &rawZ[lane], z );
+        Vector::store( &filteredX[lane], filtX );
+        Vector::store( &filteredY[lane], filtY );
+        Vector::store( &filteredZ[lane], filtZ );
+        Vector::store( &trendX[lane], trX );
+        Vector::store( &trendY[lane], trY );
+        Vector::store( &trendZ[lane], trZ );
+        Vector::store( &frameCount[lane], Vector::min( Vector::add( count, one ), two ) );
+    }
+}
+
+// One Euro Filter
+// Smoothing factor of each lane is computed from cutoff frequency ( alpha = r / ( 1 + r ), r = 2 * pi * cutoff * time ).
+template<typename Vector>
+void OneEuroFilter::update( const Parameters& parameters, const float time, const JointLanes& lanes, const int begin, const int end )
+{
+    typedef typename Vector::Type Type;
+    typedef typename Vector::Mask Mask;
+
+    float* frameCount = lanes.states[0];
+    float* filteredX = lanes.states[1];
+    float* filteredY = lanes.states[2];
+    float* filteredZ = lanes.states[3];
+    float* velocityX = lanes.states[4];
+    float* velocityY = lanes.states[5];
+    float* velocityZ = lanes.states[6];
+
+    const float pi = 3.14159265f;
+    const float period = std::max( 0.001f, time );
+    const float rate = 2.0f * pi * period;
+    const float derivativeRate = rate * parameters.derivativeCutoff;
+
+    const Type zero = Vector::set( 0.0f );
+    const Type one = Vector::set( 1.0f );
+    const Type inverseTime = Vector::set( 1.0f / period );
+    const Type derivativeAlpha = Vector::set( derivativeRate / ( 1.0f + derivativeRate ) );
+    const Type minRate = Vector::set( rate * parameters.minCutoff );
+    const Type betaRate = Vector::set( rate * parameters.beta );
+
+    for( int lane = begin; lane < end; lane += Vector::WIDTH ){
+        const Type x = Vector::load( &lanes.inputX[lane] );
+        const Type y = Vector::load( &lanes.inputY[lane] );
+        const Type z = Vector::load( &lanes.inputZ[lane] );
+        const Type scale = Vector::load( &lanes.radiusScale[lane] );
+        const Type previousX = Vector::load( &filteredX[lane] );
+        const Type previousY = Vector::load( &filteredY[lane] );
+        const Type previousZ = Vector::load( &filteredZ[lane] );
+        const Type previousVelocityX = Vector::load( &velocityX[lane] );
+        const Type previousVelocityY = Vector::load( &velocityY[lane] );
+        const Type previousVelocityZ = Vector::load( &velocityZ[lane] );
+
+        // If joint is invalid ( 0, 0, 0 ), reset the filter
+        const Mask valid = Vector::bitOr( Vector::bitOr( Vector::notEqual( x, zero ), Vector::notEqual( y, zero ) ), Vector::notEqual( z, zero ) );
+        const Type count = Vector::select( valid, Vector::load( &frameCount[lane] ), zero );
+        const Mask first = Vector::lessEqual( count, zero );
+
+        // Low-pass filter of velocity ( zero at initial start )
+        const Type vX = Vector::select( first, zero, Vector::add( previousVelocityX, Vector::mul( derivativeAlpha, Vector::sub( Vector::mul( Vector::sub( x, previousX ), inverseTime ), previousVelocityX ) ) ) );
+        const Type vY = Vector::select( first, zero, Vector::add( previousVelocityY, Vector::mul( derivativeAlpha, Vector::sub( Vector::mul( Vector::sub( y, previousY ), inverseTime ), previousVelocityY ) ) ) );
+        const Type vZ = Vector::select( first, zero, Vector::add( previousVelocityZ, Vector::mul( derivativeAlpha, Vector::sub( Vector::mul( Vector::sub( z, previousZ ), inverseTime ), previousVelocityZ ) ) ) );
+
+        // Cutoff frequency rises with speed ( inferred joints are smoothed a bit more by lower cutoff )
+        const Type speed = Vector::sqrt( Vector::add( Vector::add( Vector::mul( vX, vX ), Vector::mul( vY, vY ) ), Vector::mul( vZ, vZ ) ) );
+        const Type r = Vector::div( Vector::add( minRate, Vector::mul( betaRate, speed ) ), scale );
+        const Type alpha = Vector::div( r, Vector::add( one, r ) );
+
+        // Low-pass filter of position ( initial start value is raw position )
+        const Type filtX = Vector::select( first, x, Vector::add( previousX, Vector::mul( alpha, Vector::sub( x, previousX ) ) ) );
+        const Type filtY = Vector::select( first, y, Vector::add( previousY, Vector::mul( alpha, Vector::sub( y, previousY ) ) ) );
+        const Type filtZ = Vector::select( first, z, Vector::add( previousZ, Vector::mul( alpha, Vector::sub( z, previousZ ) ) ) );
+        Vector::store( &lanes.outputX[lane], filtX );
+        Vector::store( &lanes.outputY[lane], filtY );
+        Vector::store( &lanes.outputZ[lane], filtZ );
+
+        // Save the data from this frame
+        Vector::store( &filteredX[lane], filtX );
+        Vector::store( &filteredY[lane], filtY );
+        Vector::store( &filteredZ[lane], filtZ );
+        Vector::store( &velocityX[lane], vX );
+        Vector::store( &velocityY[lane], vY );
+        Vector::store( &velocityZ[lane], vZ );
+        Vector::store( &frameCount[lane], Vector::min( Vector::add( count, one ), one ) );
+    }
+}
+
+// Kalman Filter
+// Predict by constant velocity model, then correct by measurement ( all axes share covariance because they have same noise ).
+template<typename Vector>
+void KalmanFilter::update( const Parameters& parameters, const float time, const JointLanes& lanes, const int begin, const int end )
+{
+    typedef typename Vector::Type Type;
+    typedef typename Vector::Mask Mask;
+
+    float* frameCount = lanes.states[0];
+    float* positionX = lanes.states[1];
+    float* positionY = lanes.states[2];
+    float* positionZ = lanes.states[3];
+    float* velocityX = lanes.states[4];
+    float* velocityY = lanes.states[5];
+    float* velocityZ = lanes.states[6];
+    float* covariance00 = lanes.states[7];
+    float* covariance01 = lanes.states[8];
+    float* covariance11 = lanes.states[9];
+
+    // Process Noise of White Noise Acceleration ( Q = q * [ t^3/3, t^2/2; t^2/2, t ] )
+    const float period = std::max( 0.001f, time );
+    const Type zero = Vector::set( 0.0f );
+    const Type one = Vector::set( 1.0f );
+    const Type t = Vector::set( period );
+    const Type noise00 = Vector::set( parameters.acceleration * period * period * period / 3.0f );
+    const Type noise01 = Vector::set( parameters.acceleration * period * period / 2.0f );
+    const Type noise11 = Vector::set( parameters.acceleration * period );
+    const Type measurement = Vector::set( parameters.noise * parameters.noise );
+    const Type prediction = Vector::set( parameters.prediction );
+    const Type initialVelocity = Vector::set( 1.0f ); // [m^2/s^2], variance of velocity at initial start
+
+    for( int lane = begin; lane < end; lane += Vector::WIDTH ){
+        const Type x = Vector::load( &lanes.inputX[lane] );
+        const Type y = Vector::load( &lanes.inputY[lane] );
+        const Type z = Vector::load( &lanes.inputZ[lane] );
+        const Type scale = Vector::load( &lanes.radiusScale[lane] );
+        const Type previousX = Vector::load( &positionX[lane] );
+        const Type previousY = Vector::load( &positionY[lane] );
+        const Type previousZ = Vector::load( &positionZ[lane] );
+        const Type previousVelocityX = Vector::load( &velocityX[lane] );
+        const Type previousVelocityY = Vector::load( &velocityY[lane] );
+        const Type previousVelocityZ = Vector::load( &velocityZ[lane] );
+        const Type p00 = Vector::load( &covariance00[lane] );
+        const Type p01 = Vector::load( &covariance01[lane] );
+        const Type p11 = Vector::load( &covariance11[lane] );
+
+        // If joint is invalid ( 0, 0, 0 ), reset the filter
+        const Mask valid = Vector::bitOr( Vector::bitOr( Vector::notEqual( x, zero ), Vector::notEqual( y, zero ) ), Vector::notEqual( z, zero ) );
+        const Type count = Vector::select( valid, Vector::load( &frameCount[lane] ), zero );
+        const Mask first = Vector::lessEqual( count, zero );
+
+        // Measurement noise ( inferred joints are noisier )
+        const Type r = Vector::mul( measurement, Vector::mul( scale, scale ) );
+
+        // Predict
+        const Type predictedX = Vector::add( previousX, Vector::mul( previousVelocityX, t ) );
+        const Type predictedY = Vector::add( previousY, Vector::mul( previousVelocityY, t ) );
+        const Type predictedZ = Vector::add( previousZ, Vector::mul( previousVelocityZ, t ) );
+        const Type p11t = Vector::mul( p11, t );
+        const Type predicted00 = Vector::add( Vector::add( p00, Vector::mul( Vector::add( Vector::add( p01, p01 ), p11t ), t ) ), noise00 );
+        const Type predicted01 = Vector::add( Vector::add( p01, p11t ), noise01 );
+        const Type predicted11 = Vector::add( p11, noise11 );
+
+        // Correct
+        const Type inverseInnovation = Vector::div( one, Vector::add( predicted00, r ) );
+        const Type gain0 = Vector::mul( predicted00, inverseInnovation );
+        const Type gain1 = Vector::mul( predicted01, inverseInnovation );
+        const Type residualX = Vector::sub( x, predictedX );
+        const Type residualY = Vector::sub( y, predictedY );
+        const Type residualZ = Vector::sub( z, predictedZ );
+
+        // Select State by Frame Count ( initial start value is raw position at rest )
+        const Type pX = Vector::select( first, x, Vector::add( predictedX, Vector::mul( gain0, residualX ) ) );
+        const Type pY = Vector::select( first, y, Vector::add( predictedY, Vector::mul( gain0, residualY ) ) );
+        const Type pZ = Vector::select( first, z, Vector::add( predictedZ, Vector::mul( gain0, residualZ ) ) );
+        const Type vX = Vector::select( first, zero, Vector::add( previousVelocityX, Vector::mul( gain1, residualX ) ) );
+        const Type vY = Vector::select( first, zero, Vector::add( previousVelocityY, Vector::mul( gain1, residualY ) ) );
+        const Type vZ = Vector::select( first, zero, Vector::add( previousVelocityZ, Vector::mul( gain1, residualZ ) ) );
+        const Type inverseGain0 = Vector::sub( one, gain0 );
+        const Type c00 = Vector::select( first, r, Vector::mul( inverseGain0, predicted00 ) );
+        const Type c01 = Vector::select( first, zero, Vector::mul( inverseGain0, predicted01 ) );
+        const Type c11 = Vector::select( first, initialVelocity, Vector::sub( predicted11, Vector::mul( gain1, predicted01 ) ) );
+
+        // Predict into the future to reduce latency
+        Vector::store( &lanes.outputX[lane], Vector::add( pX, Vector::mul( vX, prediction ) ) );
+        Vector::store( &lanes.outputY[lane], Vector::add( pY, Vector::mul( vY, prediction ) ) );
+        Vector::store( &lanes.outputZ[lane], Vector::add( pZ, Vector::mul( vZ, prediction ) ) );
+
+        // Save the data from this frame
+        Vector::store( &positionX[lane], pX );
+        Vector::store( &positionY[lane], pY );
+        Vector::store( &positionZ[lane], pZ );
+        Vector::store( &velocityX[lane], vX );
+        Vector::store( &velocityY[lane], vY );
+        Vector::store( &velocityZ[lane], vZ );
+        Vector::store( &covariance00[lane], c00 );
+        Vector::store( &covariance01[lane], c01 );
+        Vector::store( &covariance11[lane], c11 );
+        Vector::store( &frameCount[lane], Vector::min( Vector::add( count, one ), one ) );
+    }
+}
+
+// Constructor
+template<typename Filter>
+JointFilterBank<Filter>::JointFilterBank( const int bodies )
+    : bodies( bodies ),
+      lanes( bodies * STRIDE )
+{
+    // Allocate All Arrays in One Storage ( aligned to cache line )
+    const int arrays = 7 + Filter::STATES;
+    const int alignment = 64 / sizeof( float );
+    storage.assign( arrays * lanes + alignment, 0.0f );
+    float* pointer = &storage[0];
+    pointer += ( alignment - ( reinterpret_cast<uintptr_t>( pointer ) / sizeof( float ) ) % alignment ) % alignment;
+    float** destinations[7] = { &inputX, &inputY, &inputZ, &radiusScale, &outputX, &outputY, &outputZ };
+    for( int index = 0; index < 7; index++ ){
+        *destinations[index] = pointer + index * lanes;
+    }
+    for( int index = 0; index < Filter::STATES; index++ ){
+        filterStates[index] = pointer + ( 7 + index ) * lanes;
+    }
+    std::fill( radiusScale, radiusScale + lanes, 1.0f );
+
+    // Indices and Elapsed Times of All Bodies
+    indices.resize( bodies );
+    for( int body = 0; body < bodies; body++ ){
+        indices[body] = body;
+    }
+    times.resize( bodies );
+
+    // Initialize
+    initialize();
+}
+
+// Initialize Parameters and Reset All Filters
+template<typename Filter>
+void JointFilterBank<Filter>::initialize( const Parameters& parameters )
+{
+    this->parameters = parameters;
+
+    for( float* array : { outputX, outputY, outputZ } ){
+        std::fill( array, array + lanes, 0.0f );
+    }
+    for( float* array : filterStates ){
+        std::fill( array, array + lanes, 0.0f );
+    }
+}
+
+// Reset Filters of Body
+template<typename Filter>
+void JointFilterBank<Filter>::reset( const int body )
+{
+    const int begin = body * STRIDE;
+    std::fill( filterStates[0] + begin, filterStates[0] + begin + JOINTS, 0.0f );
+}
+
+// Set Raw Joints of Body
+template<typename Filter>
+void JointFilterBank<Filter>::setJoints( const int body, const float positions[][3], const uint8_t* states )
+{
+    const int begin = body * STRIDE;
+    for( int joint = 0; joint < JOINTS; joint++ ){
+        inputX[begin + joint] = positions[joint][0];
+        inputY[begin + joint] = positions[joint][1];
+        inputZ[begin + joint] = positions[joint][2];
+
+        // If inferred, we smooth a bit more by using a bigger jitter radius ( TrackingState_Inferred is 1 )
+        radiusScale[begin + joint] = ( states[joint] == 1 ) ? 2.0f : 1.0f;
+    }
+}
+
+// Clear Raw Joints of Body
+template<typename Filter>
+void JointFilterBank<Filter>::clearJoints( const int body )
+{
+    const int begin = body * STRIDE;
+    std::fill( inputX + begin, inputX + begin + JOINTS, 0.0f );
+    std::fill( inputY + begin, inputY + begin + JOINTS, 0.0f );
+    std::fill( inputZ + begin, inputZ + begin + JOINTS, 0.0f );
+    std::fill( radiusScale + begin, radiusScale + begin + JOINTS, 1.0f );
+}
+
+// Update All Filters
+template<typename Filter>
+void JointFilterBank<Filter>::update( const float time )
+{
+    std::fill( times.begin(), times.end(), time );
+    update( &indices[0], &times[0], bodies );
+}
+
+// Update Filters of Bodies
+template<typename Filter>
+void JointFilterBank<Filter>::update( const int* indices, const float* times, const int count )
+{
+    const JointLanes arrays = { inputX, inputY, inputZ, radiusScale, outputX, outputY, outputZ, filterStates };
+
+    #pragma omp parallel for if( count > 1 )
+    for( int index = 0; index < count; index++ ){
+        // Lanes are padded to multiple of 8, so there are no remaining lanes
+        const int begin = indices[index] * STRIDE;
+#if defined( __AVX2__ ) || defined( _M_X64 ) || defined( __SSE2__ )
+        // States of still joints decay into denormals that stall vector units, so flush them to zero while updating ( per thread )
+        const unsigned int csr = _mm_getcsr();
+        _mm_setcsr( csr | 0x8040 ); // Flush to Zero and Denormals are Zero
+#if defined( __AVX2__ )
+        Filter::template update<AVXVector>( parameters, times[index], arrays, begin, begin + STRIDE );
+#else
+        Filter::template update<SSEVector>( parameters, times[index], arrays, begin, begin + STRIDE );
+#endif
+        _mm_setcsr( csr );
+#else
+        Filter::template update<ScalarVector>( parameters, times[index], arrays, begin, begin + STRIDE );
+#endif
+    }
+}
+
+// Explicit Instantiation of Filter Policies
+template class JointFilterBank<HoltFilter>;
+template class JointFilterBank<OneEuroFilter>;
+template class JointFilterBank<KalmanFilter>;
\ No newline at end of file
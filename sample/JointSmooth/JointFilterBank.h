@@ -0,0 +1,179 @@
+#ifndef __JOINT_FILTER_BANK__
+#define __JOINT_FILTER_BANK__
+
+#include <vector>
+#include <cstdint>
+
+// Joint Lanes
+// Arrays of lanes that filter policy reads and writes ( states[0] of every filter is frame count, and 0 restarts the filter ).
+struct JointLanes
+{
+    const float* inputX;
+    const float* inputY;
+    const float* inputZ;
+    const float* radiusScale; // 2 for inferred joints to smooth a bit more, otherwise 1
+    float* outputX;
+    float* outputY;
+    float* outputZ;
+    float* const* states;
+};
+
+// Holt Filter
+// Holt double exponential smoothing filter ( same as Sample::FilterDoubleExponential, time is not used ).
+struct HoltFilter
+{
+    // Smoothing Parameters ( same as TRANSFORM_SMOOTH_PARAMETERS )
+    struct Parameters
+    {
+        float smoothing;          // [0..1], lower values closer to raw data
+        float correction;         // [0..1], lower values slower to correct towards the raw data
+        float prediction;         // [0..n], the number of frames to predict into the future
+        float jitterRadius;       // The radius in meters for jitter reduction
+        float maxDeviationRadius; // The maximum radius in meters that filtered positions are allowed to deviate from raw data
+
+        Parameters( const float smoothing = 0.25f, const float correction = 0.25f, const float prediction = 0.25f, const float jitterRadius = 0.03f, const float maxDeviationRadius = 0.05f )
+            : smoothing( smoothing ), correction( correction ), prediction( prediction ), jitterRadius( jitterRadius ), maxDeviationRadius( maxDeviationRadius )
+        {
+        }
+    };
+
+    // Frame Count, Raw Position, Filtered Position, Trend
+    static const int STATES = 10;
+
+    template<typename Vector>
+    static void update( const Parameters& parameters, const float time, const JointLanes& lanes, const int begin, const int end );
+};
+
+// One Euro Filter
+// Low-pass filter whose cutoff frequency rises with speed, so that it removes jitter at rest and keeps lag small on fast movements.
+struct OneEuroFilter
+{
+    struct Parameters
+    {
+        float minCutoff;        // [Hz], cutoff frequency at rest, lower values remove more jitter
+        float beta;             // [Hz/(m/s)], increase of cutoff frequency by speed, higher values reduce lag
+        float derivativeCutoff; // [Hz], cutoff frequency of speed
+
+        Parameters( const float minCutoff = 1.0f, const float beta = 3.0f, const float derivativeCutoff = 1.0f )
+            : minCutoff( minCutoff ), beta( beta ), derivativeCutoff( derivativeCutoff )
+        {
+        }
+    };
+
+    // Frame Count, Filtered Position, Filtered Velocity
+    static const int STATES = 7;
+
+    template<typename Vector>
+    static void update( const Parameters& parameters, const float time, const JointLanes& lanes, const int begin, const int end );
+};
+
+// Kalman Filter
+// Constant velocity Kalman filter of each axis driven by white noise acceleration ( covariance is shared by all axes ).
+struct KalmanFilter
+{
+    struct Parameters
+    {
+        float acceleration; // [m^2/s^3], spectral density of acceleration, higher values follow faster movements
+        float noise;        // [m], standard deviation of measurement noise ( scaled by radius scale )
+        float prediction;   // [s], time to predict into the future
+
+        Parameters( const float acceleration = 2.0f, const float noise = 0.01f, const float prediction = 0.0f )
+            : acceleration( acceleration ), noise( noise ), prediction( prediction )
+        {
+        }
+    };
+
+    // Frame Count, Position, Velocity, Covariance ( P00, P01, P11 )
+    static const int STATES = 10;
+
+    template<typename Vector>
+    static void update( const Parameters& parameters, const float time, const JointLanes& lanes, const int begin, const int end );
+};
+
+// Joint Filter Bank
+// Filter policy ( HoltFilter, OneEuroFilter or KalmanFilter ) for all joints of all bodies.
+// Joints are stored in structure of arrays layout, and updated at once with AVX2 or SSE2 ( masked blends instead of branches ).
+// Lanes of each body start at cache line boundary, so that bodies can be updated by different threads without false sharing.
+// This class has no dependency on Kinect SDK and DirectXMath.
+template<typename Filter>
+class JointFilterBank
+{
+public:
+    // Number of Bodies and Joints ( same as BODY_COUNT and JointType_Count )
+    static const int BODIES = 6;
+    static const int JOINTS = 25;
+
+    // Number of Lanes per Body ( padded to multiple of 64 bytes cache line, also multiple of 8 for AVX2 )
+    static const int STRIDE = ( JOINTS + 15 ) / 16 * 16;
+
+    typedef typename Filter::Parameters Parameters;
+
+private:
+    Parameters parameters;
+    int bodies;
+    int lanes;
+
+    // Storage of All Arrays ( aligned to cache line )
+    std::vector<float> storage;
+
+    // Input ( raw positions and scale of radius )
+    float* inputX;
+    float* inputY;
+    float* inputZ;
+    float* radiusScale;
+
+    // Output ( filtered positions )
+    float* outputX;
+    float* outputY;
+    float* outputZ;
+
+    // States of Filter
+    float* filterStates[Filter::STATES];
+
+    // Indices and Elapsed Times of All Bodies ( for updating all filters without allocation )
+    std::vector<int> indices;
+    std::vector<float> times;
+
+public:
+    // Constructor ( number of bodies can be more than BODIES to keep lost bodies )
+    JointFilterBank( const int bodies = BODIES );
+
+    // Copy is not allowed ( arrays point into own storage )
+    JointFilterBank( const JointFilterBank& ) = delete;
+    JointFilterBank& operator=( const JointFilterBank& ) = delete;
+
+    // Retrieve Number of Bodies
+    int getBodies() const
+    {
+        return bodies;
+    }
+
+    // Initialize Parameters and Reset All Filters
+    void initialize( const Parameters& parameters = Parameters() );
+
+    // Reset Filters of Body
+    void reset( const int body );
+
+    // Set Raw Joints of Body ( states are TrackingState )
+    void setJoints( const int body, const float positions[][3], const uint8_t* states );
+
+    // Clear Raw Joints of Body ( filters of body are reset by next update )
+    void clearJoints( const int body );
+
+    // Update All Filters ( time is elapsed time from previous update [s] )
+    void update( const float time = 1.0f / 30.0f );
+
+    // Update Filters of Bodies ( in parallel, lanes of other bodies are untouched, times are elapsed time of each body [s] )
+    void update( const int* indices, const float* times, const int count );
+
+    // Retrieve Filtered Joint
+    void getFilteredJoint( const int body, const int joint, float position[3] ) const
+    {
+        const int lane = body * STRIDE + joint;
+        position[0] = outputX[lane];
+        position[1] = outputY[lane];
+        position[2] = outputZ[lane];
+    }
+};
+
+#endif // __JOINT_FILTER_BANK__
\ No newline at end of file
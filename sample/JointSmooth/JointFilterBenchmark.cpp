@@ -0,0 +1,451 @@
+#include "JointFilterBenchmark.h"
+
+#include <cmath>
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+
+// Naive Orientation Filter
+// Same algorithm as orientation filter bank for one joint, with standard math functions and branches.
+class NaiveOrientationFilter
+{
+private:
+    float filtered[4];
+    float trend[3];
+    int count;
+
+public:
+    // Constructor
+    NaiveOrientationFilter()
+    {
+        reset();
+    }
+
+    // Reset Filter
+    void reset()
+    {
+        count = 0;
+    }
+
+    // Update Filter
+    void update( const float raw[4], const OrientationFilterBank::Parameters& parameters, float output[4] )
+    {
+        const float length = std::sqrt( raw[0] * raw[0] + raw[1] * raw[1] + raw[2] * raw[2] + raw[3] * raw[3] );
+        if( length < std::sqrt( 0.5f ) ){
+            std::fill( output, output + 4, 0.0f );
+            count = 0;
+            return;
+        }
+        float q[4] = { raw[0] / length, raw[1] / length, raw[2] / length, raw[3] / length };
+
+        if( count == 0 ){
+            std::copy( q, q + 4, filtered );
+            std::fill( trend, trend + 3, 0.0f );
+            std::copy( q, q + 4, output );
+            count = 1;
+            return;
+        }
+
+        // Predict by trend, and flip raw orientation into same hemisphere
+        float step[4], predicted[4];
+        exp( trend, 1.0f, step );
+        multiply( filtered, step, predicted );
+        if( q[0] * predicted[0] + q[1] * predicted[1] + q[2] * predicted[2] + q[3] * predicted[3] < 0.0f ){
+            for( float& value : q ){
+                value = -value;
+            }
+        }
+
+        // Move predicted orientation towards raw orientation in tangent space
+        float inverse[4], difference[4], error[3], correction[4], current[4];
+        conjugate( predicted, inverse );
+        multiply( inverse, q, difference );
+        log( difference, error );
+        exp( error, 1.0f - parameters.smoothing, correction );
+        multiply( predicted, correction, current );
+        const float norm = std::sqrt( current[0] * current[0] + current[1] * current[1] + current[2] * current[2] + current[3] * current[3] );
+        for( float& value : current ){
+            value /= norm;
+        }
+
+        // Trend
+        float delta[3];
+        conjugate( filtered, inverse );
+        multiply( inverse, current, difference );
+        log( difference, delta );
+        for( int axis = 0; axis < 3; axis++ ){
+            trend[axis] = delta[axis] * parameters.correction + trend[axis] * ( 1.0f - parameters.correction );
+        }
+        std::copy( current, current + 4, filtered );
+
+        // Predict into the future
+        exp( trend, parameters.prediction, step );
+        multiply( filtered, step, output );
+    }
+
+private:
+    static void multiply( const float a[4], const float b[4], float q[4] )
+    {
+        q[0] = a[3] * b[0] + a[0] * b[3] + a[1] * b[2] - a[2] * b[1];
+        q[1] = a[3] * b[1] + a[1] * b[3] + a[2] * b[0] - a[0] * b[2];
+        q[2] = a[3] * b[2] + a[2] * b[3] + a[0] * b[1] - a[1] * b[0];
+        q[3] = a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2];
+    }
+
+    static void conjugate( const float a[4], float q[4] )
+    {
+        q[0] = -a[0];
+        q[1] = -a[1];
+        q[2] = -a[2];
+        q[3] = a[3];
+    }
+
+    static void log( const float a[4], float v[3] )
+    {
+        const float sign = ( a[3] < 0.0f ) ? -1.0f : 1.0f;
+        const float length = std::sqrt( a[0] * a[0] + a[1] * a[1] + a[2] * a[2] );
+        const float scale = ( length <= 1e-6f ) ? 2.0f : 2.0f * std::atan2( length, std::fabs( a[3] ) ) / length;
+        for( int axis = 0; axis < 3; axis++ ){
+            v[axis] = a[axis] * scale * sign;
+        }
+    }
+
+    static void exp( const float v[3], const float scale, float q[4] )
+    {
+        const float angle = std::sqrt( v[0] * v[0] + v[1] * v[1] + v[2] * v[2] ) * scale;
+        if( angle <= 1e-6f ){
+            q[0] = v[0] * scale * 0.5f;
+            q[1] = v[1] * scale * 0.5f;
+            q[2] = v[2] * scale * 0.5f;
+            q[3] = 1.0f;
+            return;
+        }
+        const float half = std::min( angle * 0.5f, 1.57079633f );
+        const float factor = std::sin( half ) / angle * scale;
+        q[0] = v[0] * factor;
+        q[1] = v[1] * factor;
+        q[2] = v[2] * factor;
+        q[3] = std::cos( half );
+    }
+};
+
+// Constructor
+JointFilterBenchmark::JointFilterBenchmark()
+{
+}
+
+// Open Recorded Skeleton File
+bool JointFilterBenchmark::open( const std::string& path )
+{
+    if( !replayer.open( path ) ){
+        return false;
+    }
+
+    // Replay at Maximum Speed
+    replayer.setRealtime( false );
+
+    return true;
+}
+
+// Run All Filters with Default Parameters
+void JointFilterBenchmark::run()
+{
+    results.clear();
+
+    run<HoltFilter>( "Holt" );
+    run<OneEuroFilter>( "OneEuro" );
+    run<KalmanFilter>( "Kalman" );
+
+    runOrientation();
+}
+
+// Run Filter
+template<typename Filter>
+void JointFilterBenchmark::run( const std::string& name, const typename Filter::Parameters& parameters )
+{
+    const int BODIES = SkeletonFrame::BODIES;
+    const int JOINTS = SkeletonFrame::JOINTS;
+    const int LAGS = MAX_LAG + 1;
+
+    JointFilterManager<Filter> manager;
+    manager.initialize( parameters );
+
+    // History of Each Joint ( ring buffers of raw and filtered positions, reset when TrackingId is changed )
+    std::vector<float> raws( BODIES * JOINTS * LAGS * 3 );
+    std::vector<float> filtereds( BODIES * JOINTS * 2 * 3 );
+    std::vector<uint64_t> trackingIds( BODIES, 0 );
+    std::vector<int> lengths( BODIES, 0 );
+
+    // Accumulators
+    std::vector<double> errors( LAGS, 0.0 );
+    double jitter = 0.0;
+    double rawJitter = 0.0;
+    int64_t jitterCount = 0;
+    int64_t errorCount = 0;
+    double time = 0.0;
+    int64_t frames = 0;
+
+    SkeletonFrame frame;
+    replayer.rewind();
+    while( replayer.read( frame ) ){
+        // Update Filters
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        manager.begin( frame.timestamp );
+        for( const SkeletonFrame::Body& body : frame.bodies ){
+            if( body.tracked ){
+                manager.setJoints( body.trackingId, body.positions, body.states );
+            }
+        }
+        manager.update();
+        time += std::chrono::duration<double, std::micro>( std::chrono::steady_clock::now() - start ).count();
+        frames++;
+
+        for( int index = 0; index < BODIES; index++ ){
+            const SkeletonFrame::Body& body = frame.bodies[index];
+            if( !body.tracked ){
+                trackingIds[index] = 0;
+                lengths[index] = 0;
+                continue;
+            }
+
+            // Restart History of New Body
+            if( body.trackingId != trackingIds[index] ){
+                trackingIds[index] = body.trackingId;
+                lengths[index] = 0;
+            }
+            const int length = lengths[index]++;
+
+            for( int joint = 0; joint < JOINTS; joint++ ){
+                float filtered[3];
+                manager.getFilteredJoint( body.trackingId, joint, filtered );
+
+                float* raw = &raws[( index * JOINTS + joint ) * LAGS * 3];
+                float* history = &filtereds[( index * JOINTS + joint ) * 2 * 3];
+                float* current = &raw[( length % LAGS ) * 3];
+                std::copy( body.positions[joint], body.positions[joint] + 3, current );
+
+                // Jitter ( second difference of filtered and raw positions )
+                if( length >= 2 ){
+                    const float* raw1 = &raw[( ( length - 1 ) % LAGS ) * 3];
+                    const float* raw2 = &raw[( ( length - 2 ) % LAGS ) * 3];
+                    const float* filtered1 = &history[( ( length - 1 ) % 2 ) * 3];
+                    const float* filtered2 = &history[( length % 2 ) * 3];
+                    for( int axis = 0; axis < 3; axis++ ){
+                        const double difference = filtered[axis] - 2.0 * filtered1[axis] + filtered2[axis];
+                        const double rawDifference = current[axis] - 2.0 * raw1[axis] + raw2[axis];
+                        jitter += difference * difference;
+                        rawJitter += rawDifference * rawDifference;
+                    }
+                    jitterCount++;
+                }
+
+                // Difference from Delayed Raw Positions
+                if( length >= MAX_LAG ){
+                    for( int lag = 0; lag < LAGS; lag++ ){
+                        const float* delayed = &raw[( ( length - lag ) % LAGS ) * 3];
+                        double error = 0.0;
+                        for( int axis = 0; axis < 3; axis++ ){
+                            const double difference = filtered[axis] - delayed[axis];
+                            error += difference * difference;
+                        }
+                        errors[lag] += error;
+                    }
+                    errorCount++;
+                }
+
+                std::copy( filtered, filtered + 3, &history[( length % 2 ) * 3] );
+            }
+        }
+    }
+
+    // Lag that Minimizes Difference ( refined by parabola through neighbors )
+    const int minimum = static_cast<int>( std::min_element( errors.begin(), errors.end() ) - errors.begin() );
+    double lag = minimum;
+    if( minimum > 0 && minimum < MAX_LAG ){
+        const double curvature = errors[minimum - 1] - 2.0 * errors[minimum] + errors[minimum + 1];
+        if( curvature > 0.0 ){
+            lag += 0.5 * ( errors[minimum - 1] - errors[minimum + 1] ) / curvature;
+        }
+    }
+
+    // Raw Baseline
+    if( results.empty() ){
+        Result result = { "Raw", ( jitterCount > 0 ) ? std::sqrt( rawJitter / jitterCount ) * 1000.0 : 0.0, 0.0, 0.0, 0.0 };
+        results.push_back( result );
+    }
+
+    Result result;
+    result.name = name;
+    result.jitter = ( jitterCount > 0 ) ? std::sqrt( jitter / jitterCount ) * 1000.0 : 0.0;
+    result.lag = ( errorCount > 0 ) ? lag : 0.0;
+    result.error = ( errorCount > 0 ) ? std::sqrt( errors[0] / errorCount ) * 1000.0 : 0.0;
+    result.time = ( frames > 0 ) ? time / frames : 0.0;
+    results.push_back( result );
+}
+
+// Angle between Orientations [deg] ( q and -q are same orientation, invalid orientation ( 0, 0, 0, 0 ) only matches invalid orientation )
+static double angle( const float a[4], const float b[4] )
+{
+    double dot = 0.0, aNorm = 0.0, bNorm = 0.0;
+    for( int component = 0; component < 4; component++ ){
+        dot += static_cast<double>( a[component] ) * b[component];
+        aNorm += static_cast<double>( a[component] ) * a[component];
+        bNorm += static_cast<double>( b[component] ) * b[component];
+    }
+    if( !( aNorm > 0.0 ) || !( bNorm > 0.0 ) ){
+        return ( aNorm > 0.0 || bNorm > 0.0 ) ? 180.0 : 0.0;
+    }
+    const double norm = std::sqrt( aNorm * bNorm );
+    return 2.0 * std::acos( std::min( 1.0, std::fabs( dot ) / norm ) ) * 180.0 / 3.14159265358979;
+}
+
+// Run Orientation Filter Bank and Naive Filter
+// Filters are kept by body index, and reset when TrackingId is changed.
+// Synthetic sequence of valid, invalid ( 0, 0, 0, 0 ) and valid orientations is also compared, so that filters must restart from raw orientation after dropout.
+void JointFilterBenchmark::runOrientation( const OrientationFilterBank::Parameters& parameters )
+{
+    const int BODIES = SkeletonFrame::BODIES;
+    const int JOINTS = SkeletonFrame::JOINTS;
+
+    OrientationFilterBank bank( BODIES );
+    bank.initialize( parameters );
+    std::vector<NaiveOrientationFilter> filters( BODIES * JOINTS );
+    std::vector<uint64_t> trackingIds( BODIES, 0 );
+    std::vector<int> indices;
+
+    double bankTime = 0.0;
+    double naiveTime = 0.0;
+    double difference = 0.0;
+    int64_t frames = 0;
+
+    SkeletonFrame frame;
+    replayer.rewind();
+    while( replayer.read( frame ) ){
+        // Set Orientations of Tracked Bodies
+        indices.clear();
+        for( int index = 0; index < BODIES; index++ ){
+            const SkeletonFrame::Body& body = frame.bodies[index];
+            if( !body.tracked ){
+                trackingIds[index] = 0;
+                continue;
+            }
+            if( body.trackingId != trackingIds[index] ){
+                trackingIds[index] = body.trackingId;
+                bank.reset( index );
+                for( int joint = 0; joint < JOINTS; joint++ ){
+                    filters[index * JOINTS + joint].reset();
+                }
+            }
+            bank.setOrientations( index, body.orientations );
+            indices.push_back( index );
+        }
+        if( indices.empty() ){
+            continue;
+        }
+
+        // Update Filter Bank
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        bank.update( &indices[0], static_cast<int>( indices.size() ) );
+        bankTime += std::chrono::duration<double, std::micro>( std::chrono::steady_clock::now() - start ).count();
+
+        // Update Naive Filters
+        std::vector<float> outputs( indices.size() * JOINTS * 4 );
+        start = std::chrono::steady_clock::now();
+        for( size_t index = 0; index < indices.size(); index++ ){
+            const SkeletonFrame::Body& body = frame.bodies[indices[index]];
+            for( int joint = 0; joint < JOINTS; joint++ ){
+                filters[indices[index] * JOINTS + joint].update( body.orientations[joint], parameters, &outputs[( index * JOINTS + joint ) * 4] );
+            }
+        }
+        naiveTime += std::chrono::duration<double, std::micro>( std::chrono::steady_clock::now() - start ).count();
+        frames++;
+
+        // Angle between Filtered Orientations
+        for( size_t index = 0; index < indices.size(); index++ ){
+            for( int joint = 0; joint < JOINTS; joint++ ){
+                float filtered[4];
+                bank.getFilteredOrientation( indices[index], joint, filtered );
+                difference = std::max( difference, angle( filtered, &outputs[( index * JOINTS + joint ) * 4] ) );
+            }
+        }
+    }
+
+    // Dropout Sequence ( valid, invalid and valid again, on every joint of first body )
+    // Output of invalid orientation is ( 0, 0, 0, 0 ) on both filters, so that only valid frames are compared.
+    const float sequence[][4] = {
+        { 0.0f, 0.0f, 0.0f, 1.0f },
+        { 0.2588190f, 0.0f, 0.0f, 0.9659258f },
+        { 0.5f, 0.0f, 0.0f, 0.8660254f },
+        { 0.7071068f, 0.0f, 0.0f, 0.7071068f },
+        { 0.0f, 0.0f, 0.0f, 0.0f },
+        { 0.0f, 0.0f, 0.0f, 0.0f },
+        { 0.7071068f, 0.0f, 0.0f, 0.7071068f },
+        { 0.0f, 0.7071068f, 0.0f, 0.7071068f },
+        { 0.0f, 0.0f, 0.0f, 0.0f },
+        { 0.0f, 0.0f, 0.5f, 0.8660254f },
+        { 0.0f, 0.0f, 0.7071068f, 0.7071068f }
+    };
+    bank.reset( 0 );
+    for( int joint = 0; joint < JOINTS; joint++ ){
+        filters[joint].reset();
+    }
+    const int body = 0;
+    for( const auto& orientation : sequence ){
+        float orientations[JOINTS][4];
+        for( int joint = 0; joint < JOINTS; joint++ ){
+            std::copy( orientation, orientation + 4, orientations[joint] );
+        }
+        bank.setOrientations( body, orientations );
+        bank.update( &body, 1 );
+        for( int joint = 0; joint < JOINTS; joint++ ){
+            float filtered[4], naive[4];
+            bank.getFilteredOrientation( body, joint, filtered );
+            filters[joint].update( orientation, parameters, naive );
+            difference = std::max( difference, angle( filtered, naive ) );
+        }
+    }
+
+    orientationResults.clear();
+    OrientationResult naive = { "Naive", 0.0, ( frames > 0 ) ? naiveTime / frames : 0.0 };
+    orientationResults.push_back( naive );
+    OrientationResult vectorized = { "Bank", difference, ( frames > 0 ) ? bankTime / frames : 0.0 };
+    orientationResults.push_back( vectorized );
+}
+
+// Print Results as Table
+void JointFilterBenchmark::print( std::ostream& stream ) const
+{
+    stream << std::left << std::setw( 10 ) << "Filter" << std::right
+           << std::setw( 14 ) << "Jitter [mm]"
+           << std::setw( 14 ) << "Lag [frames]"
+           << std::setw( 14 ) << "Error [mm]"
+           << std::setw( 14 ) << "Time [us]" << std::endl;
+
+    for( const Result& result : results ){
+        stream << std::left << std::setw( 10 ) << result.name << std::right << std::fixed << std::setprecision( 3 )
+               << std::setw( 14 ) << result.jitter
+               << std::setw( 14 ) << result.lag
+               << std::setw( 14 ) << result.error
+               << std::setw( 14 ) << result.time << std::endl;
+    }
+
+    if( orientationResults.empty() ){
+        return;
+    }
+
+    stream << std::endl;
+    stream << std::left << std::setw( 10 ) << "Rotation" << std::right
+           << std::setw( 14 ) << "Diff [deg]"
+           << std::setw( 14 ) << "Time [us]" << std::endl;
+
+    for( const OrientationResult& result : orientationResults ){
+        stream << std::left << std::setw( 10 ) << result.name << std::right << std::fixed << std::setprecision( 3 )
+               << std::setw( 14 ) << result.difference
+               << std::setw( 14 ) << result.time << std::endl;
+    }
+}
+
+// Explicit Instantiation of Filter Policies
+template void JointFilterBenchmark::run<HoltFilter>( const std::string&, const HoltFilter::Parameters& );
+template void JointFilterBenchmark::run<OneEuroFilter>( const std::string&, const OneEuroFilter::Parameters& );
+template void JointFilterBenchmark::run<KalmanFilter>( const std::string&, const KalmanFilter::Parameters& );
\ No newline at end of file
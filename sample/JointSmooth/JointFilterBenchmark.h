@@ -0,0 +1,80 @@
+#ifndef __JOINT_FILTER_BENCHMARK__
+#define __JOINT_FILTER_BENCHMARK__
+
+#include "JointFilterManager.h"
+#include "OrientationFilterBank.h"
+#include "SkeletonStream.h"
+
+#include <vector>
+#include <string>
+#include <ostream>
+
+// Joint Filter Benchmark
+// Recorded skeleton file is replayed at maximum speed through each filter policy, and jitter versus lag of filtered joints is measured.
+// Jitter is RMS of second difference of positions per frame ( raw positions are measured as baseline ).
+// Lag is delay of filtered positions behind raw positions that minimizes their difference ( refined by parabola between frames ).
+// Orientation filter bank is compared with naive per-joint filter ( same algorithm with standard math functions and branches ).
+// This class has no dependency on Kinect SDK.
+class JointFilterBenchmark
+{
+public:
+    // Maximum Lag [frames]
+    static const int MAX_LAG = 10;
+
+    // Result of Filter
+    struct Result
+    {
+        std::string name;
+        double jitter; // [mm], RMS of second difference
+        double lag;    // [frames]
+        double error;  // [mm], RMS of difference from raw positions
+        double time;   // [us], update time per frame
+    };
+
+    // Result of Orientation Filter
+    struct OrientationResult
+    {
+        std::string name;
+        double difference; // [deg], max difference from naive filter
+        double time;       // [us], update time per frame
+    };
+
+private:
+    SkeletonReplayer replayer;
+    std::vector<Result> results;
+    std::vector<OrientationResult> orientationResults;
+
+public:
+    // Constructor
+    JointFilterBenchmark();
+
+    // Open Recorded Skeleton File
+    bool open( const std::string& path );
+
+    // Run All Filters with Default Parameters
+    void run();
+
+    // Run Filter
+    template<typename Filter>
+    void run( const std::string& name, const typename Filter::Parameters& parameters = typename Filter::Parameters() );
+
+    // Run Orientation Filter Bank and Naive Filter
+    void runOrientation( const OrientationFilterBank::Parameters& parameters = OrientationFilterBank::Parameters() );
+
+    // Retrieve Results
+    const std::vector<Result>& getResults() const
+    {
+        return results;
+    }
+
+    // Retrieve Results of Orientation Filters
+    const std::vector<OrientationResult>& getOrientationResults() const
+    {
+        return orientationResults;
+    }
+
+    // Print Results as Table
+    void print( std::ostream& stream ) const;
+};
+
+#endif // __JOINT_FILTER_BENCHMARK__
\ No newline at end of file
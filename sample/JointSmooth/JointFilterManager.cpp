@@ -0,0 +1,148 @@
+#include "JointFilterManager.h"
+
+#include <algorithm>
+
+// Constructor
+template<typename Filter>
+JointFilterManager<Filter>::JointFilterManager( const int capacity, const int64_t timeout )
+    : bank( capacity ),
+      slots( capacity ),
+      timestamp( 0 ),
+      timeout( timeout )
+{
+    updated.reserve( capacity );
+    times.reserve( capacity );
+
+    // Initialize
+    initialize();
+}
+
+// Initialize Parameters and Release All Filters
+template<typename Filter>
+void JointFilterManager<Filter>::initialize( const Parameters& parameters )
+{
+    bank.initialize( parameters );
+
+    for( Slot& slot : slots ){
+        slot.trackingId = 0;
+        slot.lastSeen = 0;
+    }
+    updated.clear();
+    times.clear();
+}
+
+// Begin Frame
+template<typename Filter>
+void JointFilterManager<Filter>::begin( const int64_t timestamp )
+{
+    this->timestamp = timestamp;
+    updated.clear();
+    times.clear();
+
+    // Release Filters of Lost Bodies ( and all filters if timestamp goes backwards, e.g. replay is rewound )
+    for( int index = 0; index < static_cast<int>( slots.size() ); index++ ){
+        Slot& slot = slots[index];
+        if( slot.trackingId != 0 && ( timestamp - slot.lastSeen > timeout || timestamp < slot.lastSeen ) ){
+            slot.trackingId = 0;
+            bank.reset( index );
+        }
+    }
+}
+
+// Set Raw Joints of Tracked Body
+template<typename Filter>
+void JointFilterManager<Filter>::setJoints( const uint64_t trackingId, const float positions[][3], const uint8_t* states )
+{
+    int index = find( trackingId );
+    if( index == -1 ){
+        index = assign( trackingId );
+    }
+
+    // Elapsed Time from Last Update ( 1 frame at 30 [fps] for new body, or if timestamp is not advanced )
+    float time = 1.0f / 30.0f;
+    if( slots[index].lastSeen != 0 && timestamp > slots[index].lastSeen ){
+        time = static_cast<float>( timestamp - slots[index].lastSeen ) / 10000000.0f;
+    }
+
+    slots[index].lastSeen = timestamp;
+    bank.setJoints( index, positions, states );
+    updated.push_back( index );
+    times.push_back( time );
+}
+
+// Update Filters of Bodies Set in This Frame
+template<typename Filter>
+void JointFilterManager<Filter>::update()
+{
+    if( updated.empty() ){
+        return;
+    }
+
+    bank.update( &updated[0], &times[0], static_cast<int>( updated.size() ) );
+}
+
+// Retrieve Filtered Joint
+template<typename Filter>
+bool JointFilterManager<Filter>::getFilteredJoint( const uint64_t trackingId, const int joint, float position[3] ) const
+{
+    const int index = find( trackingId );
+    if( index == -1 ){
+        return false;
+    }
+
+    bank.getFilteredJoint( index, joint, position );
+    return true;
+}
+
+// Retrieve Number of Assigned Filters
+template<typename Filter>
+int JointFilterManager<Filter>::getCount() const
+{
+    return static_cast<int>( std::count_if( slots.begin(), slots.end(), []( const Slot& slot ){ return slot.trackingId != 0; } ) );
+}
+
+// Find Slot of TrackingId
+template<typename Filter>
+int JointFilterManager<Filter>::find( const uint64_t trackingId ) const
+{
+    if( trackingId == 0 ){
+        return -1;
+    }
+
+    for( int index = 0; index < static_cast<int>( slots.size() ); index++ ){
+        if( slots[index].trackingId == trackingId ){
+            return index;
+        }
+    }
+
+    return -1;
+}
+
+// Assign Slot to TrackingId
+template<typename Filter>
+int JointFilterManager<Filter>::assign( const uint64_t trackingId )
+{
+    // Free Slot, otherwise Least Recently Seen Slot
+    int index = 0;
+    for( int candidate = 0; candidate < static_cast<int>( slots.size() ); candidate++ ){
+        if( slots[candidate].trackingId == 0 ){
+            index = candidate;
+            break;
+        }
+        if( slots[candidate].lastSeen < slots[index].lastSeen ){
+            index = candidate;
+        }
+    }
+
+    // Start New Filter
+    slots[index].trackingId = trackingId;
+    slots[index].lastSeen = 0;
+    bank.reset( index );
+
+    return index;
+}
+
+// Explicit Instantiation of Filter Policies
+template class JointFilterManager<HoltFilter>;
+template class JointFilterManager<OneEuroFilter>;
+template class JointFilterManager<KalmanFilter>;
\ No newline at end of file
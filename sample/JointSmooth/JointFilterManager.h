@@ -0,0 +1,64 @@
+#ifndef __JOINT_FILTER_MANAGER__
+#define __JOINT_FILTER_MANAGER__
+
+#include "JointFilterBank.h"
+
+#include <vector>
+#include <cstdint>
+
+// Joint Filter Manager
+// Filters of joint filter bank are assigned to bodies by TrackingId, so that smoothing state follows the person rather than body index.
+// State of lost body is kept until timeout ( it is continued if the person is tracked again ), then the filter is released.
+// Elapsed time of each body is given to the filter, so that time based filters ( OneEuroFilter, KalmanFilter ) follow dropped frames.
+// This class has no dependency on Kinect SDK.
+template<typename Filter>
+class JointFilterManager
+{
+private:
+    // Filter Slot
+    struct Slot
+    {
+        uint64_t trackingId; // 0 if free
+        int64_t lastSeen;    // Timestamp of last update ( 100 [ns] unit, same as TIMESPAN )
+    };
+
+    JointFilterBank<Filter> bank;
+    std::vector<Slot> slots;
+    std::vector<int> updated;
+    std::vector<float> times;
+    int64_t timestamp;
+    int64_t timeout;
+
+public:
+    typedef typename Filter::Parameters Parameters;
+
+    // Constructor ( twice BODIES slots to keep lost bodies, timeout is 1 [s] )
+    JointFilterManager( const int capacity = JointFilterBank<Filter>::BODIES * 2, const int64_t timeout = 10000000 );
+
+    // Initialize Parameters and Release All Filters
+    void initialize( const Parameters& parameters = Parameters() );
+
+    // Begin Frame ( release filters of bodies lost longer than timeout )
+    void begin( const int64_t timestamp );
+
+    // Set Raw Joints of Tracked Body ( states are TrackingState )
+    void setJoints( const uint64_t trackingId, const float positions[][3], const uint8_t* states );
+
+    // Update Filters of Bodies Set in This Frame
+    void update();
+
+    // Retrieve Filtered Joint ( return false if body has no filter )
+    bool getFilteredJoint( const uint64_t trackingId, const int joint, float position[3] ) const;
+
+    // Retrieve Number of Assigned Filters
+    int getCount() const;
+
+private:
+    // Find Slot of TrackingId ( -1 if not assigned )
+    int find( const uint64_t trackingId ) const;
+
+    // Assign Slot to TrackingId ( free slot, or least recently seen slot if all slots are assigned )
+    int assign( const uint64_t trackingId );
+};
+
+#endif // __JOINT_FILTER_MANAGER__
\ No newline at end of file
@@ -0,0 +1,230 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <random>
+#include <cmath>
+#include <algorithm>
+
+#include "JointFilterBank.h"
+#include "SkeletonStream.h"
+
+// Reference Holt Filter
+// Same algorithm as Sample::FilterDoubleExponential ( KinectJointFilter.cpp ) for one joint, with plain floats instead of DirectXMath.
+class ReferenceHoltFilter
+{
+private:
+    float rawPosition[3];
+    float filteredPosition[3];
+    float trend[3];
+    int frameCount;
+
+public:
+    // Constructor
+    ReferenceHoltFilter()
+    {
+        reset();
+    }
+
+    // Reset Filter
+    void reset()
+    {
+        std::fill( rawPosition, rawPosition + 3, 0.0f );
+        std::fill( filteredPosition, filteredPosition + 3, 0.0f );
+        std::fill( trend, trend + 3, 0.0f );
+        frameCount = 0;
+    }
+
+    // Update Filter ( state is TrackingState )
+    void update( const float raw[3], const uint8_t state, const HoltFilter::Parameters& parameters, float output[3] )
+    {
+        // If inferred, we smooth a bit more by using a bigger jitter radius
+        float jitterRadius = std::max( 0.0001f, parameters.jitterRadius );
+        float maxDeviationRadius = parameters.maxDeviationRadius;
+        if( state == 1 ){
+            jitterRadius *= 2.0f;
+            maxDeviationRadius *= 2.0f;
+        }
+
+        // If joint is invalid, reset the filter
+        if( raw[0] == 0.0f && raw[1] == 0.0f && raw[2] == 0.0f ){
+            frameCount = 0;
+        }
+
+        float filtered[3], currentTrend[3];
+        if( frameCount == 0 ){
+            // Initial start values
+            for( int axis = 0; axis < 3; axis++ ){
+                filtered[axis] = raw[axis];
+                currentTrend[axis] = 0.0f;
+            }
+            frameCount++;
+        }
+        else if( frameCount == 1 ){
+            for( int axis = 0; axis < 3; axis++ ){
+                filtered[axis] = ( raw[axis] + rawPosition[axis] ) * 0.5f;
+                currentTrend[axis] = ( filtered[axis] - filteredPosition[axis] ) * parameters.correction + trend[axis] * ( 1.0f - parameters.correction );
+            }
+            frameCount++;
+        }
+        else{
+            // First apply jitter filter
+            const float difference = length( raw, filteredPosition );
+            for( int axis = 0; axis < 3; axis++ ){
+                filtered[axis] = ( difference <= jitterRadius ) ? raw[axis] * ( difference / jitterRadius ) + filteredPosition[axis] * ( 1.0f - difference / jitterRadius ) : raw[axis];
+            }
+
+            // Now the double exponential smoothing filter
+            for( int axis = 0; axis < 3; axis++ ){
+                filtered[axis] = filtered[axis] * ( 1.0f - parameters.smoothing ) + ( filteredPosition[axis] + trend[axis] ) * parameters.smoothing;
+                currentTrend[axis] = ( filtered[axis] - filteredPosition[axis] ) * parameters.correction + trend[axis] * ( 1.0f - parameters.correction );
+            }
+        }
+
+        // Predict into the future to reduce latency
+        for( int axis = 0; axis < 3; axis++ ){
+            output[axis] = filtered[axis] + currentTrend[axis] * parameters.prediction;
+        }
+
+        // Check that we are not too far away from raw data
+        const float deviation = length( output, raw );
+        if( deviation > maxDeviationRadius ){
+            for( int axis = 0; axis < 3; axis++ ){
+                output[axis] = output[axis] * ( maxDeviationRadius / deviation ) + raw[axis] * ( 1.0f - maxDeviationRadius / deviation );
+            }
+        }
+
+        // Save the data from this frame
+        std::copy( raw, raw + 3, rawPosition );
+        std::copy( filtered, filtered + 3, filteredPosition );
+        std::copy( currentTrend, currentTrend + 3, trend );
+    }
+
+private:
+    // Distance between Positions
+    static float length( const float a[3], const float b[3] )
+    {
+        return std::sqrt( ( a[0] - b[0] ) * ( a[0] - b[0] ) + ( a[1] - b[1] ) * ( a[1] - b[1] ) + ( a[2] - b[2] ) * ( a[2] - b[2] ) );
+    }
+};
+
+// Synthesize Frame
+// Bodies walk randomly with jitter, joints are sometimes inferred, and bodies are sometimes lost for a while.
+static void synthesize( std::mt19937& random, SkeletonFrame& frame )
+{
+    std::normal_distribution<float> step( 0.0f, 0.01f );
+    std::normal_distribution<float> jitter( 0.0f, 0.005f );
+    std::uniform_real_distribution<float> chance( 0.0f, 1.0f );
+
+    frame.timestamp += 333333;
+    for( int index = 0; index < SkeletonFrame::BODIES; index++ ){
+        SkeletonFrame::Body& body = frame.bodies[index];
+        if( !body.tracked ){
+            if( chance( random ) < 0.1f ){
+                body.tracked = 1;
+                body.trackingId = frame.timestamp + index;
+                for( int joint = 0; joint < SkeletonFrame::JOINTS; joint++ ){
+                    body.positions[joint][0] = ( index - 2.5f ) * 0.5f;
+                    body.positions[joint][1] = ( joint - 12.0f ) * 0.05f;
+                    body.positions[joint][2] = 2.5f;
+                }
+            }
+            continue;
+        }
+        if( chance( random ) < 0.01f ){
+            body.tracked = 0;
+            continue;
+        }
+
+        // Move Body, and Add Jitter to Joints
+        const float move[3] = { step( random ), step( random ), step( random ) };
+        for( int joint = 0; joint < SkeletonFrame::JOINTS; joint++ ){
+            const float roll = chance( random );
+            body.states[joint] = ( roll < 0.1f ) ? 1 : 2;
+            for( int axis = 0; axis < 3; axis++ ){
+                body.positions[joint][axis] += move[axis] + jitter( random ) * body.states[joint];
+            }
+        }
+    }
+}
+
+// Update Both Filters by Frame, and Return Max Difference of Filtered Joints [m]
+// Untracked bodies and lost joints are given as ( 0, 0, 0 ), that resets both filters.
+static float verify( const SkeletonFrame& frame, std::mt19937& random, JointFilterBank<HoltFilter>& bank, std::vector<ReferenceHoltFilter>& filters )
+{
+    std::uniform_real_distribution<float> chance( 0.0f, 1.0f );
+
+    float positions[SkeletonFrame::BODIES][SkeletonFrame::JOINTS][3];
+    for( int index = 0; index < SkeletonFrame::BODIES; index++ ){
+        const SkeletonFrame::Body& body = frame.bodies[index];
+        for( int joint = 0; joint < SkeletonFrame::JOINTS; joint++ ){
+            const bool lost = !body.tracked || chance( random ) < 0.02f;
+            for( int axis = 0; axis < 3; axis++ ){
+                positions[index][joint][axis] = lost ? 0.0f : body.positions[joint][axis];
+            }
+        }
+        bank.setJoints( index, positions[index], body.states );
+    }
+    bank.update();
+
+    float difference = 0.0f;
+    for( int index = 0; index < SkeletonFrame::BODIES; index++ ){
+        for( int joint = 0; joint < SkeletonFrame::JOINTS; joint++ ){
+            float expected[3], filtered[3];
+            filters[index * SkeletonFrame::JOINTS + joint].update( positions[index][joint], frame.bodies[index].states[joint], HoltFilter::Parameters(), expected );
+            bank.getFilteredJoint( index, joint, filtered );
+            for( int axis = 0; axis < 3; axis++ ){
+                difference = std::max( difference, std::fabs( expected[axis] - filtered[axis] ) );
+            }
+        }
+    }
+
+    return difference;
+}
+
+// Joint Filter Verify
+// Holt filter bank ( JointFilterBank<HoltFilter> ) is compared with reference filter on synthesized frames, or on recorded skeleton file if specified.
+// This program has no dependency on Kinect SDK and OpenCV, and returns non-zero if filtered joints differ more than tolerance.
+int main( int argc, char* argv[] )
+{
+    // Tolerance [m] ( 0.01 [mm], rounding of vector units and flushed denormals )
+    const float TOLERANCE = 0.00001f;
+
+    try{
+        std::mt19937 random( 0 );
+        JointFilterBank<HoltFilter> bank;
+        bank.initialize( HoltFilter::Parameters() );
+        std::vector<ReferenceHoltFilter> filters( SkeletonFrame::BODIES * SkeletonFrame::JOINTS );
+
+        SkeletonFrame frame = {};
+        float difference = 0.0f;
+        int frames = 0;
+        if( argc > 1 ){
+            // Recorded Skeleton File
+            SkeletonReplayer replayer;
+            if( !replayer.open( argv[1] ) ){
+                throw std::runtime_error( "failed SkeletonReplayer::open( " + std::string( argv[1] ) + " )" );
+            }
+            replayer.setRealtime( false );
+            while( replayer.read( frame ) ){
+                difference = std::max( difference, verify( frame, random, bank, filters ) );
+                frames++;
+            }
+        }
+        else{
+            // Synthesized Frames
+            for( int index = 0; index < 3000; index++ ){
+                synthesize( random, frame );
+                difference = std::max( difference, verify( frame, random, bank, filters ) );
+                frames++;
+            }
+        }
+
+        std::cout << "Filter Bank Max Difference : " << difference << " [m] ( " << frames << " frames )" << std::endl;
+        return ( difference <= TOLERANCE ) ? 0 : 1;
+    } catch( std::exception& ex ){
+        std::cout << ex.what() << std::endl;
+    }
+
+    return 1;
+}
\ No newline at end of file
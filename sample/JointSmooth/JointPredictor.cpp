@@ -0,0 +1,192 @@
+#include "JointPredictor.h"
+
+#include <chrono>
+#include <algorithm>
+
+// Constructor
+JointPredictor::JointPredictor( const int capacity, const int64_t timeout, const int64_t horizon )
+    : slots( capacity ),
+      timestamp( 0 ),
+      timeout( timeout ),
+      horizon( horizon ),
+      smoothing( 0.5f ),
+      offset( 0 ),
+      latency( 0 ),
+      displayOffset( 0 ),
+      synchronized( false )
+{
+    // Initialize
+    initialize();
+}
+
+// Initialize Parameters and Release All Bodies
+void JointPredictor::initialize( const float smoothing )
+{
+    this->smoothing = smoothing;
+
+    for( Slot& slot : slots ){
+        slot.trackingId = 0;
+        slot.count = 0;
+        slot.timestamps[0] = 0;
+        slot.timestamps[1] = 0;
+    }
+}
+
+// Begin Body Frame
+void JointPredictor::begin( const int64_t timestamp )
+{
+    this->timestamp = timestamp;
+
+    // Release Lost Bodies ( and all bodies if timestamp goes backwards, samples of them would be ignored )
+    for( Slot& slot : slots ){
+        if( slot.trackingId != 0 && ( timestamp - slot.timestamps[0] > timeout || timestamp < slot.timestamps[0] ) ){
+            slot.trackingId = 0;
+            slot.count = 0;
+        }
+    }
+}
+
+// Set Joints of Tracked Body
+void JointPredictor::setJoints( const uint64_t trackingId, const float positions[][3] )
+{
+    int index = find( trackingId );
+    if( index == -1 ){
+        index = assign( trackingId );
+    }
+    Slot& slot = slots[index];
+
+    // Ignore Same Body Frame
+    if( slot.count > 0 && timestamp <= slot.timestamps[0] ){
+        return;
+    }
+
+    // Restart after Gap ( velocity over long gap is not reliable )
+    if( slot.count > 0 && timestamp - slot.timestamps[0] > horizon * 2 ){
+        slot.count = 0;
+    }
+
+    // Shift Latest Body Frame to Previous
+    slot.timestamps[1] = slot.timestamps[0];
+    std::copy( &slot.positions[0][0][0], &slot.positions[0][0][0] + JOINTS * 3, &slot.positions[1][0][0] );
+    slot.timestamps[0] = timestamp;
+    std::copy( &positions[0][0], &positions[0][0] + JOINTS * 3, &slot.positions[0][0][0] );
+
+    // Update Velocity ( zero at initial start )
+    if( slot.count == 0 ){
+        std::fill( &slot.velocities[0][0], &slot.velocities[0][0] + JOINTS * 3, 0.0f );
+    }
+    else{
+        const float inverseTime = 10000000.0f / static_cast<float>( slot.timestamps[0] - slot.timestamps[1] );
+        for( int joint = 0; joint < JOINTS; joint++ ){
+            for( int axis = 0; axis < 3; axis++ ){
+                const float velocity = ( slot.positions[0][joint][axis] - slot.positions[1][joint][axis] ) * inverseTime;
+                slot.velocities[joint][axis] += ( velocity - slot.velocities[joint][axis] ) * smoothing;
+            }
+        }
+    }
+
+    slot.count = std::min( slot.count + 1, 2 );
+}
+
+// Predict Joints at Time
+bool JointPredictor::predict( const uint64_t trackingId, const int64_t time, float positions[][3] ) const
+{
+    const int index = find( trackingId );
+    if( index == -1 || slots[index].count == 0 ){
+        return false;
+    }
+    const Slot& slot = slots[index];
+
+    // Interpolate between Previous and Latest Body Frames
+    if( slot.count > 1 && time < slot.timestamps[0] ){
+        const float ratio = std::max( 0.0f, static_cast<float>( time - slot.timestamps[1] ) / static_cast<float>( slot.timestamps[0] - slot.timestamps[1] ) );
+        for( int joint = 0; joint < JOINTS; joint++ ){
+            for( int axis = 0; axis < 3; axis++ ){
+                positions[joint][axis] = slot.positions[1][joint][axis] + ( slot.positions[0][joint][axis] - slot.positions[1][joint][axis] ) * ratio;
+            }
+        }
+        return true;
+    }
+
+    // Extrapolate from Latest Body Frame ( limited to horizon )
+    const float elapsed = static_cast<float>( std::min( time - slot.timestamps[0], horizon ) ) / 10000000.0f;
+    for( int joint = 0; joint < JOINTS; joint++ ){
+        for( int axis = 0; axis < 3; axis++ ){
+            positions[joint][axis] = slot.positions[0][joint][axis] + slot.velocities[joint][axis] * elapsed;
+        }
+    }
+    return true;
+}
+
+// Synchronize Clock by Arrival of Body Frame
+// Body frame arrives after its RelativeTime, so minimum of arrival offset is closest to offset of clocks.
+// Minimum rises slowly ( 1 [ms/s] at 30 [fps] ) to follow drift of clocks, and restarts if timestamp goes backwards.
+void JointPredictor::synchronize( const int64_t timestamp, const int64_t local )
+{
+    const int64_t arrival = local - timestamp;
+    if( !synchronized || timestamp < this->timestamp ){
+        offset = arrival;
+        synchronized = true;
+        return;
+    }
+
+    offset = std::min( offset + 333, arrival );
+}
+
+// Measure Drawing Latency
+// Latency is smoothed by exponential moving average ( 1/8 of new latency ).
+void JointPredictor::measureLatency( const int64_t latency )
+{
+    this->latency += ( latency - this->latency ) / 8;
+}
+
+// Retrieve Presentation Time of Image Drawn at Local Time
+int64_t JointPredictor::getPresentationTime( const int64_t local ) const
+{
+    return local - offset + latency + displayOffset;
+}
+
+// Retrieve Local Time
+int64_t JointPredictor::getLocalTime()
+{
+    typedef std::chrono::duration<int64_t, std::ratio<1, 10000000>> Duration;
+    return std::chrono::duration_cast<Duration>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+// Find Slot of TrackingId
+int JointPredictor::find( const uint64_t trackingId ) const
+{
+    if( trackingId == 0 ){
+        return -1;
+    }
+
+    for( int index = 0; index < static_cast<int>( slots.size() ); index++ ){
+        if( slots[index].trackingId == trackingId ){
+            return index;
+        }
+    }
+
+    return -1;
+}
+
+// Assign Slot to TrackingId
+int JointPredictor::assign( const uint64_t trackingId )
+{
+    // Free Slot, otherwise Least Recently Seen Slot
+    int index = 0;
+    for( int candidate = 0; candidate < static_cast<int>( slots.size() ); candidate++ ){
+        if( slots[candidate].trackingId == 0 ){
+            index = candidate;
+            break;
+        }
+        if( slots[candidate].timestamps[0] < slots[index].timestamps[0] ){
+            index = candidate;
+        }
+    }
+
+    // Start New Body
+    slots[index].trackingId = trackingId;
+    slots[index].count = 0;
+
+    return index;
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+#ifndef __JOINT_PREDICTOR__
+#define __JOINT_PREDICTOR__
+
+#include <vector>
+#include <cstdint>
+
+// Joint Predictor
+// Joints are predicted at arbitrary time from body frames with RelativeTime, instead of fixed number of frames at 30 [fps].
+// Query time before latest body frame is interpolated between last two body frames, after that it is extrapolated by velocity.
+// Presentation time is estimated by offset between local clock and RelativeTime, measured drawing latency and display offset.
+// Drawing latency is measured on CPU ( lower bound of display latency ), and display offset adds the rest ( e.g. scan-out of display ).
+// RelativeTime going backwards ( e.g. replay is rewound ) releases all bodies and restarts synchronization of clocks.
+// So that rendering faster than body frames ( 60 [fps] or more ) shows skeleton where the person will be when the image is presented.
+// This class has no dependency on Kinect SDK.
+class JointPredictor
+{
+public:
+    // Number of Bodies and Joints ( same as BODY_COUNT and JointType_Count )
+    static const int BODIES = 6;
+    static const int JOINTS = 25;
+
+private:
+    // Predictor Slot
+    struct Slot
+    {
+        uint64_t trackingId;             // 0 if free
+        int count;                       // Number of body frames ( up to 2 )
+        int64_t timestamps[2];           // Timestamps of latest and previous body frames ( 100 [ns] unit, same as TIMESPAN )
+        float positions[2][JOINTS][3];   // Positions of latest and previous body frames
+        float velocities[JOINTS][3];     // Smoothed velocities [m/s]
+    };
+
+    std::vector<Slot> slots;
+    int64_t timestamp;
+    int64_t timeout;
+    int64_t horizon;
+    float smoothing;
+
+    // Clock ( offset from RelativeTime to local clock, and display latency )
+    int64_t offset;
+    int64_t latency;
+    int64_t displayOffset;
+    bool synchronized;
+
+public:
+    // Constructor ( timeout to release lost body is 1 [s], extrapolation is limited to 100 [ms] )
+    JointPredictor( const int capacity = BODIES * 2, const int64_t timeout = 10000000, const int64_t horizon = 1000000 );
+
+    // Initialize Parameters and Release All Bodies ( smoothing of velocity is [0..1], higher values follow raw velocity faster )
+    void initialize( const float smoothing = 0.5f );
+
+    // Begin Body Frame ( release bodies lost longer than timeout, or all bodies if timestamp goes backwards )
+    void begin( const int64_t timestamp );
+
+    // Set Joints of Tracked Body ( raw or filtered positions )
+    void setJoints( const uint64_t trackingId, const float positions[][3] );
+
+    // Predict Joints at Time ( return false if body is not known )
+    bool predict( const uint64_t trackingId, const int64_t time, float positions[][3] ) const;
+
+    // Synchronize Clock by Arrival of Body Frame ( local time is retrieved by getLocalTime() )
+    void synchronize( const int64_t timestamp, const int64_t local );
+
+    // Measure Drawing Latency ( from start of drawing to return of show in local clock, lower bound of display latency )
+    void measureLatency( const int64_t latency );
+
+    // Set Display Offset ( latency after show that can not be measured on CPU, 100 [ns] unit )
+    void setDisplayOffset( const int64_t displayOffset )
+    {
+        this->displayOffset = displayOffset;
+    }
+
+    // Retrieve Presentation Time of Image Drawn at Local Time ( in RelativeTime )
+    int64_t getPresentationTime( const int64_t local ) const;
+
+    // Retrieve Display Latency ( measured drawing latency and display offset )
+    int64_t getLatency() const
+    {
+        return latency + displayOffset;
+    }
+
+    // Retrieve Local Time ( steady clock in 100 [ns] unit )
+    static int64_t getLocalTime();
+
+private:
+    // Find Slot of TrackingId ( -1 if not assigned )
+    int find( const uint64_t trackingId ) const;
+
+    // Assign Slot to TrackingId ( free slot, or least recently seen slot if all slots are assigned )
+    int assign( const uint64_t trackingId );
+};
+
+#endif // __JOINT_PREDICTOR__
\ No newline at end of file
@@ -0,0 +1,93 @@
+#ifndef __JOINT_VECTOR__
+#define __JOINT_VECTOR__
+
+#include <cmath>
+#include <algorithm>
+
+#if defined( __AVX2__ )
+#include <immintrin.h>
+#elif defined( _M_X64 ) || defined( __SSE2__ )
+#include <emmintrin.h>
+#endif
+
+// Vector Traits
+// Operations on lanes of joints for filter kernels ( AVXVector, SSEVector, or ScalarVector if neither is available ).
+
+// Scalar Vector ( 1 lane, fallback )
+struct ScalarVector
+{
+    typedef float Type;
+    typedef bool Mask;
+    static const int WIDTH = 1;
+
+    static Type load( const float* pointer ){ return *pointer; }
+    static void store( float* pointer, const Type value ){ *pointer = value; }
+    static Type set( const float value ){ return value; }
+    static Type add( const Type a, const Type b ){ return a + b; }
+    static Type sub( const Type a, const Type b ){ return a - b; }
+    static Type mul( const Type a, const Type b ){ return a * b; }
+    static Type div( const Type a, const Type b ){ return a / b; }
+    static Type min( const Type a, const Type b ){ return std::min( a, b ); }
+    static Type max( const Type a, const Type b ){ return std::max( a, b ); }
+    static Type sqrt( const Type a ){ return std::sqrt( a ); }
+    static Mask notEqual( const Type a, const Type b ){ return a != b; }
+    static Mask less( const Type a, const Type b ){ return a < b; }
+    static Mask lessEqual( const Type a, const Type b ){ return a <= b; }
+    static Mask greater( const Type a, const Type b ){ return a > b; }
+    static Mask bitOr( const Mask a, const Mask b ){ return a || b; }
+    static Type select( const Mask mask, const Type a, const Type b ){ return mask ? a : b; }
+};
+
+#if defined( __AVX2__ )
+// AVX2 Vector ( 8 lanes )
+struct AVXVector
+{
+    typedef __m256 Type;
+    typedef __m256 Mask;
+    static const int WIDTH = 8;
+
+    static Type load( const float* pointer ){ return _mm256_loadu_ps( pointer ); }
+    static void store( float* pointer, const Type value ){ _mm256_storeu_ps( pointer, value ); }
+    static Type set( const float value ){ return _mm256_set1_ps( value ); }
+    static Type add( const Type a, const Type b ){ return _mm256_add_ps( a, b ); }
+    static Type sub( const Type a, const Type b ){ return _mm256_sub_ps( a, b ); }
+    static Type mul( const Type a, const Type b ){ return _mm256_mul_ps( a, b ); }
+    static Type div( const Type a, const Type b ){ return _mm256_div_ps( a, b ); }
+    static Type min( const Type a, const Type b ){ return _mm256_min_ps( a, b ); }
+    static Type max( const Type a, const Type b ){ return _mm256_max_ps( a, b ); }
+    static Type sqrt( const Type a ){ return _mm256_sqrt_ps( a ); }
+    static Mask notEqual( const Type a, const Type b ){ return _mm256_cmp_ps( a, b, _CMP_NEQ_UQ ); }
+    static Mask less( const Type a, const Type b ){ return _mm256_cmp_ps( a, b, _CMP_LT_OQ ); }
+    static Mask lessEqual( const Type a, const Type b ){ return _mm256_cmp_ps( a, b, _CMP_LE_OQ ); }
+    static Mask greater( const Type a, const Type b ){ return _mm256_cmp_ps( a, b, _CMP_GT_OQ ); }
+    static Mask bitOr( const Mask a, const Mask b ){ return _mm256_or_ps( a, b ); }
+    static Type select( const Mask mask, const Type a, const Type b ){ return _mm256_blendv_ps( b, a, mask ); }
+};
+#elif defined( _M_X64 ) || defined( __SSE2__ )
+// SSE2 Vector ( 4 lanes, blend by bitwise operations )
+struct SSEVector
+{
+    typedef __m128 Type;
+    typedef __m128 Mask;
+    static const int WIDTH = 4;
+
+    static Type load( const float* pointer ){ return _mm_loadu_ps( pointer ); }
+    static void store( float* pointer, const Type value ){ _mm_storeu_ps( pointer, value ); }
+    static Type set( const float value ){ return _mm_set1_ps( value ); }
+    static Type add( const Type a, const Type b ){ return _mm_add_ps( a, b ); }
+    static Type sub( const Type a, const Type b ){ return _mm_sub_ps( a, b ); }
+    static Type mul( const Type a, const Type b ){ return _mm_mul_ps( a, b ); }
+    static Type div( const Type a, const Type b ){ return _mm_div_ps( a, b ); }
+    static Type min( const Type a, const Type b ){ return _mm_min_ps( a, b ); }
+    static Type max( const Type a, const Type b ){ return _mm_max_ps( a, b ); }
+    static Type sqrt( const Type a ){ return _mm_sqrt_ps( a ); }
+    static Mask notEqual( const Type a, const Type b ){ return _mm_cmpneq_ps( a, b ); }
+    static Mask less( const Type a, const Type b ){ return _mm_cmplt_ps( a, b ); }
+    static Mask lessEqual( const Type a, const Type b ){ return _mm_cmple_ps( a, b ); }
+    static Mask greater( const Type a, const Type b ){ return _mm_cmpgt_ps( a, b ); }
+    static Mask bitOr( const Mask a, const Mask b ){ return _mm_or_ps( a, b ); }
+    static Type select( const Mask mask, const Type a, const Type b ){ return _mm_or_ps( _mm_and_ps( mask, a ), _mm_andnot_ps( mask, b ) ); }
+};
+#endif
+
+#endif // __JOINT_VECTOR__
\ No newline at end of file
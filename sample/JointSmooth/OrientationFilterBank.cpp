@@ -0,0 +1,272 @@
+#include "OrientationFilterBank.h"
+#include "JointVector.h"
+
+#include <cmath>
+#include <algorithm>
+#include <initializer_list>
+
+// Quaternion of Lanes
+template<typename Vector>
+struct QuaternionLanes
+{
+    typedef typename Vector::Type Type;
+    typedef typename Vector::Mask Mask;
+
+    Type x, y, z, w;
+
+    // Multiply ( a * b )
+    static QuaternionLanes multiply( const QuaternionLanes& a, const QuaternionLanes& b )
+    {
+        QuaternionLanes q;
+        q.x = Vector::add( Vector::sub( Vector::add( Vector::mul( a.w, b.x ), Vector::mul( a.x, b.w ) ), Vector::mul( a.z, b.y ) ), Vector::mul( a.y, b.z ) );
+        q.y = Vector::add( Vector::sub( Vector::add( Vector::mul( a.w, b.y ), Vector::mul( a.y, b.w ) ), Vector::mul( a.x, b.z ) ), Vector::mul( a.z, b.x ) );
+        q.z = Vector::add( Vector::sub( Vector::add( Vector::mul( a.w, b.z ), Vector::mul( a.z, b.w ) ), Vector::mul( a.y, b.x ) ), Vector::mul( a.x, b.y ) );
+        q.w = Vector::sub( Vector::sub( Vector::sub( Vector::mul( a.w, b.w ), Vector::mul( a.x, b.x ) ), Vector::mul( a.y, b.y ) ), Vector::mul( a.z, b.z ) );
+        return q;
+    }
+
+    // Conjugate ( inverse of unit quaternion )
+    static QuaternionLanes conjugate( const QuaternionLanes& a )
+    {
+        const Type zero = Vector::set( 0.0f );
+        QuaternionLanes q = { Vector::sub( zero, a.x ), Vector::sub( zero, a.y ), Vector::sub( zero, a.z ), a.w };
+        return q;
+    }
+
+    // Dot Product
+    static Type dot( const QuaternionLanes& a, const QuaternionLanes& b )
+    {
+        return Vector::add( Vector::add( Vector::mul( a.x, b.x ), Vector::mul( a.y, b.y ) ), Vector::add( Vector::mul( a.z, b.z ), Vector::mul( a.w, b.w ) ) );
+    }
+
+    // Normalize
+    static QuaternionLanes normalize( const QuaternionLanes& a )
+    {
+        const Type scale = Vector::div( Vector::set( 1.0f ), Vector::sqrt( Vector::max( dot( a, a ), Vector::set( 1e-12f ) ) ) );
+        QuaternionLanes q = { Vector::mul( a.x, scale ), Vector::mul( a.y, scale ), Vector::mul( a.z, scale ), Vector::mul( a.w, scale ) };
+        return q;
+    }
+
+    // Log Map ( unit quaternion to rotation vector, q and -q are same rotation )
+    // Angle is atan2( |v|, |w| ) in [0..pi/2], computed by polynomial of atan in [0..1] ( error is less than 1e-5 [rad] ).
+    static void log( const QuaternionLanes& a, Type& x, Type& y, Type& z )
+    {
+        const Type zero = Vector::set( 0.0f );
+        const Mask negative = Vector::less( a.w, zero );
+        const Type sign = Vector::select( negative, Vector::set( -1.0f ), Vector::set( 1.0f ) );
+        const Type w = Vector::mul( a.w, sign );
+        const Type length = Vector::sqrt( Vector::add( Vector::add( Vector::mul( a.x, a.x ), Vector::mul( a.y, a.y ) ), Vector::mul( a.z, a.z ) ) );
+
+        // atan2( length, w ) by range reduction to [0..1]
+        const Mask swap = Vector::greater( length, w );
+        const Type ratio = Vector::div( Vector::select( swap, w, length ), Vector::max( Vector::select( swap, length, w ), Vector::set( 1e-12f ) ) );
+        const Type ratio2 = Vector::mul( ratio, ratio );
+        Type polynomial = Vector::set( -0.01172120f );
+        for( const float coefficient : { 0.05265332f, -0.11643287f, 0.19354346f, -0.33262347f, 0.99997726f } ){
+            polynomial = Vector::add( Vector::mul( polynomial, ratio2 ), Vector::set( coefficient ) );
+        }
+        const Type atan = Vector::mul( polynomial, ratio );
+        const Type angle = Vector::select( swap, Vector::sub( Vector::set( 1.57079633f ), atan ), atan );
+
+        // Rotation vector is axis * 2 * angle ( 2 / w near identity )
+        const Mask small = Vector::lessEqual( length, Vector::set( 1e-6f ) );
+        const Type scale = Vector::mul( sign, Vector::select( small, Vector::set( 2.0f ), Vector::div( Vector::add( angle, angle ), Vector::max( length, Vector::set( 1e-6f ) ) ) ) );
+        x = Vector::mul( a.x, scale );
+        y = Vector::mul( a.y, scale );
+        z = Vector::mul( a.z, scale );
+    }
+
+    // Exp Map ( rotation vector to unit quaternion, rotation angle is limited to pi )
+    // Sin and cos of half angle in [0..pi/2] are computed by Taylor series ( error is less than 1e-8 ).
+    static QuaternionLanes exp( const Type x, const Type y, const Type z )
+    {
+        const Type quarter = Vector::set( 1.57079633f );
+        const Type half = Vector::mul( Vector::sqrt( Vector::add( Vector::add( Vector::mul( x, x ), Vector::mul( y, y ) ), Vector::mul( z, z ) ) ), Vector::set( 0.5f ) );
+        const Mask limited = Vector::greater( half, quarter );
+        const Type angle = Vector::min( half, quarter );
+        const Type angle2 = Vector::mul( angle, angle );
+
+        // sin( angle ) / angle and cos( angle )
+        Type sinc = Vector::set( 1.0f / 6227020800.0f );
+        for( const float coefficient : { -1.0f / 39916800.0f, 1.0f / 362880.0f, -1.0f / 5040.0f, 1.0f / 120.0f, -1.0f / 6.0f, 1.0f } ){
+            sinc = Vector::add( Vector::mul( sinc, angle2 ), Vector::set( coefficient ) );
+        }
+        Type cos = Vector::set( 1.0f / 479001600.0f );
+        for( const float coefficient : { -1.0f / 3628800.0f, 1.0f / 40320.0f, -1.0f / 720.0f, 1.0f / 24.0f, -1.0f / 2.0f, 1.0f } ){
+            cos = Vector::add( Vector::mul( cos, angle2 ), Vector::set( coefficient ) );
+        }
+
+        // Vector part is axis * sin( angle ) = rotation vector * sinc( angle ) / 2 ( scaled down if angle is limited )
+        const Type scale = Vector::mul( Vector::mul( sinc, Vector::set( 0.5f ) ), Vector::select( limited, Vector::div( angle, half ), Vector::set( 1.0f ) ) );
+        QuaternionLanes q = { Vector::mul( x, scale ), Vector::mul( y, scale ), Vector::mul( z, scale ), cos };
+        return q;
+    }
+};
+
+// Constructor
+OrientationFilterBank::OrientationFilterBank( const int bodies )
+    : bodies( bodies ),
+      lanes( bodies * STRIDE )
+{
+    // Allocate All Arrays in One Storage ( aligned to cache line )
+    const int arrays = 16;
+    const int alignment = 64 / sizeof( float );
+    storage.assign( arrays * lanes + alignment, 0.0f );
+    float* pointer = &storage[0];
+    pointer += ( alignment - ( reinterpret_cast<uintptr_t>( pointer ) / sizeof( float ) ) % alignment ) % alignment;
+    float** destinations[arrays] = { &inputX, &inputY, &inputZ, &inputW, &filteredX, &filteredY, &filteredZ, &filteredW, &trendX, &trendY, &trendZ, &frameCount, &outputX, &outputY, &outputZ, &outputW };
+    for( int index = 0; index < arrays; index++ ){
+        *destinations[index] = pointer + index * lanes;
+    }
+
+    // Indices of All Bodies
+    indices.resize( bodies );
+    for( int body = 0; body < bodies; body++ ){
+        indices[body] = body;
+    }
+
+    // Initialize
+    initialize();
+}
+
+// Initialize Parameters and Reset All Filters
+void OrientationFilterBank::initialize( const Parameters& parameters )
+{
+    this->parameters = parameters;
+
+    for( float* array : { filteredX, filteredY, filteredZ, filteredW, trendX, trendY, trendZ, frameCount, outputX, outputY, outputZ, outputW } ){
+        std::fill( array, array + lanes, 0.0f );
+    }
+}
+
+// Reset Filters of Body
+void OrientationFilterBank::reset( const int body )
+{
+    const int begin = body * STRIDE;
+    std::fill( frameCount + begin, frameCount + begin + JOINTS, 0.0f );
+}
+
+// Set Raw Orientations of Body
+void OrientationFilterBank::setOrientations( const int body, const float orientations[][4] )
+{
+    const int begin = body * STRIDE;
+    for( int joint = 0; joint < JOINTS; joint++ ){
+        inputX[begin + joint] = orientations[joint][0];
+        inputY[begin + joint] = orientations[joint][1];
+        inputZ[begin + joint] = orientations[joint][2];
+        inputW[begin + joint] = orientations[joint][3];
+    }
+}
+
+// Clear Raw Orientations of Body
+void OrientationFilterBank::clearOrientations( const int body )
+{
+    const int begin = body * STRIDE;
+    for( float* array : { inputX, inputY, inputZ, inputW } ){
+        std::fill( array + begin, array + begin + JOINTS, 0.0f );
+    }
+}
+
+// Update All Filters
+void OrientationFilterBank::update()
+{
+    update( &indices[0], bodies );
+}
+
+// Update Filters of Bodies
+void OrientationFilterBank::update( const int* indices, const int count )
+{
+    #pragma omp parallel for if( count > 1 )
+    for( int index = 0; index < count; index++ ){
+        // Lanes are padded to multiple of 8, so there are no remaining lanes
+        const int begin = indices[index] * STRIDE;
+#if defined( __AVX2__ ) || defined( _M_X64 ) || defined( __SSE2__ )
+        // Trends of still joints decay into denormals that stall vector units, so flush them to zero while updating ( per thread )
+        const unsigned int csr = _mm_getcsr();
+        _mm_setcsr( csr | 0x8040 ); // Flush to Zero and Denormals are Zero
+#if defined( __AVX2__ )
+        updateLanes<AVXVector>( begin, begin + STRIDE );
+#else
+        updateLanes<SSEVector>( begin, begin + STRIDE );
+#endif
+        _mm_setcsr( csr );
+#else
+        updateLanes<ScalarVector>( begin, begin + STRIDE );
+#endif
+    }
+}
+
+// Update Lanes
+// Holt double exponential smoothing in tangent space of predicted orientation ( every case is computed, and selected by masks ).
+template<typename Vector>
+void OrientationFilterBank::updateLanes( const int begin, const int end )
+{
+    typedef typename Vector::Type Type;
+    typedef typename Vector::Mask Mask;
+    typedef QuaternionLanes<Vector> Quaternion;
+
+    const Type zero = Vector::set( 0.0f );
+    const Type one = Vector::set( 1.0f );
+    const Type blend = Vector::set( 1.0f - parameters.smoothing );
+    const Type correction = Vector::set( parameters.correction );
+    const Type inverseCorrection = Vector::set( 1.0f - parameters.correction );
+    const Type prediction = Vector::set( parameters.prediction );
+
+    for( int lane = begin; lane < end; lane += Vector::WIDTH ){
+        Quaternion raw = { Vector::load( &inputX[lane] ), Vector::load( &inputY[lane] ), Vector::load( &inputZ[lane] ), Vector::load( &inputW[lane] ) };
+        const Quaternion previous = { Vector::load( &filteredX[lane] ), Vector::load( &filteredY[lane] ), Vector::load( &filteredZ[lane] ), Vector::load( &filteredW[lane] ) };
+        const Type previousTrendX = Vector::load( &trendX[lane] );
+        const Type previousTrendY = Vector::load( &trendY[lane] );
+        const Type previousTrendZ = Vector::load( &trendZ[lane] );
+
+        // If orientation is invalid ( 0, 0, 0, 0 ), reset the filter
+        const Mask valid = Vector::greater( Quaternion::dot( raw, raw ), Vector::set( 0.5f ) );
+        const Type count = Vector::select( valid, Vector::load( &frameCount[lane] ), zero );
+        const Mask first = Vector::lessEqual( count, zero );
+        raw = Quaternion::normalize( raw );
+
+        // Predict by trend, and flip raw orientation into same hemisphere as predicted orientation
+        const Quaternion predicted = Quaternion::multiply( previous, Quaternion::exp( previousTrendX, previousTrendY, previousTrendZ ) );
+        const Type sign = Vector::select( Vector::less( Quaternion::dot( raw, predicted ), zero ), Vector::set( -1.0f ), one );
+        raw.x = Vector::mul( raw.x, sign );
+        raw.y = Vector::mul( raw.y, sign );
+        raw.z = Vector::mul( raw.z, sign );
+        raw.w = Vector::mul( raw.w, sign );
+
+        // Move predicted orientation towards raw orientation in tangent space
+        Type errorX, errorY, errorZ;
+        Quaternion::log( Quaternion::multiply( Quaternion::conjugate( predicted ), raw ), errorX, errorY, errorZ );
+        const Quaternion following = Quaternion::normalize( Quaternion::multiply( predicted, Quaternion::exp( Vector::mul( errorX, blend ), Vector::mul( errorY, blend ), Vector::mul( errorZ, blend ) ) ) );
+
+        // Select Filtered Orientation by Frame Count ( initial start value is raw orientation )
+        Quaternion filtered;
+        filtered.x = Vector::select( first, raw.x, following.x );
+        filtered.y = Vector::select( first, raw.y, following.y );
+        filtered.z = Vector::select( first, raw.z, following.z );
+        filtered.w = Vector::select( first, raw.w, following.w );
+
+        // Trend ( rotation from previous to filtered orientation, zero at initial start )
+        Type deltaX, deltaY, deltaZ;
+        Quaternion::log( Quaternion::multiply( Quaternion::conjugate( previous ), filtered ), deltaX, deltaY, deltaZ );
+        const Type trX = Vector::select( first, zero, Vector::add( Vector::mul( deltaX, correction ), Vector::mul( previousTrendX, inverseCorrection ) ) );
+        const Type trY = Vector::select( first, zero, Vector::add( Vector::mul( deltaY, correction ), Vector::mul( previousTrendY, inverseCorrection ) ) );
+        const Type trZ = Vector::select( first, zero, Vector::add( Vector::mul( deltaZ, correction ), Vector::mul( previousTrendZ, inverseCorrection ) ) );
+
+        // Predict into the future to reduce latency ( invalid orientation stays ( 0, 0, 0, 0 ) )
+        const Quaternion output = Quaternion::multiply( filtered, Quaternion::exp( Vector::mul( trX, prediction ), Vector::mul( trY, prediction ), Vector::mul( trZ, prediction ) ) );
+        Vector::store( &outputX[lane], Vector::select( valid, output.x, zero ) );
+        Vector::store( &outputY[lane], Vector::select( valid, output.y, zero ) );
+        Vector::store( &outputZ[lane], Vector::select( valid, output.z, zero ) );
+        Vector::store( &outputW[lane], Vector::select( valid, output.w, zero ) );
+
+        // Save the data from this frame
+        Vector::store( &filteredX[lane], Vector::select( valid, filtered.x, zero ) );
+        Vector::store( &filteredY[lane], Vector::select( valid, filtered.y, zero ) );
+        Vector::store( &filteredZ[lane], Vector::select( valid, filtered.z, zero ) );
+        Vector::store( &filteredW[lane], Vector::select( valid, filtered.w, one ) );
+        Vector::store( &trendX[lane], trX );
+        Vector::store( &trendY[lane], trY );
+        Vector::store( &trendZ[lane], trZ );
+        Vector::store( &frameCount[lane], Vector::select( valid, Vector::min( Vector::add( count, one ), one ), zero ) );
+    }
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+#ifndef __ORIENTATION_FILTER_BANK__
+#define __ORIENTATION_FILTER_BANK__
+
+#include <vector>
+#include <cstdint>
+
+// Orientation Filter Bank
+// Double exponential smoothing filter of joint orientations ( quaternions ) for all joints of all bodies.
+// Smoothing is applied in tangent space by log map and exp map, so that filtered orientation is always unit quaternion.
+// Input quaternion is flipped into same hemisphere as predicted orientation, so that q and -q are treated as same orientation.
+// Joints are stored in structure of arrays layout, and updated at once with AVX2 or SSE2 ( polynomial atan, sin and cos ).
+// This class has no dependency on Kinect SDK and DirectXMath.
+class OrientationFilterBank
+{
+public:
+    // Number of Bodies and Joints ( same as BODY_COUNT and JointType_Count )
+    static const int BODIES = 6;
+    static const int JOINTS = 25;
+
+    // Number of Lanes per Body ( padded to multiple of 64 bytes cache line, also multiple of 8 for AVX2 )
+    static const int STRIDE = ( JOINTS + 15 ) / 16 * 16;
+
+    // Smoothing Parameters
+    struct Parameters
+    {
+        float smoothing;  // [0..1], lower values closer to raw data
+        float correction; // [0..1], lower values slower to correct towards the raw data
+        float prediction; // [0..n], the number of frames to predict into the future
+
+        Parameters( const float smoothing = 0.5f, const float correction = 0.25f, const float prediction = 0.25f )
+            : smoothing( smoothing ), correction( correction ), prediction( prediction )
+        {
+        }
+    };
+
+private:
+    Parameters parameters;
+    int bodies;
+    int lanes;
+
+    // Storage of All Arrays ( aligned to cache line )
+    std::vector<float> storage;
+
+    // Indices of All Bodies ( for updating all filters without allocation )
+    std::vector<int> indices;
+
+    // Input ( raw orientations, ( 0, 0, 0, 0 ) if invalid )
+    float* inputX;
+    float* inputY;
+    float* inputZ;
+    float* inputW;
+
+    // History ( filtered orientation, and trend as rotation vector per frame )
+    float* filteredX;
+    float* filteredY;
+    float* filteredZ;
+    float* filteredW;
+    float* trendX;
+    float* trendY;
+    float* trendZ;
+    float* frameCount;
+
+    // Output ( predicted orientations )
+    float* outputX;
+    float* outputY;
+    float* outputZ;
+    float* outputW;
+
+public:
+    // Constructor ( number of bodies can be more than BODIES to keep lost bodies )
+    OrientationFilterBank( const int bodies = BODIES );
+
+    // Copy is not allowed ( arrays point into own storage )
+    OrientationFilterBank( const OrientationFilterBank& ) = delete;
+    OrientationFilterBank& operator=( const OrientationFilterBank& ) = delete;
+
+    // Retrieve Number of Bodies
+    int getBodies() const
+    {
+        return bodies;
+    }
+
+    // Initialize Parameters and Reset All Filters
+    void initialize( const Parameters& parameters = Parameters() );
+
+    // Reset Filters of Body
+    void reset( const int body );
+
+    // Set Raw Orientations of Body ( x, y, z, w )
+    void setOrientations( const int body, const float orientations[][4] );
+
+    // Clear Raw Orientations of Body ( filters of body are reset by next update )
+    void clearOrientations( const int body );
+
+    // Update All Filters
+    void update();
+
+    // Update Filters of Bodies ( in parallel, lanes of other bodies are untouched )
+    void update( const int* indices, const int count );
+
+    // Retrieve Filtered Orientation ( x, y, z, w )
+    void getFilteredOrientation( const int body, const int joint, float orientation[4] ) const
+    {
+        const int lane = body * STRIDE + joint;
+        orientation[0] = outputX[lane];
+        orientation[1] = outputY[lane];
+        orientation[2] = outputZ[lane];
+        orientation[3] = outputW[lane];
+    }
+
+private:
+    // Update Lanes
+    template<typename Vector>
+    void updateLanes( const int begin, const int end );
+};
+
+#endif // __ORIENTATION_FILTER_BANK__
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include "OrientationFilterManager.h"
+
+#include <algorithm>
+
+// Constructor
+OrientationFilterManager::OrientationFilterManager( const int capacity, const int64_t timeout )
+    : bank( capacity ),
+      slots( capacity ),
+      timestamp( 0 ),
+      timeout( timeout )
+{
+    updated.reserve( capacity );
+
+    // Initialize
+    initialize();
+}
+
+// Initialize Parameters and Release All Filters
+void OrientationFilterManager::initialize( const Parameters& parameters )
+{
+    bank.initialize( parameters );
+
+    for( Slot& slot : slots ){
+        slot.trackingId = 0;
+        slot.lastSeen = 0;
+    }
+    updated.clear();
+}
+
+// Begin Frame
+void OrientationFilterManager::begin( const int64_t timestamp )
+{
+    this->timestamp = timestamp;
+    updated.clear();
+
+    // Release Filters of Lost Bodies ( and all filters if timestamp goes backwards, e.g. replay is rewound )
+    for( int index = 0; index < static_cast<int>( slots.size() ); index++ ){
+        Slot& slot = slots[index];
+        if( slot.trackingId != 0 && ( timestamp - slot.lastSeen > timeout || timestamp < slot.lastSeen ) ){
+            slot.trackingId = 0;
+            bank.reset( index );
+        }
+    }
+}
+
+// Set Raw Orientations of Tracked Body
+void OrientationFilterManager::setOrientations( const uint64_t trackingId, const float orientations[][4] )
+{
+    int index = find( trackingId );
+    if( index == -1 ){
+        index = assign( trackingId );
+    }
+
+    slots[index].lastSeen = timestamp;
+    bank.setOrientations( index, orientations );
+    updated.push_back( index );
+}
+
+// Update Filters of Bodies Set in This Frame
+void OrientationFilterManager::update()
+{
+    if( updated.empty() ){
+        return;
+    }
+
+    bank.update( &updated[0], static_cast<int>( updated.size() ) );
+}
+
+// Retrieve Filtered Orientation
+bool OrientationFilterManager::getFilteredOrientation( const uint64_t trackingId, const int joint, float orientation[4] ) const
+{
+    const int index = find( trackingId );
+    if( index == -1 ){
+        return false;
+    }
+
+    bank.getFilteredOrientation( index, joint, orientation );
+    return true;
+}
+
+// Retrieve Number of Assigned Filters
+int OrientationFilterManager::getCount() const
+{
+    return static_cast<int>( std::count_if( slots.begin(), slots.end(), []( const Slot& slot ){ return slot.trackingId != 0; } ) );
+}
+
+// Find Slot of TrackingId
+int OrientationFilterManager::find( const uint64_t trackingId ) const
+{
+    if( trackingId == 0 ){
+        return -1;
+    }
+
+    for( int index = 0; index < static_cast<int>( slots.size() ); index++ ){
+        if( slots[index].trackingId == trackingId ){
+            return index;
+        }
+    }
+
+    return -1;
+}
+
+// Assign Slot to TrackingId
+int OrientationFilterManager::assign( const uint64_t trackingId )
+{
+    // Free Slot, otherwise Least Recently Seen Slot
+    int index = 0;
+    for( int candidate = 0; candidate < static_cast<int>( slots.size() ); candidate++ ){
+        if( slots[candidate].trackingId == 0 ){
+            index = candidate;
+            break;
+        }
+        if( slots[candidate].lastSeen < slots[index].lastSeen ){
+            index = candidate;
+        }
+    }
+
+    // Start New Filter
+    slots[index].trackingId = trackingId;
+    bank.reset( index );
+
+    return index;
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#ifndef __ORIENTATION_FILTER_MANAGER__
+#define __ORIENTATION_FILTER_MANAGER__
+
+#include "OrientationFilterBank.h"
+
+#include <vector>
+#include <cstdint>
+
+// Orientation Filter Manager
+// Filters of orientation filter bank are assigned to bodies by TrackingId, so that smoothing state follows the person rather than body index.
+// State of lost body is kept until timeout ( it is continued if the person is tracked again ), then the filter is released.
+// This class has no dependency on Kinect SDK.
+class OrientationFilterManager
+{
+private:
+    // Filter Slot
+    struct Slot
+    {
+        uint64_t trackingId; // 0 if free
+        int64_t lastSeen;    // Timestamp of last update ( 100 [ns] unit, same as TIMESPAN )
+    };
+
+    OrientationFilterBank bank;
+    std::vector<Slot> slots;
+    std::vector<int> updated;
+    int64_t timestamp;
+    int64_t timeout;
+
+public:
+    typedef OrientationFilterBank::Parameters Parameters;
+
+    // Constructor ( twice BODIES slots to keep lost bodies, timeout is 1 [s] )
+    OrientationFilterManager( const int capacity = OrientationFilterBank::BODIES * 2, const int64_t timeout = 10000000 );
+
+    // Initialize Parameters and Release All Filters
+    void initialize( const Parameters& parameters = Parameters() );
+
+    // Begin Frame ( release filters of bodies lost longer than timeout )
+    void begin( const int64_t timestamp );
+
+    // Set Raw Orientations of Tracked Body ( x, y, z, w )
+    void setOrientations( const uint64_t trackingId, const float orientations[][4] );
+
+    // Update Filters of Bodies Set in This Frame
+    void update();
+
+    // Retrieve Filtered Orientation ( return false if body has no filter )
+    bool getFilteredOrientation( const uint64_t trackingId, const int joint, float orientation[4] ) const;
+
+    // Retrieve Number of Assigned Filters
+    int getCount() const;
+
+private:
+    // Find Slot of TrackingId ( -1 if not assigned )
+    int find( const uint64_t trackingId ) const;
+
+    // Assign Slot to TrackingId ( free slot, or least recently seen slot if all slots are assigned )
+    int assign( const uint64_t trackingId );
+};
+
+#endif // __ORIENTATION_FILTER_MANAGER__
\ No newline at end of file
@@ -0,0 +1,283 @@
+#include "SkeletonHistory.h"
+
+#include <algorithm>
+#include <limits>
+
+// Constructor
+SkeletonHistory::SkeletonHistory( const int capacity )
+    : capacity( capacity ),
+      timestamps( capacity ),
+      trackingIds( BODIES * capacity ),
+      handLeftStates( BODIES * capacity ),
+      handRightStates( BODIES * capacity ),
+      x( BODIES * JOINTS * capacity ),
+      y( BODIES * JOINTS * capacity ),
+      z( BODIES * JOINTS * capacity ),
+      qx( BODIES * JOINTS * capacity ),
+      qy( BODIES * JOINTS * capacity ),
+      qz( BODIES * JOINTS * capacity ),
+      qw( BODIES * JOINTS * capacity ),
+      states( BODIES * JOINTS * capacity )
+{
+    clear();
+}
+
+// Clear All Frames
+void SkeletonHistory::clear()
+{
+    head = 0;
+    size = 0;
+}
+
+// Append Frame
+void SkeletonHistory::append( const int64_t timestamp, const BodySample* bodies )
+{
+    // Restart if Timestamp goes Backwards ( e.g. replay is rewound, time window queries need ascending timestamps )
+    if( size > 0 && timestamp < getLatestTimestamp() ){
+        clear();
+    }
+
+    const int frame = head;
+    timestamps[frame] = timestamp;
+
+    for( int body = 0; body < BODIES; body++ ){
+        const BodySample& sample = bodies[body];
+        const int bodyIndex = body * capacity + frame;
+        trackingIds[bodyIndex] = sample.trackingId;
+        handLeftStates[bodyIndex] = sample.handLeftState;
+        handRightStates[bodyIndex] = sample.handRightState;
+
+        for( int joint = 0; joint < JOINTS; joint++ ){
+            const int index = ( body * JOINTS + joint ) * capacity + frame;
+            x[index] = sample.positions[joint][0];
+            y[index] = sample.positions[joint][1];
+            z[index] = sample.positions[joint][2];
+            qx[index] = sample.orientations[joint][0];
+            qy[index] = sample.orientations[joint][1];
+            qz[index] = sample.orientations[joint][2];
+            qw[index] = sample.orientations[joint][3];
+            states[index] = sample.states[joint];
+        }
+    }
+
+    head = ( head + 1 ) % capacity;
+    size = std::min( size + 1, capacity );
+}
+
+// Retrieve Timestamp of Latest Frame
+int64_t SkeletonHistory::getLatestTimestamp() const
+{
+    if( size == 0 ){
+        return 0;
+    }
+
+    return timestamps[physical( size - 1 )];
+}
+
+// Find Body Slot of TrackingId in Logical Frame
+int SkeletonHistory::slot( const uint64_t trackingId, const int frame, const int hint ) const
+{
+    const int index = physical( frame );
+    if( trackingIds[hint * capacity + index] == trackingId ){
+        return hint;
+    }
+
+    for( int body = 0; body < BODIES; body++ ){
+        if( trackingIds[body * capacity + index] == trackingId ){
+            return body;
+        }
+    }
+
+    return -1;
+}
+
+// Find Logical Range of Frames of TrackingId within Time Window
+bool SkeletonHistory::find( const uint64_t trackingId, const int64_t window, int& first, int& count ) const
+{
+    if( size == 0 || trackingId == 0 ){
+        return false;
+    }
+
+    // Body Slot in Latest Frame
+    int body = slot( trackingId, size - 1 );
+    if( body == -1 ){
+        return false;
+    }
+
+    // Walk Back while TrackingId is Present ( in any slot ) and within Time Window
+    const int64_t oldest = timestamps[physical( size - 1 )] - window;
+    first = size - 1;
+    while( first > 0 ){
+        if( timestamps[physical( first - 1 )] < oldest ){
+            break;
+        }
+        body = slot( trackingId, first - 1, body );
+        if( body == -1 ){
+            break;
+        }
+        first--;
+    }
+    count = size - first;
+
+    return true;
+}
+
+// Find Run of Frames from Logical Frame where TrackingId stays in Same Body Slot
+int SkeletonHistory::run( const uint64_t trackingId, const int frame, const int end, int& body ) const
+{
+    body = slot( trackingId, frame );
+    int next = frame + 1;
+    while( next < end && trackingIds[body * capacity + physical( next )] == trackingId ){
+        next++;
+    }
+
+    return next;
+}
+
+// Split Logical Range into Contiguous Physical Segments
+int SkeletonHistory::segments( const int first, const int count, int begin[2], int end[2] ) const
+{
+    const int start = physical( first );
+    if( start + count <= capacity ){
+        begin[0] = start;
+        end[0] = start + count;
+        return 1;
+    }
+
+    begin[0] = start;
+    end[0] = capacity;
+    begin[1] = 0;
+    end[1] = start + count - capacity;
+    return 2;
+}
+
+// Velocity of Joint over Time Window
+bool SkeletonHistory::velocity( const uint64_t trackingId, const int joint, const int64_t window, float result[3] ) const
+{
+    int first, count;
+    if( !find( trackingId, window, first, count ) || count < 2 ){
+        return false;
+    }
+
+    const int64_t origin = timestamps[physical( first )];
+
+    // Sums for Least Squares Slope ( time in seconds relative to oldest frame, over each run of same body slot )
+    double sumT = 0.0, sumTT = 0.0;
+    double sumX = 0.0, sumY = 0.0, sumZ = 0.0;
+    double sumTX = 0.0, sumTY = 0.0, sumTZ = 0.0;
+    for( int frame = first, body; frame < size; ){
+        const int next = run( trackingId, frame, size, body );
+        int begin[2], end[2];
+        const int number = segments( frame, next - frame, begin, end );
+        const int offset = ( body * JOINTS + joint ) * capacity;
+        const float* px = &x[offset];
+        const float* py = &y[offset];
+        const float* pz = &z[offset];
+        for( int segment = 0; segment < number; segment++ ){
+            for( int index = begin[segment]; index < end[segment]; index++ ){
+                const double t = ( timestamps[index] - origin ) * 1e-7;
+                sumT += t;
+                sumTT += t * t;
+                sumX += px[index];
+                sumY += py[index];
+                sumZ += pz[index];
+                sumTX += t * px[index];
+                sumTY += t * py[index];
+                sumTZ += t * pz[index];
+            }
+        }
+        frame = next;
+    }
+
+    const double denominator = count * sumTT - sumT * sumT;
+    if( denominator <= std::numeric_limits<double>::epsilon() ){
+        return false;
+    }
+
+    result[0] = static_cast<float>( ( count * sumTX - sumT * sumX ) / denominator );
+    result[1] = static_cast<float>( ( count * sumTY - sumT * sumY ) / denominator );
+    result[2] = static_cast<float>( ( count * sumTZ - sumT * sumZ ) / denominator );
+
+    return true;
+}
+
+// Displacement of Joint over Time Window
+bool SkeletonHistory::displacement( const uint64_t trackingId, const int joint, const int64_t window, float result[3] ) const
+{
+    int first, count;
+    if( !find( trackingId, window, first, count ) ){
+        return false;
+    }
+
+    // Oldest and Latest Frames may be in Different Body Slots
+    const int oldest = ( slot( trackingId, first ) * JOINTS + joint ) * capacity + physical( first );
+    const int latest = ( slot( trackingId, size - 1 ) * JOINTS + joint ) * capacity + physical( size - 1 );
+    result[0] = x[latest] - x[oldest];
+    result[1] = y[latest] - y[oldest];
+    result[2] = z[latest] - z[oldest];
+
+    return true;
+}
+
+// Bounding Volume of Tracked and Inferred Joints over Time Window
+bool SkeletonHistory::bounds( const uint64_t trackingId, const int64_t window, float minimum[3], float maximum[3] ) const
+{
+    int first, count;
+    if( !find( trackingId, window, first, count ) ){
+        return false;
+    }
+
+    const float infinity = std::numeric_limits<float>::infinity();
+    float minimumX = infinity, minimumY = infinity, minimumZ = infinity;
+    float maximumX = -infinity, maximumY = -infinity, maximumZ = -infinity;
+    for( int frame = first, body; frame < size; ){
+        // Run of Same Body Slot
+        const int next = run( trackingId, frame, size, body );
+        int begin[2], end[2];
+        const int number = segments( frame, next - frame, begin, end );
+        for( int joint = 0; joint < JOINTS; joint++ ){
+            const int offset = ( body * JOINTS + joint ) * capacity;
+            const float* px = &x[offset];
+            const float* py = &y[offset];
+            const float* pz = &z[offset];
+            const uint8_t* ps = &states[offset];
+            for( int segment = 0; segment < number; segment++ ){
+                for( int index = begin[segment]; index < end[segment]; index++ ){
+                    // Not Tracked Joints are Excluded by Selection ( no branch )
+                    const bool valid = ( ps[index] != 0 );
+                    minimumX = std::min( minimumX, valid ? px[index] : infinity );
+                    minimumY = std::min( minimumY, valid ? py[index] : infinity );
+                    minimumZ = std::min( minimumZ, valid ? pz[index] : infinity );
+                    maximumX = std::max( maximumX, valid ? px[index] : -infinity );
+                    maximumY = std::max( maximumY, valid ? py[index] : -infinity );
+                    maximumZ = std::max( maximumZ, valid ? pz[index] : -infinity );
+                }
+            }
+        }
+        frame = next;
+    }
+
+    if( minimumX > maximumX ){
+        return false;
+    }
+
+    minimum[0] = minimumX; minimum[1] = minimumY; minimum[2] = minimumZ;
+    maximum[0] = maximumX; maximum[1] = maximumY; maximum[2] = maximumZ;
+
+    return true;
+}
+
+// Retrieve Latest Hand States
+bool SkeletonHistory::handStates( const uint64_t trackingId, uint8_t& handLeftState, uint8_t& handRightState ) const
+{
+    const int body = ( size == 0 || trackingId == 0 ) ? -1 : slot( trackingId, size - 1 );
+    if( body == -1 ){
+        return false;
+    }
+
+    const int index = body * capacity + physical( size - 1 );
+    handLeftState = handLeftStates[index];
+    handRightState = handRightStates[index];
+
+    return true;
+}
\ No newline at end of file
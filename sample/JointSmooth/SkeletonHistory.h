@@ -0,0 +1,99 @@
+#ifndef __SKELETON_HISTORY__
+#define __SKELETON_HISTORY__
+
+#include <vector>
+#include <cstdint>
+
+// Skeleton History
+// Ring buffer of all bodies and joints in structure of arrays layout ( each component of each joint is contiguous over time ).
+// Append is O(1), and time window queries run over contiguous arrays of one body slot, keyed by TrackingId and timestamp.
+// Body slot of TrackingId is matched in each frame, so that queries follow the person even if the slot changes within the window.
+class SkeletonHistory
+{
+public:
+    // Number of Bodies and Joints ( same as BODY_COUNT and JointType_Count )
+    static const int BODIES = 6;
+    static const int JOINTS = 25;
+
+    // Body Sample ( input of append, joints are same order as JointType, trackingId is 0 if not tracked )
+    struct BodySample
+    {
+        uint64_t trackingId;
+        float positions[JOINTS][3];    // X, Y, Z
+        float orientations[JOINTS][4]; // X, Y, Z, W
+        uint8_t states[JOINTS];        // TrackingState
+        uint8_t handLeftState;         // HandState
+        uint8_t handRightState;        // HandState
+    };
+
+private:
+    // Capacity ( number of frames ) and Ring Position
+    int capacity;
+    int head;
+    int size;
+
+    // Timestamp of Each Frame ( 100 [ns] unit, same as TIMESPAN )
+    std::vector<int64_t> timestamps;
+
+    // [body][frame]
+    std::vector<uint64_t> trackingIds;
+    std::vector<uint8_t> handLeftStates;
+    std::vector<uint8_t> handRightStates;
+
+    // [body][joint][frame]
+    std::vector<float> x, y, z;
+    std::vector<float> qx, qy, qz, qw;
+    std::vector<uint8_t> states;
+
+public:
+    // Constructor ( e.g. 10 [s] of 30 [fps] is 300 frames )
+    SkeletonHistory( const int capacity = 300 );
+
+    // Append Frame ( BODIES samples, history is cleared if timestamp goes backwards )
+    void append( const int64_t timestamp, const BodySample* bodies );
+
+    // Clear All Frames
+    void clear();
+
+    // Retrieve Number of Frames
+    int getSize() const
+    {
+        return size;
+    }
+
+    // Retrieve Timestamp of Latest Frame
+    int64_t getLatestTimestamp() const;
+
+    // Velocity of Joint over Time Window ( least squares slope, [m/s] )
+    bool velocity( const uint64_t trackingId, const int joint, const int64_t window, float result[3] ) const;
+
+    // Displacement of Joint over Time Window ( latest - oldest, [m] )
+    bool displacement( const uint64_t trackingId, const int joint, const int64_t window, float result[3] ) const;
+
+    // Bounding Volume of Tracked and Inferred Joints over Time Window ( [m] )
+    bool bounds( const uint64_t trackingId, const int64_t window, float minimum[3], float maximum[3] ) const;
+
+    // Retrieve Latest Hand States
+    bool handStates( const uint64_t trackingId, uint8_t& handLeftState, uint8_t& handRightState ) const;
+
+private:
+    // Physical Index of Logical Frame ( 0 is oldest )
+    int physical( const int frame ) const
+    {
+        return ( head - size + frame + capacity ) % capacity;
+    }
+
+    // Find Body Slot of TrackingId in Logical Frame ( -1 if absent, hint is checked first )
+    int slot( const uint64_t trackingId, const int frame, const int hint = 0 ) const;
+
+    // Find Logical Range of Frames of TrackingId within Time Window ( TrackingId is present in every frame of range )
+    bool find( const uint64_t trackingId, const int64_t window, int& first, int& count ) const;
+
+    // Find Run of Frames from Logical Frame where TrackingId stays in Same Body Slot ( return end of run )
+    int run( const uint64_t trackingId, const int frame, const int end, int& body ) const;
+
+    // Split Logical Range into Contiguous Physical Segments ( at most 2 )
+    int segments( const int first, const int count, int begin[2], int end[2] ) const;
+};
+
+#endif // __SKELETON_HISTORY__
\ No newline at end of file
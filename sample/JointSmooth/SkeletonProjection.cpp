@@ -0,0 +1,196 @@
+#include "SkeletonProjection.h"
+
+#include <cmath>
+#include <limits>
+#include <fstream>
+#include <algorithm>
+
+// Solve Linear Equations ( n <= 3, Gaussian elimination with partial pivoting )
+static bool solve( double a[3][3], double b[3], const int n )
+{
+    for( int column = 0; column < n; column++ ){
+        int pivot = column;
+        for( int row = column + 1; row < n; row++ ){
+            if( std::fabs( a[row][column] ) > std::fabs( a[pivot][column] ) ){
+                pivot = row;
+            }
+        }
+        if( std::fabs( a[pivot][column] ) < 1e-12 ){
+            return false;
+        }
+        for( int k = 0; k < n; k++ ){
+            std::swap( a[column][k], a[pivot][k] );
+        }
+        std::swap( b[column], b[pivot] );
+
+        for( int row = column + 1; row < n; row++ ){
+            const double factor = a[row][column] / a[column][column];
+            for( int k = column; k < n; k++ ){
+                a[row][k] -= factor * a[column][k];
+            }
+            b[row] -= factor * b[column];
+        }
+    }
+
+    for( int row = n - 1; row >= 0; row-- ){
+        for( int k = row + 1; k < n; k++ ){
+            b[row] -= a[row][k] * b[k];
+        }
+        b[row] /= a[row][row];
+    }
+
+    return true;
+}
+
+// Fit Model from Corresponding Points
+// Pinhole and distortion are solved alternately as linear least squares, each with the other fixed.
+bool SkeletonProjection::Calibration::fit( const CameraPoint* cameraPoints, const ColorPoint* colorPoints, const int count )
+{
+    fx = fy = 1.0f;
+    cx = cy = tx = ty = k1 = k2 = 0.0f;
+
+    for( int iteration = 0; iteration < 32; iteration++ ){
+        // Pinhole ( u = fx * d * X / Z + ( fx * tx ) * d / Z + cx, same for v )
+        double au[3][3] = {}, bu[3] = {};
+        double av[3][3] = {}, bv[3] = {};
+        int valid = 0;
+        for( int i = 0; i < count; i++ ){
+            const CameraPoint& p = cameraPoints[i];
+            const ColorPoint& q = colorPoints[i];
+            if( p.Z <= 0.0f || !std::isfinite( q.X ) || !std::isfinite( q.Y ) ){
+                continue;
+            }
+
+            const double x = ( p.X + tx ) / p.Z;
+            const double y = ( p.Y + ty ) / p.Z;
+            const double r2 = x * x + y * y;
+            const double d = 1.0 + r2 * ( k1 + r2 * k2 );
+            const double ru[3] = { d * p.X / p.Z, d / p.Z, 1.0 };
+            const double rv[3] = { d * p.Y / p.Z, d / p.Z, 1.0 };
+            for( int j = 0; j < 3; j++ ){
+                for( int k = 0; k < 3; k++ ){
+                    au[j][k] += ru[j] * ru[k];
+                    av[j][k] += rv[j] * rv[k];
+                }
+                bu[j] += ru[j] * q.X;
+                bv[j] += rv[j] * q.Y;
+            }
+            valid++;
+        }
+
+        if( valid < 8 || !solve( au, bu, 3 ) || !solve( av, bv, 3 ) ){
+            return false;
+        }
+
+        fx = static_cast<float>( bu[0] );
+        tx = static_cast<float>( bu[1] / bu[0] );
+        cx = static_cast<float>( bu[2] );
+        fy = static_cast<float>( bv[0] );
+        ty = static_cast<float>( bv[1] / bv[0] );
+        cy = static_cast<float>( bv[2] );
+
+        // Radial Distortion ( u - cx - fx * x = fx * x * ( k1 * r^2 + k2 * r^4 ), same for v )
+        double ad[3][3] = {}, bd[3] = {};
+        for( int i = 0; i < count; i++ ){
+            const CameraPoint& p = cameraPoints[i];
+            const ColorPoint& q = colorPoints[i];
+            if( p.Z <= 0.0f || !std::isfinite( q.X ) || !std::isfinite( q.Y ) ){
+                continue;
+            }
+
+            const double x = ( p.X + tx ) / p.Z;
+            const double y = ( p.Y + ty ) / p.Z;
+            const double r2 = x * x + y * y;
+            const double ru[2] = { fx * x * r2, fx * x * r2 * r2 };
+            const double rv[2] = { fy * y * r2, fy * y * r2 * r2 };
+            const double eu = q.X - ( cx + fx * x );
+            const double ev = q.Y - ( cy + fy * y );
+            for( int j = 0; j < 2; j++ ){
+                for( int k = 0; k < 2; k++ ){
+                    ad[j][k] += ru[j] * ru[k] + rv[j] * rv[k];
+                }
+                bd[j] += ru[j] * eu + rv[j] * ev;
+            }
+        }
+
+        if( !solve( ad, bd, 2 ) ){
+            k1 = k2 = 0.0f;
+            break;
+        }
+        k1 = static_cast<float>( bd[0] );
+        k2 = static_cast<float>( bd[1] );
+    }
+
+    return true;
+}
+
+// Save Model to Text File
+bool SkeletonProjection::Calibration::save( const std::string& path ) const
+{
+    std::ofstream file( path );
+    if( !file.is_open() ){
+        return false;
+    }
+
+    file.precision( 9 );
+    file << fx << " " << fy << " " << cx << " " << cy << " " << tx << " " << ty << " " << k1 << " " << k2 << std::endl;
+
+    return file.good();
+}
+
+// Load Model from Text File
+bool SkeletonProjection::Calibration::load( const std::string& path )
+{
+    std::ifstream file( path );
+    if( !file.is_open() ){
+        return false;
+    }
+
+    file >> fx >> fy >> cx >> cy >> tx >> ty >> k1 >> k2;
+
+    return !file.fail();
+}
+
+// Constructor
+SkeletonProjection::SkeletonProjection()
+{
+    clear();
+}
+
+// Clear Gathered Joints
+void SkeletonProjection::clear()
+{
+    count = 0;
+    offsets.fill( -1 );
+}
+
+// Gather Joints of Body
+void SkeletonProjection::gather( const int body, const CameraPoint* joints )
+{
+    offsets[body] = count;
+    std::copy( joints, joints + JOINTS, cameraPoints.begin() + count );
+    count += JOINTS;
+}
+
+// Project Gathered Joints with Color Camera Model
+// Loop has no branches except selection, so that compiler can vectorize it.
+void SkeletonProjection::project( const Calibration& calibration )
+{
+    const float infinity = -std::numeric_limits<float>::infinity();
+    const CameraPoint* source = cameraPoints.data();
+    ColorPoint* destination = colorPoints.data();
+    for( int i = 0; i < count; i++ ){
+        const float z = source[i].Z;
+        const float inverse = 1.0f / ( z > 0.0f ? z : 1.0f );
+        const float x = ( source[i].X + calibration.tx ) * inverse;
+        const float y = ( source[i].Y + calibration.ty ) * inverse;
+        const float r2 = x * x + y * y;
+        const float distortion = 1.0f + r2 * ( calibration.k1 + r2 * calibration.k2 );
+        const float u = calibration.cx + calibration.fx * x * distortion;
+        const float v = calibration.cy + calibration.fy * y * distortion;
+
+        // Points behind camera are mapped to -Infinity same as coordinate mapper
+        destination[i].X = ( z > 0.0f ) ? u : infinity;
+        destination[i].Y = ( z > 0.0f ) ? v : infinity;
+    }
+}
\ No newline at end of file
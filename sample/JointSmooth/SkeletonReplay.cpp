@@ -0,0 +1,130 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <set>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+#include "SkeletonStream.h"
+#include "SkeletonHistory.h"
+#include "JointFilterManager.h"
+#include "OrientationFilterManager.h"
+#include "JointPredictor.h"
+#include "JointFilterBenchmark.h"
+
+// Skeleton Replay
+// Recorded skeleton file is replayed without sensor ( e.g. regression testing on Linux ), through same stages as JointSmooth.
+// Each frame is appended to skeleton history, filtered by joint and orientation filters, and set to joint predictor.
+// With "benchmark", jitter versus lag of each filter is printed instead ( same as "JointSmooth <file> benchmark" ).
+// This program has no dependency on Kinect SDK and OpenCV.
+int main( int argc, char* argv[] )
+{
+    try{
+        if( argc < 2 ){
+            throw std::runtime_error( "usage : SkeletonReplay <recorded skeleton file> [realtime|benchmark]" );
+        }
+
+        // Benchmark Filters on Recorded Skeleton File
+        const std::string replay = argv[1];
+        if( argc > 2 && std::string( argv[2] ) == "benchmark" ){
+            JointFilterBenchmark benchmark;
+            if( !benchmark.open( replay ) ){
+                throw std::runtime_error( "failed JointFilterBenchmark::open( " + replay + " )" );
+            }
+            benchmark.run();
+            benchmark.print( std::cout );
+            return 0;
+        }
+
+        // Open Recorded Skeleton File ( maximum speed, or paced by recorded time )
+        SkeletonReplayer replayer;
+        if( !replayer.open( replay ) ){
+            throw std::runtime_error( "failed SkeletonReplayer::open( " + replay + " )" );
+        }
+        replayer.setRealtime( argc > 2 && std::string( argv[2] ) == "realtime" );
+
+        // Create Stages ( same parameters as JointSmooth )
+        SkeletonHistory history;
+        JointFilterManager<HoltFilter> filterManager;
+        filterManager.initialize( HoltFilter::Parameters( 0.25f, 0.25f, 0.25f, 0.03f, 0.05f ) );
+        OrientationFilterManager orientationManager;
+        orientationManager.initialize( OrientationFilterBank::Parameters( 0.5f, 0.25f, 0.25f ) );
+        JointPredictor predictor;
+        predictor.initialize();
+
+        // Replay All Frames
+        SkeletonFrame frame;
+        std::vector<SkeletonHistory::BodySample> samples( SkeletonFrame::BODIES );
+        std::set<uint64_t> trackingIds;
+        int64_t first = 0;
+        int frames = 0;
+        int bodies = 0;
+        double time = 0.0;
+        while( replayer.read( frame ) ){
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+            // Update History
+            for( int index = 0; index < SkeletonFrame::BODIES; index++ ){
+                const SkeletonFrame::Body& body = frame.bodies[index];
+                SkeletonHistory::BodySample& sample = samples[index];
+                sample.trackingId = body.tracked ? body.trackingId : 0;
+                if( !body.tracked ){
+                    continue;
+                }
+
+                std::memcpy( sample.positions, body.positions, sizeof( sample.positions ) );
+                std::memcpy( sample.orientations, body.orientations, sizeof( sample.orientations ) );
+                std::memcpy( sample.states, body.states, sizeof( sample.states ) );
+                sample.handLeftState = body.handLeftState;
+                sample.handRightState = body.handRightState;
+            }
+            history.append( frame.timestamp, &samples[0] );
+
+            // Update Filters
+            filterManager.begin( frame.timestamp );
+            orientationManager.begin( frame.timestamp );
+            for( const SkeletonFrame::Body& body : frame.bodies ){
+                if( body.tracked ){
+                    filterManager.setJoints( body.trackingId, body.positions, body.states );
+                    orientationManager.setOrientations( body.trackingId, body.orientations );
+                }
+            }
+            filterManager.update();
+            orientationManager.update();
+
+            // Update Predictor by Filtered Joints
+            predictor.begin( frame.timestamp );
+            for( const SkeletonFrame::Body& body : frame.bodies ){
+                if( !body.tracked ){
+                    continue;
+                }
+
+                float positions[SkeletonFrame::JOINTS][3];
+                for( int joint = 0; joint < SkeletonFrame::JOINTS; joint++ ){
+                    filterManager.getFilteredJoint( body.trackingId, joint, positions[joint] );
+                }
+                predictor.setJoints( body.trackingId, positions );
+                trackingIds.insert( body.trackingId );
+                bodies++;
+            }
+
+            time += std::chrono::duration<double, std::micro>( std::chrono::steady_clock::now() - start ).count();
+            if( frames++ == 0 ){
+                first = frame.timestamp;
+            }
+        }
+
+        // Print Summary
+        const double duration = frames ? ( frame.timestamp - first ) / 10000000.0 : 0.0;
+        std::cout << std::fixed << std::setprecision( 1 );
+        std::cout << replay << " : " << frames << " frames, " << duration << " [s], " << bodies << " tracked bodies, " << trackingIds.size() << " TrackingIds" << std::endl;
+        std::cout << "Update : " << ( frames ? time / frames : 0.0 ) << " [us/frame] ( history, joint and orientation filters, predictor )" << std::endl;
+        return 0;
+    } catch( std::exception& ex ){
+        std::cout << ex.what() << std::endl;
+    }
+
+    return 1;
+}
\ No newline at end of file
@@ -3,15 +3,36 @@
 
 #include <thread>
 #include <chrono>
+#include <iostream>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
 
 #include <omp.h>
 
 // Joint Smoothing
 #define SMOOTH
 
+// Verify Filter Bank with Original Filter ( print max difference every 100 frames )
+//#define VERIFY_FILTER
+
+// Joint Prediction ( draw joints predicted at presentation time )
+#define PREDICT
+
+// Display Offset of Prediction ( latency after cv::imshow() that is not measured on CPU, 100 [ns] unit, e.g. 1 frame of 60 [Hz] display )
+#define DISPLAY_OFFSET 166667
+
 // Constructor
-Kinect::Kinect()
+Kinect::Kinect( const std::string& replay, const bool realtime )
 {
+    // Open Replay
+    if( !replay.empty() ){
+        if( !replayer.open( replay ) ){
+            throw std::runtime_error( "failed SkeletonReplayer::open( " + replay + " )" );
+        }
+        replayer.setRealtime( realtime );
+    }
+
     // Initialize
     initialize();
 }
@@ -32,16 +53,28 @@ void Kinect::run()
         update();
 
         // Draw Data
+        const int64_t drawn = JointPredictor::getLocalTime();
+        presentation = predictor.getPresentationTime( drawn );
         draw();
 
         // Show Data
         show();
 
+        // Measure Drawing Latency ( display offset is added by predictor )
+        predictor.measureLatency( JointPredictor::getLocalTime() - drawn );
+
         // Key Check
         const int key = cv::waitKey( 10 );
         if( key == VK_ESCAPE ){
             break;
         }
+        else if( key == 'c' && !replayer.isOpened() ){
+            std::cout << "Save Calibration of Color Camera to File" << std::endl;
+            saveCalibration();
+        }
+        else if( key == 'r' && !replayer.isOpened() ){
+            toggleRecording();
+        }
     }
 }
 
@@ -50,6 +83,55 @@ void Kinect::initialize()
 {
     cv::setUseOptimized( true );
 
+    // Color Table for Visualization
+    colors[0] = cv::Vec3b( 255,   0,   0 ); // Blue
+    colors[1] = cv::Vec3b(   0, 255,   0 ); // Green
+    colors[2] = cv::Vec3b(   0,   0, 255 ); // Red
+    colors[3] = cv::Vec3b( 255, 255,   0 ); // Cyan
+    colors[4] = cv::Vec3b( 255,   0, 255 ); // Magenta
+    colors[5] = cv::Vec3b(   0, 255, 255 ); // Yellow
+
+    // Initialize Skeleton Buffer
+    std::memset( &frame, 0, sizeof( SkeletonFrame ) );
+
+    // Initialize Body Buffer
+    for( auto& body : bodies ){
+        body = nullptr;
+    }
+
+#ifdef SMOOTH
+    // Set Smoothing Fileter Parameters
+    Sample::TRANSFORM_SMOOTH_PARAMETERS smoothingParams;
+    smoothingParams.fSmoothing = 0.25f;          // [0..1], lower values closer to raw data
+    smoothingParams.fCorrection = 0.25f;         // [0..1], lower values slower to correct towards the raw data
+    smoothingParams.fPrediction = 0.25f;         // [0..n], the number of frames to predict into the future
+    smoothingParams.fJitterRadius = 0.03f;       // The radius in meters for jitter reduction
+    smoothingParams.fMaxDeviationRadius = 0.05f; // The maximum radius in meters that filtered positions are allowed to deviate from raw data
+
+    // Create Holt Double Exponential Smoothing Filter Bank
+    filterManager.initialize( HoltFilter::Parameters( smoothingParams.fSmoothing, smoothingParams.fCorrection, smoothingParams.fPrediction, smoothingParams.fJitterRadius, smoothingParams.fMaxDeviationRadius ) );
+
+    // Create Orientation Filter Bank ( double exponential smoothing of joint orientations in tangent space )
+    orientationManager.initialize( OrientationFilterBank::Parameters( 0.5f, 0.25f, 0.25f ) );
+
+#ifdef VERIFY_FILTER
+    for( Sample::FilterDoubleExponential& filter : filters ){
+        filter.Init( smoothingParams.fSmoothing, smoothingParams.fCorrection, smoothingParams.fPrediction, smoothingParams.fJitterRadius, smoothingParams.fMaxDeviationRadius );
+    }
+#endif
+#endif
+
+#ifdef PREDICT
+    // Set Display Offset of Predictor
+    predictor.setDisplayOffset( DISPLAY_OFFSET );
+#endif
+
+    // Initialize Replay
+    if( replayer.isOpened() ){
+        initializeReplay();
+        return;
+    }
+
     // Initialize Sensor
     initializeSensor();
 
@@ -108,34 +190,22 @@ inline void Kinect::initializeBody()
     ComPtr<IBodyFrameSource> bodyFrameSource;
     ERROR_CHECK( kinect->get_BodyFrameSource( &bodyFrameSource ) );
     ERROR_CHECK( bodyFrameSource->OpenReader( &bodyFrameReader ) );
+}
 
-    // Initialize Body Buffer
-    for( auto& body : bodies ){
-        body = nullptr;
-    }
-
-#ifdef SMOOTH
-    // Set Smoothing Fileter Parameters
-    Sample::TRANSFORM_SMOOTH_PARAMETERS smoothingParams;
-    smoothingParams.fSmoothing = 0.25f;          // [0..1], lower values closer to raw data
-    smoothingParams.fCorrection = 0.25f;         // [0..1], lower values slower to correct towards the raw data
-    smoothingParams.fPrediction = 0.25f;         // [0..n], the number of frames to predict into the future
-    smoothingParams.fJitterRadius = 0.03f;       // The radius in meters for jitter reduction
-    smoothingParams.fMaxDeviationRadius = 0.05f; // The maximum radius in meters that filtered positions are allowed to deviate from raw data
-
-    // Create Holt Double Exponential Smoothing Filter
-    for( Sample::FilterDoubleExponential filter : filters ){
-        filter.Init( smoothingParams.fSmoothing, smoothingParams.fCorrection, smoothingParams.fPrediction, smoothingParams.fJitterRadius, smoothingParams.fMaxDeviationRadius );
+// Initialize Replay
+// Joints are drawn on black image of color resolution, projected with calibration saved from live sensor ( 'c' key ).
+inline void Kinect::initializeReplay()
+{
+    // Load Calibration of Color Camera
+    if( !calibration.load( "ColorCalibration.txt" ) ){
+        throw std::runtime_error( "failed SkeletonProjection::Calibration::load( ColorCalibration.txt )" );
     }
-#endif
 
-    // Color Table for Visualization
-    colors[0] = cv::Vec3b( 255,   0,   0 ); // Blue
-    colors[1] = cv::Vec3b(   0, 255,   0 ); // Green
-    colors[2] = cv::Vec3b(   0,   0, 255 ); // Red
-    colors[3] = cv::Vec3b( 255, 255,   0 ); // Cyan
-    colors[4] = cv::Vec3b( 255,   0, 255 ); // Magenta
-    colors[5] = cv::Vec3b(   0, 255, 255 ); // Yellow
+    // Allocation Color Buffer
+    colorWidth = 1920;
+    colorHeight = 1080;
+    colorBytesPerPixel = 4;
+    colorBuffer.resize( colorWidth * colorHeight * colorBytesPerPixel );
 }
 
 // Finalize
@@ -157,6 +227,12 @@ void Kinect::finalize()
 // Update Data
 void Kinect::update()
 {
+    // Update Replay
+    if( replayer.isOpened() ){
+        updateReplay();
+        return;
+    }
+
     // Update Color
     updateColor();
 
@@ -195,6 +271,221 @@ inline void Kinect::updateBody()
 
     // Retrieve Body Data
     ERROR_CHECK( bodyFrame->GetAndRefreshBodyData( BODY_COUNT, &bodies[0] ) );
+
+    // Retrieve Skeleton Frame
+    retrieveFrame( bodyFrame );
+
+    // Record Skeleton Frame
+    if( recorder.isOpened() ){
+        if( !recorder.write( frame ) ){
+            throw std::runtime_error( "failed SkeletonRecorder::write()" );
+        }
+    }
+
+    // Update History
+    updateHistory();
+
+    // Update Filter
+    updateFilter();
+
+    // Update Predictor
+    updatePredictor();
+}
+
+// Update Replay
+inline void Kinect::updateReplay()
+{
+    // Clear Color Buffer
+    std::fill( colorBuffer.begin(), colorBuffer.end(), 0 );
+
+    // Read Next Skeleton Frame ( loop at the end )
+    if( !replayer.read( frame ) ){
+        replayer.rewind();
+        if( !replayer.read( frame ) ){
+            throw std::runtime_error( "failed SkeletonReplayer::read()" );
+        }
+    }
+
+    // Update History
+    updateHistory();
+
+    // Update Filter
+    updateFilter();
+
+    // Update Predictor
+    updatePredictor();
+}
+
+// Retrieve Skeleton Frame
+inline void Kinect::retrieveFrame( const ComPtr<IBodyFrame>& bodyFrame )
+{
+    // Retrieve Timestamp
+    TIMESPAN relativeTime;
+    ERROR_CHECK( bodyFrame->get_RelativeTime( &relativeTime ) );
+    frame.timestamp = relativeTime;
+
+    for( int index = 0; index < BODY_COUNT; index++ ){
+        SkeletonFrame::Body& data = frame.bodies[index];
+        data.tracked = 0;
+        data.trackingId = 0;
+
+        const ComPtr<IBody> body = bodies[index];
+        if( body == nullptr ){
+            continue;
+        }
+
+        // Check Body Tracked
+        BOOLEAN tracked = FALSE;
+        ERROR_CHECK( body->get_IsTracked( &tracked ) );
+        if( !tracked ){
+            continue;
+        }
+        data.tracked = 1;
+
+        // Retrieve Tracking ID
+        ERROR_CHECK( body->get_TrackingId( &data.trackingId ) );
+
+        // Retrieve Joints and Joint Orientations
+        std::array<Joint, JointType::JointType_Count> joints;
+        std::array<JointOrientation, JointType::JointType_Count> orientations;
+        ERROR_CHECK( body->GetJoints( static_cast<UINT>( joints.size() ), &joints[0] ) );
+        ERROR_CHECK( body->GetJointOrientations( static_cast<UINT>( orientations.size() ), &orientations[0] ) );
+        for( int type = 0; type < JointType::JointType_Count; type++ ){
+            const CameraSpacePoint& position = joints[type].Position;
+            const Vector4& orientation = orientations[type].Orientation;
+            data.positions[type][0] = position.X;
+            data.positions[type][1] = position.Y;
+            data.positions[type][2] = position.Z;
+            data.orientations[type][0] = orientation.x;
+            data.orientations[type][1] = orientation.y;
+            data.orientations[type][2] = orientation.z;
+            data.orientations[type][3] = orientation.w;
+            data.states[type] = static_cast<uint8_t>( joints[type].TrackingState );
+        }
+
+        // Retrieve Hand States
+        HandState handLeftState, handRightState;
+        TrackingConfidence handLeftConfidence, handRightConfidence;
+        ERROR_CHECK( body->get_HandLeftState( &handLeftState ) );
+        ERROR_CHECK( body->get_HandLeftConfidence( &handLeftConfidence ) );
+        ERROR_CHECK( body->get_HandRightState( &handRightState ) );
+        ERROR_CHECK( body->get_HandRightConfidence( &handRightConfidence ) );
+        data.handLeftState = static_cast<uint8_t>( handLeftState );
+        data.handLeftConfidence = static_cast<uint8_t>( handLeftConfidence );
+        data.handRightState = static_cast<uint8_t>( handRightState );
+        data.handRightConfidence = static_cast<uint8_t>( handRightConfidence );
+
+        // Retrieve Amount of Body Lean
+        PointF amount;
+        TrackingState leanState;
+        ERROR_CHECK( body->get_Lean( &amount ) );
+        ERROR_CHECK( body->get_LeanTrackingState( &leanState ) );
+        data.lean[0] = amount.X;
+        data.lean[1] = amount.Y;
+        data.leanState = static_cast<uint8_t>( leanState );
+    }
+}
+
+// Toggle Recording
+void Kinect::toggleRecording()
+{
+    // Stop Recording
+    if( recorder.isOpened() ){
+        std::cout << "Stop Recording Skeleton ( " << recorder.getFrames() << " frames, " << recorder.getBytes() << " bytes )" << std::endl;
+        recorder.close();
+        return;
+    }
+
+    // Start Recording
+    std::cout << "Start Recording Skeleton to File" << std::endl;
+    if( !recorder.open( "Skeleton.bin" ) ){
+        throw std::runtime_error( "failed SkeletonRecorder::open( Skeleton.bin )" );
+    }
+}
+
+// Update History
+inline void Kinect::updateHistory()
+{
+    // Convert Skeleton Frame to Body Samples
+    for( int index = 0; index < BODY_COUNT; index++ ){
+        const SkeletonFrame::Body& body = frame.bodies[index];
+        SkeletonHistory::BodySample& sample = samples[index];
+        sample.trackingId = body.tracked ? body.trackingId : 0;
+        if( !body.tracked ){
+            continue;
+        }
+
+        std::memcpy( sample.positions, body.positions, sizeof( sample.positions ) );
+        std::memcpy( sample.orientations, body.orientations, sizeof( sample.orientations ) );
+        std::memcpy( sample.states, body.states, sizeof( sample.states ) );
+        sample.handLeftState = body.handLeftState;
+        sample.handRightState = body.handRightState;
+    }
+
+    // Append to History
+    static_assert( SkeletonHistory::BODIES == BODY_COUNT, "number of bodies must be same as BODY_COUNT" );
+    static_assert( SkeletonHistory::JOINTS == JointType::JointType_Count, "number of joints must be same as JointType_Count" );
+    history.append( frame.timestamp, &samples[0] );
+}
+
+// Update Filter
+// Filters are updated once per body frame, and the state of each person is kept across frames by TrackingId.
+inline void Kinect::updateFilter()
+{
+#ifdef SMOOTH
+    // Update Filters of All Tracked Bodies at Once
+    filterManager.begin( frame.timestamp );
+    for( int index = 0; index < BODY_COUNT; index++ ){
+        const SkeletonFrame::Body& body = frame.bodies[index];
+        if( body.tracked ){
+            filterManager.setJoints( body.trackingId, body.positions, body.states );
+        }
+    }
+    filterManager.update();
+
+    // Update Orientation Filters of All Tracked Bodies at Once
+    orientationManager.begin( frame.timestamp );
+    for( int index = 0; index < BODY_COUNT; index++ ){
+        const SkeletonFrame::Body& body = frame.bodies[index];
+        if( body.tracked ){
+            orientationManager.setOrientations( body.trackingId, body.orientations );
+        }
+    }
+    orientationManager.update();
+
+#ifdef VERIFY_FILTER
+    // Verify Filter Bank
+    verifyFilter();
+#endif
+#endif
+}
+
+// Update Predictor
+inline void Kinect::updatePredictor()
+{
+#ifdef PREDICT
+    // Synchronize Clock by Arrival of Body Frame
+    predictor.synchronize( frame.timestamp, JointPredictor::getLocalTime() );
+
+    // Set Joints of All Tracked Bodies ( filtered joints if smoothing is enabled )
+    predictor.begin( frame.timestamp );
+    for( int index = 0; index < BODY_COUNT; index++ ){
+        const SkeletonFrame::Body& body = frame.bodies[index];
+        if( !body.tracked ){
+            continue;
+        }
+
+#ifdef SMOOTH
+        float positions[JointType::JointType_Count][3];
+        for( int type = 0; type < JointType::JointType_Count; type++ ){
+            filterManager.getFilteredJoint( body.trackingId, type, positions[type] );
+        }
+        predictor.setJoints( body.trackingId, positions );
+#else
+        predictor.setJoints( body.trackingId, body.positions );
+#endif
+    }
+#endif
 }
 
 // Draw Data
@@ -217,112 +508,249 @@ inline void Kinect::drawColor()
 // Draw Body
 inline void Kinect::drawBody()
 {
-    // Draw Body Data to Color Data
-    #pragma omp parallel for
+    // Gather Joints of Tracked Bodies
+    projection.clear();
+    axisProjection.clear();
     for( int index = 0; index < BODY_COUNT; index++ ){
-        const ComPtr<IBody> body = bodies[index];
-        if( body == nullptr ){
+        const SkeletonFrame::Body& body = frame.bodies[index];
+        if( !body.tracked ){
             continue;
         }
 
+        // Gather Joint Positions
+        std::array<SkeletonProjection::CameraPoint, JointType::JointType_Count> positions;
+        for( int type = 0; type < JointType::JointType_Count; type++ ){
 #ifdef SMOOTH
-        // Update Body
-        Sample::FilterDoubleExponential filter = filters[index];
-        filter.Update( body.Get() );
+            // Retrive Filtered Joint
+            float filtered[3];
+            filterManager.getFilteredJoint( body.trackingId, type, filtered );
+            positions[type] = { filtered[0], filtered[1], filtered[2] };
+#else
+            positions[type] = { body.positions[type][0], body.positions[type][1], body.positions[type][2] };
 #endif
-
-        // Check Body Tracked
-        BOOLEAN tracked = FALSE;
-        ERROR_CHECK( body->get_IsTracked( &tracked ) );
-        if( !tracked ){
-            continue;
         }
 
-        // Retrieve Joints
-        std::array<Joint, JointType::JointType_Count> joints;
-        ERROR_CHECK( body->GetJoints( JointType::JointType_Count, &joints[0] ) );
+#ifdef PREDICT
+        // Predict Joints at Presentation Time
+        float predicted[JointType::JointType_Count][3];
+        if( predictor.predict( body.trackingId, presentation, predicted ) ){
+            for( int type = 0; type < JointType::JointType_Count; type++ ){
+                positions[type] = { predicted[type][0], predicted[type][1], predicted[type][2] };
+            }
+        }
+#endif
+        projection.gather( index, &positions[0] );
 
+        // Gather End Points of Bone Axes ( Y axis of joint orientation is bone direction )
+        std::array<SkeletonProjection::CameraPoint, JointType::JointType_Count> axes;
+        for( int type = 0; type < JointType::JointType_Count; type++ ){
 #ifdef SMOOTH
-        // Retrive Filtered Joints
-        const DirectX::XMVECTOR* filteredJoints = filter.GetFilteredJoints();
+            float q[4];
+            orientationManager.getFilteredOrientation( body.trackingId, type, q );
+#else
+            const float* q = body.orientations[type];
 #endif
+            // Orientations of end joints are ( 0, 0, 0, 0 ), so their axes are degenerated to the joint
+            const float length = ( q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3] > 0.5f ) ? 0.1f : 0.0f; // [m]
+            axes[type] = { positions[type].X + length * 2.0f * ( q[0] * q[1] - q[3] * q[2] ),
+                           positions[type].Y + length * ( 1.0f - 2.0f * ( q[0] * q[0] + q[2] * q[2] ) ),
+                           positions[type].Z + length * 2.0f * ( q[1] * q[2] + q[3] * q[0] ) };
+        }
+        axisProjection.gather( index, &axes[0] );
+    }
+
+    // Project All Joints in One Batch
+    projectSkeleton( projection );
+    projectSkeleton( axisProjection );
+
+    // Draw Body Data to Color Data
+    for( int index = 0; index < BODY_COUNT; index++ ){
+        if( !projection.isGathered( index ) ){
+            continue;
+        }
 
-        #pragma omp parallel for
+        const SkeletonFrame::Body& body = frame.bodies[index];
         for( int type = 0; type < JointType::JointType_Count; type++ ){
             // Check Joint Tracked
-            const Joint joint = joints[type];
-            if( joint.TrackingState == TrackingState::TrackingState_NotTracked ){
+            if( body.states[type] == TrackingState::TrackingState_NotTracked ){
                 continue;
             }
 
-#ifdef SMOOTH
-            // Retrive Filtered Joint
-            Joint filteredJoint;
-            filteredJoint.JointType = joint.JointType;
-            filteredJoint.TrackingState = joint.TrackingState;
-            const DirectX::XMVECTOR vec = filteredJoints[type];
-            DirectX::XMVectorGetXPtr( &filteredJoint.Position.X, vec );
-            DirectX::XMVectorGetYPtr( &filteredJoint.Position.Y, vec );
-            DirectX::XMVectorGetZPtr( &filteredJoint.Position.Z, vec );
-#endif
-
             // Draw Joint Position
-            drawEllipse( colorMat, joint, 5, colors[index] );
+            const SkeletonProjection::ColorPoint& point = projection.getColorPoint( index, type );
+            drawEllipse( colorMat, point, 5, colors[index] );
 
-            // Draw Left Hand State
-            if( joint.JointType == JointType::JointType_HandLeft ){
-                HandState handState;
-                TrackingConfidence handConfidence;
-                ERROR_CHECK( body->get_HandLeftState( &handState ) );
-                ERROR_CHECK( body->get_HandLeftConfidence( &handConfidence ) );
+            // Draw Bone Axis
+            drawLine( colorMat, point, axisProjection.getColorPoint( index, type ), colors[index] );
 
-                drawHandState( colorMat, joint, handState, handConfidence );
+            // Draw Left Hand State
+            if( type == JointType::JointType_HandLeft ){
+                drawHandState( colorMat, point, static_cast<HandState>( body.handLeftState ), static_cast<TrackingConfidence>( body.handLeftConfidence ) );
             }
 
             // Draw Right Hand State
-            if( joint.JointType == JointType::JointType_HandRight ){
-                HandState handState;
-                TrackingConfidence handConfidence;
-                ERROR_CHECK( body->get_HandRightState( &handState ) );
-                ERROR_CHECK( body->get_HandRightConfidence( &handConfidence ) );
+            if( type == JointType::JointType_HandRight ){
+                drawHandState( colorMat, point, static_cast<HandState>( body.handRightState ), static_cast<TrackingConfidence>( body.handRightConfidence ) );
+            }
+        }
+
+        // Draw Velocity
+        drawVelocity( index );
+    }
+}
+
+// Verify Filter Bank
+// Original filter is updated with same joints, and max difference of filtered positions is printed every 100 frames.
+// Original filter is reset when body is lost, so difference is meaningful while bodies keep their index.
+inline void Kinect::verifyFilter()
+{
+    static float difference = 0.0f;
+    static int frames = 0;
+
+    for( int index = 0; index < BODY_COUNT; index++ ){
+        const SkeletonFrame::Body& body = frame.bodies[index];
+        if( !body.tracked ){
+            filters[index].Reset();
+            continue;
+        }
+
+        // Update Original Filter
+        std::array<Joint, JointType::JointType_Count> joints;
+        for( int type = 0; type < JointType::JointType_Count; type++ ){
+            joints[type].JointType = static_cast<JointType>( type );
+            joints[type].Position = { body.positions[type][0], body.positions[type][1], body.positions[type][2] };
+            joints[type].TrackingState = static_cast<TrackingState>( body.states[type] );
+        }
+        filters[index].Update( &joints[0] );
 
-                drawHandState( colorMat, joint, handState, handConfidence );
+        // Compare Filtered Joints
+        const DirectX::XMVECTOR* filteredJoints = filters[index].GetFilteredJoints();
+        for( int type = 0; type < JointType::JointType_Count; type++ ){
+            float filtered[3];
+            filterManager.getFilteredJoint( body.trackingId, type, filtered );
+            difference = std::max( difference, std::fabs( DirectX::XMVectorGetX( filteredJoints[type] ) - filtered[0] ) );
+            difference = std::max( difference, std::fabs( DirectX::XMVectorGetY( filteredJoints[type] ) - filtered[1] ) );
+            difference = std::max( difference, std::fabs( DirectX::XMVectorGetZ( filteredJoints[type] ) - filtered[2] ) );
+        }
+    }
+
+    if( ++frames == 100 ){
+        std::cout << "Filter Bank Max Difference : " << difference << " [m]" << std::endl;
+        difference = 0.0f;
+        frames = 0;
+    }
+}
+
+// Draw Velocity
+// Speed of right hand over last 0.5 [s] is computed from skeleton history.
+inline void Kinect::drawVelocity( const int index )
+{
+    if( colorMat.empty() ){
+        return;
+    }
+
+    // Retrieve Velocity of Right Hand
+    const TIMESPAN window = 5000000; // 0.5 [s] in 100 [ns] unit
+    float velocity[3];
+    if( !history.velocity( samples[index].trackingId, JointType::JointType_HandRight, window, velocity ) ){
+        return;
+    }
+
+    // Draw Speed at Right Hand Position
+    const SkeletonProjection::ColorPoint& point = projection.getColorPoint( index, JointType::JointType_HandRight );
+    if( !( 0.0f <= point.X ) || !( 0.0f <= point.Y ) ){
+        return;
+    }
+    const float speed = std::sqrt( velocity[0] * velocity[0] + velocity[1] * velocity[1] + velocity[2] * velocity[2] );
+    cv::putText( colorMat, cv::format( "%.2f m/s", speed ), cv::Point( static_cast<int>( point.X ), static_cast<int>( point.Y ) ), cv::FONT_HERSHEY_SIMPLEX, 1.0, static_cast<cv::Scalar>( colors[index] ), 2, cv::LINE_AA );
+}
+
+// Project Skeleton
+inline void Kinect::projectSkeleton( SkeletonProjection& points )
+{
+    if( points.getCount() == 0 ){
+        return;
+    }
+
+    // Project with Calibration of Color Camera ( replay without sensor )
+    if( replayer.isOpened() ){
+        points.project( calibration );
+        return;
+    }
+
+    // Convert Coordinate System of All Gathered Joints
+    static_assert( sizeof( SkeletonProjection::CameraPoint ) == sizeof( CameraSpacePoint ), "layout of CameraPoint must be same as CameraSpacePoint" );
+    static_assert( sizeof( SkeletonProjection::ColorPoint ) == sizeof( ColorSpacePoint ), "layout of ColorPoint must be same as ColorSpacePoint" );
+    const UINT count = static_cast<UINT>( points.getCount() );
+    ERROR_CHECK( coordinateMapper->MapCameraPointsToColorSpace( count, reinterpret_cast<const CameraSpacePoint*>( points.getCameraPoints() ), count, reinterpret_cast<ColorSpacePoint*>( points.getColorPoints() ) ) );
+}
+
+// Save Calibration of Color Camera
+// The calibration is fitted to coordinate mapper, and used to project joints without sensor ( e.g. replay on Linux ).
+void Kinect::saveCalibration()
+{
+    // Sample Points in Field of View
+    std::vector<CameraSpacePoint> cameraSpacePoints;
+    for( float z = 0.5f; z <= 4.5f; z += 0.25f ){
+        for( float y = -0.5f; y <= 0.5f; y += 0.1f ){
+            for( float x = -0.8f; x <= 0.8f; x += 0.1f ){
+                cameraSpacePoints.push_back( { x * z, y * z, z } );
             }
         }
+    }
 
-        /*
-        // Retrieve Joint Orientations
-        std::array<JointOrientation, JointType::JointType_Count> orientations;
-        ERROR_CHECK( body->GetJointOrientations( JointType::JointType_Count, &orientations[0] ) );
-        */
+    // Retrieve Mapped Coordinates
+    std::vector<ColorSpacePoint> colorSpacePoints( cameraSpacePoints.size() );
+    ERROR_CHECK( coordinateMapper->MapCameraPointsToColorSpace( static_cast<UINT>( cameraSpacePoints.size() ), &cameraSpacePoints[0], static_cast<UINT>( colorSpacePoints.size() ), &colorSpacePoints[0] ) );
 
-        /*
-        // Retrieve Amount of Body Lean
-        PointF amount;
-        ERROR_CHECK( body->get_Lean( &amount ) );
-        */
+    // Fit and Save Color Camera Model
+    SkeletonProjection::Calibration calibration;
+    if( !calibration.fit( reinterpret_cast<const SkeletonProjection::CameraPoint*>( &cameraSpacePoints[0] ), reinterpret_cast<const SkeletonProjection::ColorPoint*>( &colorSpacePoints[0] ), static_cast<int>( cameraSpacePoints.size() ) ) ){
+        throw std::runtime_error( "failed SkeletonProjection::Calibration::fit()" );
+    }
+    if( !calibration.save( "ColorCalibration.txt" ) ){
+        throw std::runtime_error( "failed SkeletonProjection::Calibration::save()" );
     }
 }
 
 // Draw Ellipse
-inline void Kinect::drawEllipse( cv::Mat& image, const Joint& joint, const int radius, const cv::Vec3b& color, const int thickness )
+inline void Kinect::drawEllipse( cv::Mat& image, const SkeletonProjection::ColorPoint& point, const int radius, const cv::Vec3b& color, const int thickness )
 {
     if( image.empty() ){
         return;
     }
 
-    // Convert Coordinate System and Draw Joint
-    ColorSpacePoint colorSpacePoint;
-    ERROR_CHECK( coordinateMapper->MapCameraPointToColorSpace( joint.Position, &colorSpacePoint ) );
-    const int x = static_cast<int>( colorSpacePoint.X + 0.5f );
-    const int y = static_cast<int>( colorSpacePoint.Y + 0.5f );
-    if( ( 0 <= x ) && ( x < image.cols ) && ( 0 <= y ) && ( y < image.rows ) ){
+    // Draw Joint at Projected Position ( invalid points are mapped to -Infinity )
+    if( !( 0.0f <= point.X ) || !( 0.0f <= point.Y ) ){
+        return;
+    }
+    const int x = static_cast<int>( point.X + 0.5f );
+    const int y = static_cast<int>( point.Y + 0.5f );
+    if( ( x < image.cols ) && ( y < image.rows ) ){
         cv::circle( image, cv::Point( x, y ), radius, static_cast<cv::Scalar>( color ), thickness, cv::LINE_AA );
     }
 }
 
+// Draw Line
+inline void Kinect::drawLine( cv::Mat& image, const SkeletonProjection::ColorPoint& start, const SkeletonProjection::ColorPoint& end, const cv::Vec3b& color, const int thickness )
+{
+    if( image.empty() ){
+        return;
+    }
+
+    // Draw Line between Projected Positions ( invalid points are mapped to -Infinity, line is clipped by image )
+    if( !( 0.0f <= start.X ) || !( 0.0f <= start.Y ) || !( 0.0f <= end.X ) || !( 0.0f <= end.Y ) ){
+        return;
+    }
+    const cv::Point from( static_cast<int>( start.X + 0.5f ), static_cast<int>( start.Y + 0.5f ) );
+    const cv::Point to( static_cast<int>( end.X + 0.5f ), static_cast<int>( end.Y + 0.5f ) );
+    if( from != to ){
+        cv::line( image, from, to, static_cast<cv::Scalar>( color ), thickness, cv::LINE_AA );
+    }
+}
+
 // Draw Hand State
-inline void Kinect::drawHandState( cv::Mat& image, const Joint& joint, HandState handState, TrackingConfidence handConfidence )
+inline void Kinect::drawHandState( cv::Mat& image, const SkeletonProjection::ColorPoint& point, HandState handState, TrackingConfidence handConfidence )
 {
     if( image.empty() ){
         return;
@@ -339,15 +767,15 @@ inline void Kinect::drawHandState( cv::Mat& image, const Joint& joint, HandState
     switch( handState ){
         // Open
         case HandState::HandState_Open:
-            drawEllipse( image, joint, radius, green, 5 );
+            drawEllipse( image, point, radius, green, 5 );
             break;
         // Close
         case HandState::HandState_Closed:
-            drawEllipse( image, joint, radius, red, 5 );
+            drawEllipse( image, point, radius, red, 5 );
             break;
         // Lasso
         case HandState::HandState_Lasso:
-            drawEllipse( image, joint, radius, blue, 5 );
+            drawEllipse( image, point, radius, blue, 5 );
             break;
         default:
             break;
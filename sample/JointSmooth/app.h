@@ -8,9 +8,16 @@
 // https://social.msdn.microsoft.com/Forums/en-US/045b058a-ae3a-4d01-beb6-b756631b4b42
 #include "KinectJointFilter.h"
 #include <opencv2/opencv.hpp>
+#include "SkeletonProjection.h"
+#include "SkeletonHistory.h"
+#include "SkeletonStream.h"
+#include "JointFilterManager.h"
+#include "OrientationFilterManager.h"
+#include "JointPredictor.h"
 
 #include <vector>
 #include <array>
+#include <string>
 
 #include <wrl/client.h>
 using namespace Microsoft::WRL;
@@ -39,12 +46,32 @@ private:
     std::array<IBody*, BODY_COUNT> bodies;
     std::array<cv::Vec3b, BODY_COUNT> colors;
 
-    // Smoothing Filter
+    // Skeleton Buffer ( retrieved once per frame from sensor or replay, shared by every drawing )
+    SkeletonFrame frame;
+    SkeletonProjection projection;
+    SkeletonProjection axisProjection;
+
+    // Skeleton Stream ( record live frames, or replay recorded frames without sensor )
+    SkeletonRecorder recorder;
+    SkeletonReplayer replayer;
+    SkeletonProjection::Calibration calibration;
+
+    // Skeleton History ( 10 [s] of all bodies, keyed by TrackingId and RelativeTime )
+    SkeletonHistory history;
+    std::array<SkeletonHistory::BodySample, BODY_COUNT> samples;
+
+    // Smoothing Filter ( keyed by TrackingId, original filters are used only to verify filter bank )
+    JointFilterManager<HoltFilter> filterManager;
+    OrientationFilterManager orientationManager;
     std::array<Sample::FilterDoubleExponential, BODY_COUNT> filters;
 
+    // Joint Predictor ( predict joints at presentation time of drawn image by RelativeTime and display latency )
+    JointPredictor predictor;
+    int64_t presentation;
+
 public:
-    // Constructor
-    Kinect();
+    // Constructor ( replay recorded skeleton file instead of sensor if specified )
+    Kinect( const std::string& replay = "", const bool realtime = true );
 
     // Destructor
     ~Kinect();
@@ -65,6 +92,9 @@ private:
     // Initialize Body
     inline void initializeBody();
 
+    // Initialize Replay
+    inline void initializeReplay();
+
     // Finalize
     void finalize();
 
@@ -77,6 +107,24 @@ private:
     // Update Body
     inline void updateBody();
 
+    // Update Replay
+    inline void updateReplay();
+
+    // Retrieve Skeleton Frame
+    inline void retrieveFrame( const ComPtr<IBodyFrame>& bodyFrame );
+
+    // Toggle Recording
+    void toggleRecording();
+
+    // Update History
+    inline void updateHistory();
+
+    // Update Filter
+    inline void updateFilter();
+
+    // Update Predictor
+    inline void updatePredictor();
+
     // Draw Data
     void draw();
 
@@ -89,11 +137,26 @@ private:
     // Draw Smooth
     inline void drawSmooth();
 
+    // Verify Filter Bank
+    inline void verifyFilter();
+
+    // Draw Velocity
+    inline void drawVelocity( const int index );
+
+    // Project Skeleton
+    inline void projectSkeleton( SkeletonProjection& points );
+
+    // Save Calibration of Color Camera
+    void saveCalibration();
+
     // Draw Circle
-    inline void drawEllipse( cv::Mat& image, const Joint& joint, const int radius, const cv::Vec3b& color, const int thickness = -1 );
+    inline void drawEllipse( cv::Mat& image, const SkeletonProjection::ColorPoint& point, const int radius, const cv::Vec3b& color, const int thickness = -1 );
+
+    // Draw Line
+    inline void drawLine( cv::Mat& image, const SkeletonProjection::ColorPoint& start, const SkeletonProjection::ColorPoint& end, const cv::Vec3b& color, const int thickness = 2 );
 
     // Draw Hand State
-    inline void drawHandState( cv::Mat& image, const Joint& joint, HandState handState, TrackingConfidence handConfidence );
+    inline void drawHandState( cv::Mat& image, const SkeletonProjection::ColorPoint& point, HandState handState, TrackingConfidence handConfidence );
 
     // Show Data
     void show();